@@ -245,6 +245,26 @@ namespace SPH {
 		multi_ploygen_.findBounds(lower_bound, upper_bound);
 	}
 	//=================================================================================================//
+	uint64_t ComplexShape::computeShapeHash()
+	{
+		uint64_t hash = hashShapeData(NULL, 0);
+		auto hashRing = [&](const boost_poly::ring_type& ring) {
+			size_t number_of_points = ring.size();
+			hash = hashShapeData(&number_of_points, sizeof(size_t), hash);
+			for (const model::d2::point_xy<Real>& point : ring)
+			{
+				Real coordinates[2] = { point.x(), point.y() };
+				hash = hashShapeData(coordinates, sizeof(coordinates), hash);
+			}
+		};
+		for (const boost_poly& poly : multi_ploygen_.getBoostMultiPoly())
+		{
+			hashRing(poly.outer());
+			for (const boost_poly::ring_type& inner_ring : poly.inners()) hashRing(inner_ring);
+		}
+		return hash;
+	}
+	//=================================================================================================//
 	void ComplexShape::addAMultiPolygon(MultiPolygon& multi_polygon, ShapeBooleanOps op)
 	{
 		multi_ploygen_.addAMultiPolygon(multi_polygon, op);
@@ -92,6 +92,8 @@ namespace SPH {
 		virtual Real findSignedDistance(Vec2d input_pnt);
 		virtual Vec2d findNormalDirection(Vec2d input_pnt);
 		virtual Vecd computeKernelIntegral(Vecd input_pnt, Kernel* kernel);
+		/** hash of the polygons, to identify the shape of particle reload files */
+		virtual uint64_t computeShapeHash();
 	protected:
 		MultiPolygon multi_ploygen_;
 	};
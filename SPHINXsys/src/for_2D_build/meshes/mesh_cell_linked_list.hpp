@@ -0,0 +1,30 @@
+/**
+ * @file 	mesh_cell_linked_list.hpp
+ * @brief 	Here gives the implementation of the template functions for cell linked lists.
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "mesh_cell_linked_list.h"
+
+namespace SPH {
+	//=================================================================================================//
+	template<typename ListDataFunction>
+	void BaseMeshCellLinkedList::searchCellListDataAround(const Vecu& cell_index,
+		int search_range, const ListDataFunction& list_data_function)
+	{
+		int i = (int)cell_index[0];
+		int j = (int)cell_index[1];
+		for (int l = SMAX(i - search_range, 0); l <= SMIN(i + search_range, int(number_of_cells_[0]) - 1); ++l)
+			for (int m = SMAX(j - search_range, 0); m <= SMIN(j + search_range, int(number_of_cells_[1]) - 1); ++m)
+			{
+				CellList* cell_list = findCellList(Vecu(l, m));
+				if (cell_list == NULL) continue;
+				CellListDataVector& target_particles = cell_list->cell_list_data_;
+				for (size_t n = 0; n != target_particles.size(); ++n)
+					list_data_function(target_particles[n]);
+			}
+	}
+	//=================================================================================================//
+}
@@ -5,6 +5,7 @@
  */
 
 #include "mesh_cell_linked_list.h"
+#include "memory_footprint.h"
 #include "base_kernel.h"
 #include "base_body.h"
 #include "base_particles.h"
@@ -30,6 +31,18 @@ namespace SPH {
 			}, ap);
 	}
 	//=================================================================================================//
+	void BaseMeshCellLinkedList::accountCellListsMemory(MemoryFootprint& footprint, const std::string& name,
+		Vecu& number_of_cells, matrix_cell cell_linked_lists)
+	{
+		size_t used_bytes = 0, allocated_bytes = 0;
+		for (size_t i = 0; i != number_of_cells[0]; ++i)
+			for (size_t j = 0; j != number_of_cells[1]; ++j) {
+				used_bytes += cell_linked_lists[i][j].UsedBytes();
+				allocated_bytes += cell_linked_lists[i][j].AllocatedBytes();
+			}
+		footprint.addRecord("cell linked list", name, used_bytes, allocated_bytes);
+	}
+	//=================================================================================================//
 	void BaseMeshCellLinkedList::UpdateSplitCellLists(SplitCellLists& split_cell_lists,
 		Vecu& number_of_cells, matrix_cell cell_linked_lists)
 	{
@@ -45,6 +58,7 @@ namespace SPH {
 						if (real_particles_in_cell != 0) {
 							for (size_t s = 0; s != real_particles_in_cell; ++s)
 								cell_list.real_particle_indexes_.push_back(cell_list.concurrent_particle_indexes_[s]);
+							cell_list.cell_index_ = Vecu(i, j);
 							split_cell_lists[transferMeshIndexTo1D(Vecu(3), Vecu(i % 3, j % 3))].push_back(&cell_linked_lists[i][j]);
 						}
 					}
@@ -83,6 +97,33 @@ namespace SPH {
 		Delete2dArray(cell_linked_lists_, number_of_cells_);
 	}
 	//=================================================================================================//
+	void FlatMeshCellLinkedList::UpdateCellListsFromFlatData(SplitCellLists& split_cell_lists)
+	{
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		ClearSplitCellLists(split_cell_lists);
+
+		parallel_for(blocked_range2d<size_t>(0, number_of_cells_[0], 0, number_of_cells_[1]),
+			[&](const blocked_range2d<size_t>& r) {
+				for (size_t i = r.rows().begin(); i != r.rows().end(); ++i)
+					for (size_t j = r.cols().begin(); j != r.cols().end(); ++j) {
+						CellList& cell_list = cell_linked_lists_[i][j];
+						cell_list.real_particle_indexes_.clear();
+						cell_list.cell_list_data_.clear();
+						size_t linear_cell_index = transferMeshIndexTo1D(number_of_cells_, Vecu(i, j));
+						size_t* begin = flat_particle_indexes_.data() + cell_offsets_[linear_cell_index];
+						size_t* end = flat_particle_indexes_.data() + cell_offsets_[linear_cell_index + 1];
+						if (begin != end) {
+							cell_list.real_particle_indexes_.assign(begin, end);
+							cell_list.cell_list_data_.reserve(end - begin);
+							for (size_t* s = begin; s != end; ++s)
+								cell_list.cell_list_data_.emplace_back(*s, pos_n[*s]);
+							cell_list.cell_index_ = Vecu(i, j);
+							split_cell_lists[transferMeshIndexTo1D(Vecu(3), Vecu(i % 3, j % 3))].push_back(&cell_list);
+						}
+					}
+			}, ap);
+	}
+	//=================================================================================================//
 	void MultilevelMeshCellLinkedList
 		::InsertACellLinkedListEntryAtALevel(size_t particle_index, Vecd& position, Vecu& cell_index, size_t level)
 	{
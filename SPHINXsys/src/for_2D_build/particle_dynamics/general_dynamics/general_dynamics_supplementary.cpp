@@ -51,7 +51,7 @@ namespace SPH
 		CellVector& lower_bound_cells = bound_cells_[0];
 		for (size_t i = 0; i != lower_bound_cells.size(); ++i) {
 			IndexVector& particle_indexes
-				= cell_linked_lists_[lower_bound_cells[i][0]][lower_bound_cells[i][1]].real_particle_indexes_;
+				= mesh_cell_linked_list_->CellListFromIndex(lower_bound_cells[i])->real_particle_indexes_;
 			for (size_t num = 0; num < particle_indexes.size(); ++num)
 				checkLowerBound(particle_indexes[num], dt);
 		}
@@ -60,7 +60,7 @@ namespace SPH
 		CellVector& upper_bound_cells = bound_cells_[1];
 		for (size_t i = 0; i != upper_bound_cells.size(); ++i) {
 			IndexVector& particle_indexes
-				= cell_linked_lists_[upper_bound_cells[i][0]][upper_bound_cells[i][1]].real_particle_indexes_;
+				= mesh_cell_linked_list_->CellListFromIndex(upper_bound_cells[i])->real_particle_indexes_;
 			for (size_t num = 0; num < particle_indexes.size(); ++num)
 				checkUpperBound(particle_indexes[num], dt);
 		}
@@ -76,7 +76,7 @@ namespace SPH
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
 					IndexVector& particle_indexes
-						= cell_linked_lists_[lower_bound_cells[i][0]][lower_bound_cells[i][1]].real_particle_indexes_;
+						= mesh_cell_linked_list_->CellListFromIndex(lower_bound_cells[i])->real_particle_indexes_;
 					for (size_t num = 0; num < particle_indexes.size(); ++num)
 						checkLowerBound(particle_indexes[num], dt);
 				}
@@ -88,7 +88,7 @@ namespace SPH
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
 					IndexVector& particle_indexes
-						= cell_linked_lists_[upper_bound_cells[i][0]][upper_bound_cells[i][1]].real_particle_indexes_;
+						= mesh_cell_linked_list_->CellListFromIndex(upper_bound_cells[i])->real_particle_indexes_;
 					for (size_t num = 0; num < particle_indexes.size(); ++num)
 						checkUpperBound(particle_indexes[num], dt);
 				}
@@ -103,7 +103,7 @@ namespace SPH
 		CellVector& lower_bound_cells = bound_cells_[0];
 		for (size_t i = 0; i != lower_bound_cells.size(); ++i) {
 			CellListDataVector& cell_list_data
-				= cell_linked_lists_[lower_bound_cells[i][0]][lower_bound_cells[i][1]].cell_list_data_;
+				= mesh_cell_linked_list_->CellListFromIndex(lower_bound_cells[i])->cell_list_data_;
 			for (size_t num = 0; num < cell_list_data.size(); ++num)
 				checkLowerBound(cell_list_data[num], dt);
 		}
@@ -112,7 +112,7 @@ namespace SPH
 		CellVector& upper_bound_cells = bound_cells_[1];
 		for (size_t i = 0; i != upper_bound_cells.size(); ++i) {
 			CellListDataVector& cell_list_data
-				= cell_linked_lists_[upper_bound_cells[i][0]][upper_bound_cells[i][1]].cell_list_data_;
+				= mesh_cell_linked_list_->CellListFromIndex(upper_bound_cells[i])->cell_list_data_;
 			for (size_t num = 0; num < cell_list_data.size(); ++num)
 				checkUpperBound(cell_list_data[num], dt);
 		}
@@ -157,7 +157,7 @@ namespace SPH
 		setupDynamics(dt);
 		for (size_t i = 0; i != bound_cells_.size(); ++i) {
 			CellListDataVector& list_data
-				= cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]].cell_list_data_;
+				= mesh_cell_linked_list_->CellListFromIndex(bound_cells_[i])->cell_list_data_;
 			for (size_t num = 0; num < list_data.size(); ++num)
 				checking_bound_(list_data[num].first, dt);
 		}
@@ -171,7 +171,7 @@ namespace SPH
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
 					CellListDataVector& list_data
-						= cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]].cell_list_data_;
+						= mesh_cell_linked_list_->CellListFromIndex(bound_cells_[i])->cell_list_data_;
 					for (size_t num = 0; num < list_data.size(); ++num)
 						checking_bound_(list_data[num].first, dt);
 				}
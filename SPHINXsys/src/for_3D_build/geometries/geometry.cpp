@@ -300,6 +300,35 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	uint64_t ComplexShape::computeShapeHash()
+	{
+		uint64_t hash = hashShapeData(NULL, 0);
+		for (auto& triangle_mesh_shape : triangle_mesh_shapes_)
+		{
+			int boolean_op = int(triangle_mesh_shape.second);
+			hash = hashShapeData(&boolean_op, sizeof(int), hash);
+
+			SimTK::ContactGeometry::TriangleMesh* triangle_mesh = triangle_mesh_shape.first->getTriangleMesh();
+			int number_of_vertices = triangle_mesh->getNumVertices();
+			hash = hashShapeData(&number_of_vertices, sizeof(int), hash);
+			for (int i = 0; i != number_of_vertices; ++i)
+			{
+				Vec3d vertex_position = triangle_mesh->getVertexPosition(i);
+				Real coordinates[3] = { vertex_position[0], vertex_position[1], vertex_position[2] };
+				hash = hashShapeData(coordinates, sizeof(coordinates), hash);
+			}
+			int number_of_faces = triangle_mesh->getNumFaces();
+			hash = hashShapeData(&number_of_faces, sizeof(int), hash);
+			for (int i = 0; i != number_of_faces; ++i)
+			{
+				int face_vertices[3] = { triangle_mesh->getFaceVertex(i, 0),
+					triangle_mesh->getFaceVertex(i, 1), triangle_mesh->getFaceVertex(i, 2) };
+				hash = hashShapeData(face_vertices, sizeof(face_vertices), hash);
+			}
+		}
+		return hash;
+	}
+	//=================================================================================================//
 	Vecd ComplexShape::computeKernelIntegral(Vecd input_pnt, Kernel* kernel)
 	{
 		std::cout << "\n ComplexShape::computeKernelIntegral is not implemented!" << std::endl;
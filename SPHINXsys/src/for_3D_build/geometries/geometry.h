@@ -104,6 +104,8 @@ namespace SPH {
 		virtual Vec3d findNormalDirection(Vec3d input_pnt);
 		virtual Vecd weightedIntegral(Vecd input_pnt, Kernel * kernel, Real smoothing_length) { return Vecd(1.0); };
 		virtual Vecd computeKernelIntegral(Vecd input_pnt, Kernel* kernel);
+		/** hash of the triangle meshes and operations, to identify the shape of particle reload files */
+		virtual uint64_t computeShapeHash();
 	protected:
 		/** shape container<pointer to geomtry, operation> */
 		std::vector<std::pair<TriangleMeshShape*, ShapeBooleanOps>> triangle_mesh_shapes_;
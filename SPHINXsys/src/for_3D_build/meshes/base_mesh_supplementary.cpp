@@ -54,4 +54,34 @@ namespace SPH {
         return MortonCode(grid_index[0]) | (MortonCode(grid_index[1]) << 1)
                 | (MortonCode(grid_index[2]) << 2);
     }
+    //=================================================================================================//
+    size_t BaseMesh::transferMeshIndexToHilbertOrder(Vecu grid_index, size_t number_of_bits)
+    {
+        size_t x[3] = { grid_index[0], grid_index[1], grid_index[2] };
+        size_t most_significant = size_t(1) << (number_of_bits - 1);
+        /** inverse undo of the excess work */
+        for (size_t q = most_significant; q > 1; q >>= 1) {
+            size_t p = q - 1;
+            for (size_t i = 0; i != 3; ++i) {
+                if (x[i] & q) x[0] ^= p;
+                else {
+                    size_t t = (x[0] ^ x[i]) & p;
+                    x[0] ^= t;
+                    x[i] ^= t;
+                }
+            }
+        }
+        /** Gray encode */
+        for (size_t i = 1; i != 3; ++i) x[i] ^= x[i - 1];
+        size_t t = 0;
+        for (size_t q = most_significant; q > 1; q >>= 1)
+            if (x[2] & q) t ^= q - 1;
+        for (size_t i = 0; i != 3; ++i) x[i] ^= t;
+        /** interleave the transpose into the Hilbert index */
+        size_t hilbert_index = 0;
+        for (size_t b = number_of_bits; b != 0; --b)
+            for (size_t i = 0; i != 3; ++i)
+                hilbert_index = (hilbert_index << 1) | ((x[i] >> (b - 1)) & 1);
+        return hilbert_index;
+    }
 }
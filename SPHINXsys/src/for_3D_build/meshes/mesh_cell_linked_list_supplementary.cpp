@@ -1,4 +1,5 @@
 #include "mesh_cell_linked_list.h"
+#include "memory_footprint.h"
 #include "base_kernel.h"
 #include "base_body.h"
 #include "base_particles.h"
@@ -27,6 +28,19 @@ namespace SPH {
 			}, ap);
 	}
 	//=================================================================================================//
+	void BaseMeshCellLinkedList::accountCellListsMemory(MemoryFootprint& footprint, const std::string& name,
+		Vecu& number_of_cells, matrix_cell cell_linked_lists)
+	{
+		size_t used_bytes = 0, allocated_bytes = 0;
+		for (size_t i = 0; i != number_of_cells[0]; ++i)
+			for (size_t j = 0; j != number_of_cells[1]; ++j)
+				for (size_t k = 0; k != number_of_cells[2]; ++k) {
+					used_bytes += cell_linked_lists[i][j][k].UsedBytes();
+					allocated_bytes += cell_linked_lists[i][j][k].AllocatedBytes();
+				}
+		footprint.addRecord("cell linked list", name, used_bytes, allocated_bytes);
+	}
+	//=================================================================================================//
 	void BaseMeshCellLinkedList::UpdateSplitCellLists(SplitCellLists& split_cell_lists,
 		Vecu& number_of_cells, matrix_cell cell_linked_lists)
 	{
@@ -44,6 +58,7 @@ namespace SPH {
 							if (real_particles_in_cell != 0) {
 								for (size_t s = 0; s != real_particles_in_cell; ++s)
 									cell_list.real_particle_indexes_.push_back(cell_list.concurrent_particle_indexes_[s]);
+								cell_list.cell_index_ = Vecu(i, j, k);
 								split_cell_lists[transferMeshIndexTo1D(Vecu(3), Vecu(i % 3, j % 3, k % 3))]
 									.push_back(&cell_linked_lists[i][j][k]);
 							}
@@ -87,6 +102,35 @@ namespace SPH {
 		Delete3dArray(cell_linked_lists_, number_of_cells_);
 	}
 	//=================================================================================================//
+	void FlatMeshCellLinkedList::UpdateCellListsFromFlatData(SplitCellLists& split_cell_lists)
+	{
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		ClearSplitCellLists(split_cell_lists);
+
+		parallel_for(blocked_range3d<size_t>(0, number_of_cells_[0], 0, number_of_cells_[1], 0, number_of_cells_[2]),
+			[&](const blocked_range3d<size_t>& r) {
+				for (size_t i = r.pages().begin(); i != r.pages().end(); ++i)
+					for (size_t j = r.rows().begin(); j != r.rows().end(); ++j)
+						for (size_t k = r.cols().begin(); k != r.cols().end(); ++k)
+						{
+							CellList& cell_list = cell_linked_lists_[i][j][k];
+							cell_list.real_particle_indexes_.clear();
+							cell_list.cell_list_data_.clear();
+							size_t linear_cell_index = transferMeshIndexTo1D(number_of_cells_, Vecu(i, j, k));
+							size_t* begin = flat_particle_indexes_.data() + cell_offsets_[linear_cell_index];
+							size_t* end = flat_particle_indexes_.data() + cell_offsets_[linear_cell_index + 1];
+							if (begin != end) {
+								cell_list.real_particle_indexes_.assign(begin, end);
+								cell_list.cell_list_data_.reserve(end - begin);
+								for (size_t* s = begin; s != end; ++s)
+									cell_list.cell_list_data_.emplace_back(*s, pos_n[*s]);
+								cell_list.cell_index_ = Vecu(i, j, k);
+								split_cell_lists[transferMeshIndexTo1D(Vecu(3), Vecu(i % 3, j % 3, k % 3))].push_back(&cell_list);
+							}
+						}
+			}, ap);
+	}
+	//=================================================================================================//
 	void MultilevelMeshCellLinkedList
 		::InsertACellLinkedListEntryAtALevel(size_t particle_index, 
 			Vecd& position, Vecu& cell_index, size_t level)
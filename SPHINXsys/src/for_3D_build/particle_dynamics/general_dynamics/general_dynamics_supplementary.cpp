@@ -68,8 +68,7 @@ namespace SPH
 		CellVector& lower_bound_cells = bound_cells_[0];
 		for (size_t i = 0; i != lower_bound_cells.size(); ++i) {
 			IndexVector& particle_indexes
-				= cell_linked_lists_[lower_bound_cells[i][0]][lower_bound_cells[i][1]][lower_bound_cells[i][2]]
-				.real_particle_indexes_;
+				= mesh_cell_linked_list_->CellListFromIndex(lower_bound_cells[i])->real_particle_indexes_;
 			for (size_t num = 0; num < particle_indexes.size(); ++num)
 				checkLowerBound(particle_indexes[num], dt);
 		}
@@ -78,8 +77,7 @@ namespace SPH
 		CellVector& upper_bound_cells = bound_cells_[1];
 		for (size_t i = 0; i != upper_bound_cells.size(); ++i) {
 			IndexVector& particle_indexes
-				= cell_linked_lists_[upper_bound_cells[i][0]][upper_bound_cells[i][1]][upper_bound_cells[i][2]]
-				.real_particle_indexes_;
+				= mesh_cell_linked_list_->CellListFromIndex(upper_bound_cells[i])->real_particle_indexes_;
 			for (size_t num = 0; num < particle_indexes.size(); ++num)
 				checkUpperBound(particle_indexes[num], dt);
 		}
@@ -93,8 +91,7 @@ namespace SPH
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
 					IndexVector& particle_indexes
-						= cell_linked_lists_[lower_bound_cells[i][0]][lower_bound_cells[i][1]][lower_bound_cells[i][2]]
-						.real_particle_indexes_;
+						= mesh_cell_linked_list_->CellListFromIndex(lower_bound_cells[i])->real_particle_indexes_;
 					for (size_t num = 0; num < particle_indexes.size(); ++num)
 						checkLowerBound(particle_indexes[num], dt);
 				}
@@ -106,8 +103,7 @@ namespace SPH
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
 					IndexVector& particle_indexes
-						= cell_linked_lists_[upper_bound_cells[i][0]][upper_bound_cells[i][1]][upper_bound_cells[i][2]]
-						.real_particle_indexes_;
+						= mesh_cell_linked_list_->CellListFromIndex(upper_bound_cells[i])->real_particle_indexes_;
 					for (size_t num = 0; num < particle_indexes.size(); ++num)
 						checkUpperBound(particle_indexes[num], dt);
 				}
@@ -120,8 +116,7 @@ namespace SPH
 		CellVector& lower_bound_cells = bound_cells_[0];
 		for (size_t i = 0; i != lower_bound_cells.size(); ++i) {
 			CellListDataVector& cell_list_data
-				= cell_linked_lists_[lower_bound_cells[i][0]][lower_bound_cells[i][1]][lower_bound_cells[i][2]]
-				.cell_list_data_;
+				= mesh_cell_linked_list_->CellListFromIndex(lower_bound_cells[i])->cell_list_data_;
 			for (size_t num = 0; num < cell_list_data.size(); ++num)
 				checkLowerBound(cell_list_data[num], dt);
 		}
@@ -130,8 +125,7 @@ namespace SPH
 		CellVector& upper_bound_cells = bound_cells_[1];
 		for (size_t i = 0; i != upper_bound_cells.size(); ++i) {
 			CellListDataVector& cell_list_data
-				= cell_linked_lists_[upper_bound_cells[i][0]][upper_bound_cells[i][1]][upper_bound_cells[i][2]]
-				.cell_list_data_;
+				= mesh_cell_linked_list_->CellListFromIndex(upper_bound_cells[i])->cell_list_data_;
 			for (size_t num = 0; num < cell_list_data.size(); ++num)
 				checkUpperBound(cell_list_data[num], dt);
 		}
@@ -195,8 +189,7 @@ namespace SPH
 	{
 		for (size_t i = 0; i != bound_cells_.size(); ++i) {
 			CellListDataVector& list_data
-				= cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]][bound_cells_[i][2]]
-				.cell_list_data_;
+				= mesh_cell_linked_list_->CellListFromIndex(bound_cells_[i])->cell_list_data_;
 			for (size_t num = 0; num < list_data.size(); ++num)
 				checking_bound_(list_data[num].first, dt);
 		}
@@ -209,8 +202,7 @@ namespace SPH
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i < r.end(); ++i) {
 					CellListDataVector& list_data
-						= cell_linked_lists_[bound_cells_[i][0]][bound_cells_[i][1]][bound_cells_[i][2]]
-						.cell_list_data_;
+						= mesh_cell_linked_list_->CellListFromIndex(bound_cells_[i])->cell_list_data_;
 					for (size_t num = 0; num < list_data.size(); ++num)
 						checking_bound_(list_data[num].first, dt);
 				}
@@ -39,7 +39,8 @@
 #include <array>
 
 using namespace tbb;
-static tbb::affinity_partitioner ap;
+/** thread local so that parallel loops can be started concurrently, e.g. by the tasks of a flow graph */
+static thread_local tbb::affinity_partitioner ap;
 
 namespace SPH {
 
@@ -51,6 +52,97 @@ namespace SPH {
 
 	template <typename T>
 	using StdVec = std::vector<T>;
+
+	/**
+	 * @class LoopPartitioner
+	 * @brief The partitioner and the grain size for the parallel loops of an object, 
+	 * such as a particle dynamics or the data packages of a mesh.
+	 * As the affinity partitioner is owned by the object, the mapping of iterations to threads 
+	 * is replayed for the loops of the object only, which have the same or similar iteration space.
+	 * Optionally, the grain size is tuned by sampling the candidate grain sizes in turn 
+	 * during the first executions and the fastest one is kept afterwards.
+	 */
+	class LoopPartitioner
+	{
+	public:
+		explicit LoopPartitioner(size_t grain_size = 1) 
+			: grain_size_(grain_size), samples_per_candidate_(0), number_of_samples_(0) {};
+		virtual ~LoopPartitioner() {};
+
+		/** set a fixed grain size, any ongoing tuning is stopped */
+		void setGrainSize(size_t grain_size)
+		{
+			grain_size_ = grain_size == 0 ? 1 : grain_size;
+			candidate_grain_sizes_.clear();
+			candidate_times_.clear();
+		};
+		/** Start tuning the grain size. Each candidate is sampled by the given number of loops.
+		  * For an object with several loops in one execution, e.g. a particle dynamics 
+		  * with initialization, interaction and update steps, the number of samples 
+		  * should be a multiple of the number of loops so that all candidates are sampled alike. */
+		void setGrainSizeTuning(StdVec<size_t> candidate_grain_sizes = { 1, 64, 256, 1024, 4096 },
+			size_t samples_per_candidate = 6)
+		{
+			candidate_grain_sizes_ = candidate_grain_sizes;
+			candidate_times_.assign(candidate_grain_sizes.size(), 0.0);
+			samples_per_candidate_ = samples_per_candidate == 0 ? 1 : samples_per_candidate;
+			number_of_samples_ = 0;
+		};
+		bool isTuning() { return number_of_samples_ < candidate_grain_sizes_.size() * samples_per_candidate_; };
+		/** the grain size for the next loop */
+		size_t GrainSize() 
+		{
+			return isTuning() ? candidate_grain_sizes_[number_of_samples_ / samples_per_candidate_] : grain_size_;
+		};
+
+		template <class LoopBody>
+		void parallel_for(size_t number_of_iterations, const LoopBody& loop_body)
+		{
+			if (!isTuning())
+			{
+				tbb::parallel_for(blocked_range<size_t>(0, number_of_iterations, grain_size_), loop_body, partitioner_);
+				return;
+			}
+			tick_count time_instance = tick_count::now();
+			tbb::parallel_for(blocked_range<size_t>(0, number_of_iterations, GrainSize()), loop_body, partitioner_);
+			recordSample((tick_count::now() - time_instance).seconds());
+		};
+
+		template <class ReturnType, class LoopBody, class JoinBody>
+		ReturnType parallel_reduce(size_t number_of_iterations, ReturnType temp,
+			const LoopBody& loop_body, const JoinBody& join_body)
+		{
+			if (!isTuning())
+				return tbb::parallel_reduce(blocked_range<size_t>(0, number_of_iterations, grain_size_),
+					temp, loop_body, join_body, partitioner_);
+			tick_count time_instance = tick_count::now();
+			ReturnType result = tbb::parallel_reduce(blocked_range<size_t>(0, number_of_iterations, GrainSize()),
+				temp, loop_body, join_body, partitioner_);
+			recordSample((tick_count::now() - time_instance).seconds());
+			return result;
+		};
+	protected:
+		tbb::affinity_partitioner partitioner_;
+		size_t grain_size_;
+		StdVec<size_t> candidate_grain_sizes_;
+		StdVec<double> candidate_times_;
+		size_t samples_per_candidate_;
+		size_t number_of_samples_;
+
+		/** accumulate the time of a sampled loop, and keep the fastest candidate after the last sample */
+		void recordSample(double seconds)
+		{
+			candidate_times_[number_of_samples_ / samples_per_candidate_] += seconds;
+			++number_of_samples_;
+			if (!isTuning())
+			{
+				size_t fastest = 0;
+				for (size_t i = 1; i != candidate_times_.size(); ++i)
+					if (candidate_times_[i] < candidate_times_[fastest]) fastest = i;
+				grain_size_ = candidate_grain_sizes_[fastest];
+			}
+		};
+	};
 }
 
 #endif // SPHINXSYS_BASE_CONTAINER_H
\ No newline at end of file
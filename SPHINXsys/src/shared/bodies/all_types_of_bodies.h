@@ -4,4 +4,5 @@ This is the header file that user code should include to pick up all
 bodies used in SPHinXsys. **/
 
 #include "fluid_body.h"
-#include "solid_body.h"
\ No newline at end of file
+#include "solid_body.h"
+#include "particle_sorting_policy.h"
\ No newline at end of file
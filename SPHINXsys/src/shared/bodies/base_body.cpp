@@ -10,19 +10,22 @@
 #include "base_body.h"
 #include "sph_system.h"
 #include "in_output.h"
+#include "particle_sorting_policy.h"
+#include "sph_profiler.h"
 #include "base_particles.h"
 #include "all_kernels.h"
 #include "mesh_cell_linked_list.h"
+#include "memory_footprint.h"
 //=================================================================================================//
 namespace SPH
 {
 	//=================================================================================================//
 	SPHBody::SPHBody(SPHSystem &sph_system, string body_name,
 		int refinement_level, Real smoothing_length_ratio, ParticleGenerator* particle_generator) : 
-		sph_system_(sph_system), body_name_(body_name), newly_updated_(true),
+		sph_system_(sph_system), body_name_(body_name), newly_updated_(true), periodic_images_in_cell_linked_list_(false),
 		body_lower_bound_(0), body_upper_bound_(0), prescribed_body_bounds_(false),
-		refinement_level_(refinement_level), particle_generator_(particle_generator),
-		body_shape_(NULL)
+		refinement_level_(refinement_level), base_particles_(NULL), particle_generator_(particle_generator),
+		body_shape_(NULL), particle_sorting_policy_(NULL)
 	{	
 		sph_system_.addABody(this);
 		particle_spacing_ 	= RefinementLevelToParticleSpacing();
@@ -76,6 +79,19 @@ namespace SPH
 		mesh_cell_linked_list_->assignBaseParticles(base_particles);
 	}
 	//=================================================================================================//
+	void SPHBody::replaceMeshCellLinkedList(BaseMeshCellLinkedList* mesh_cell_linked_list)
+	{
+		delete mesh_cell_linked_list_;
+		mesh_cell_linked_list_ = mesh_cell_linked_list;
+		if (base_particles_ != NULL) mesh_cell_linked_list_->assignBaseParticles(base_particles_);
+	}
+	//=================================================================================================//
+	void SPHBody::setParticleSortingPolicy(ParticleSortingPolicy* particle_sorting_policy)
+	{
+		delete particle_sorting_policy_;
+		particle_sorting_policy_ = particle_sorting_policy;
+	}
+	//=================================================================================================//
 	void SPHBody::allocateConfigurationMemoriesForBodyBuffer()
 	{
 		for (size_t i = 0; i < body_relations_.size(); i++)
@@ -84,6 +100,18 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void SPHBody::accountMemory(MemoryFootprint& footprint)
+	{
+		footprint.setBodyName(body_name_);
+		if (base_particles_ != NULL) base_particles_->accountMemory(footprint);
+		mesh_cell_linked_list_->accountMemory(footprint);
+		if (body_shape_ != NULL) body_shape_->accountMemory(footprint);
+		for (size_t i = 0; i < body_relations_.size(); i++)
+		{
+			body_relations_[i]->accountMemory(footprint);
+		}
+	}
+	//=================================================================================================//
 	void SPHBody::findBodyDomainBounds(Vecd& lower_bound, Vecd& upper_bound)
 	{
 		if(!prescribed_body_bounds_) 
@@ -97,9 +125,9 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
-	void SPHBody::writeParticlesToVtuFile(ofstream &output_file)
+	void SPHBody::writeParticlesToVtuFile(VtuFileWriter& vtu_file)
 	{
-		base_particles_->writeParticlesToVtuFile(output_file);
+		base_particles_->writeParticlesToVtuFile(vtu_file);
 		newly_updated_ = false;
 	}
 	//=================================================================================================//
@@ -119,6 +147,16 @@ namespace SPH
 		base_particles_->readParticleFromXmlForRestart(filefullpath);
 	}
 	//=================================================================================================//
+	void SPHBody::writeParticlesToBinaryForRestart(std::string& filefullpath, Real physical_time)
+	{
+		base_particles_->writeParticlesToBinaryForRestart(filefullpath, physical_time);
+	}
+	//=================================================================================================//
+	void SPHBody::readParticlesFromBinaryForRestart(std::string& filefullpath)
+	{
+		base_particles_->readParticlesFromBinaryForRestart(filefullpath);
+	}
+	//=================================================================================================//
 	void SPHBody::writeToXmlForReloadParticle(std::string &filefullpath)
 	{
 		base_particles_->writeToXmlForReloadParticle(filefullpath);
@@ -129,6 +167,16 @@ namespace SPH
 		base_particles_->readFromXmlForReloadParticle(filefullpath);
 	}
 	//=================================================================================================//
+	void SPHBody::writeToBinaryForReloadParticle(std::string& filefullpath, const std::string& key)
+	{
+		base_particles_->writeToBinaryForReloadParticle(filefullpath, key);
+	}
+	//=================================================================================================//
+	void SPHBody::readFromBinaryForReloadParticle(std::string& filefullpath, const std::string& key)
+	{
+		base_particles_->readFromBinaryForReloadParticle(filefullpath, key);
+	}
+	//=================================================================================================//
 	SPHBody* SPHBody::pointToThisObject()
 	{
 		return this;
@@ -142,9 +190,17 @@ namespace SPH
 		mesh_cell_linked_list_->allocateMeshDataMatrix();
 	}
 	//=================================================================================================//
+	void RealBody::replaceMeshCellLinkedList(BaseMeshCellLinkedList* mesh_cell_linked_list)
+	{
+		SPHBody::replaceMeshCellLinkedList(mesh_cell_linked_list);
+		mesh_cell_linked_list_->allocateMeshDataMatrix();
+	}
+	//=================================================================================================//
 	void RealBody::updateCellLinkedList()
 	{
-		mesh_cell_linked_list_->UpdateCellLists();
+		ProfilerSpan profiler_span("updateCellLinkedList", this);
+		particle_sorting_policy_ == NULL ? mesh_cell_linked_list_->UpdateCellLists()
+			: particle_sorting_policy_->updateCellLinkedList();
 	}
 	//=================================================================================================//
 	RealBody* RealBody::pointToThisObject()
@@ -55,6 +55,7 @@ namespace SPH
 	class Kernel;
 	class BaseMeshCellLinkedList;
 	class SPHBodyBaseRelation;
+	class ParticleSortingPolicy;
 
 	/**
 	 * @class SPHBody
@@ -69,6 +70,8 @@ namespace SPH
 		SPHSystem &sph_system_; 	/**< SPHSystem. */
 		string body_name_; 		/**< name of this body */
 		bool newly_updated_;		/**< whether this body is in a newly updated state */
+		/** whether translated periodic images of the particles are inserted into the cell linked list */
+		bool periodic_images_in_cell_linked_list_;
 		/** Computational domain bounds of the body for boundary conditions. */
 		Vecd body_lower_bound_, body_upper_bound_;
 		/** Whether the computational domain bound for this body is prescribed. */
@@ -92,6 +95,7 @@ namespace SPH
 		ParticleGenerator* particle_generator_;	/**< Particle generator manner */
 		PositionsAndVolumes body_input_points_volumes_; /**< For direct generate particles. */
 		ComplexShape*  body_shape_;		/** describe the geometry of the body*/
+		ParticleSortingPolicy* particle_sorting_policy_; /**< Sorting policy, no sorting if NULL. */
 		/**
 		 * @brief particle by cells lists is for parallel splitting algorithm.
 		 * All particles in each cell are collected together.
@@ -120,6 +124,8 @@ namespace SPH
 		void setNewlyUpdated() { newly_updated_ = true; };
 		bool checkNewlyUpdated() { return newly_updated_; };
 		void setNotNewlyUpdated() { newly_updated_ = false; };
+		void setPeriodicImagesInCellLinkedList() { periodic_images_in_cell_linked_list_ = true; };
+		bool checkPeriodicImagesInCellLinkedList() { return periodic_images_in_cell_linked_list_; };
 		SPHSystem& getSPHSystem();
 
 		/** Get the name of this body for out file name. */
@@ -131,12 +137,19 @@ namespace SPH
 
 		/** assign base particle to the body and cell linked list. */
 		void assignBaseParticle(BaseParticles* base_particles);
+		/** Replace the cell linked list, e.g. by a FlatMeshCellLinkedList.
+		 *  It should be called before the body relations are built. */
+		virtual void replaceMeshCellLinkedList(BaseMeshCellLinkedList* mesh_cell_linked_list);
+		/** Set the policy for sorting particle data with cell linked list updates. */
+		void setParticleSortingPolicy(ParticleSortingPolicy* particle_sorting_policy);
 		/** Compute reference number density*/
 		virtual Real computeReferenceNumberDensity();
 		/** Update cell linked list. */
 		virtual void updateCellLinkedList() = 0;
 		/** Allocate extra configuration memories for body buffer particles. */
 		void allocateConfigurationMemoriesForBodyBuffer();
+		/** Add the memory records of the particles, cell linked list, shape and relations of this body. */
+		virtual void accountMemory(MemoryFootprint& footprint);
 
 		/**
 		 * @brief Find the lower and upper bounds of the body.
@@ -146,7 +159,7 @@ namespace SPH
 		void findBodyDomainBounds(Vecd &lower_bound, Vecd &upper_bound);
 
 		/** Output particle data in VTU file for visualization in Paraview. */
-		virtual void writeParticlesToVtuFile(ofstream &output_file);
+		virtual void writeParticlesToVtuFile(VtuFileWriter& vtu_file);
 		/** Output particle data in PLT file for visualization in Tecplot. */
 		virtual void writeParticlesToPltFile(ofstream &output_file);
 
@@ -154,11 +167,19 @@ namespace SPH
 		virtual void writeParticlesToXmlForRestart(std::string &filefullpath);
 		/** Read particle data in XML file for restart simulation. */
 		virtual void readParticlesFromXmlForRestart(std::string &filefullpath);
+		/** Output particle data in binary file for restart simulation. */
+		virtual void writeParticlesToBinaryForRestart(std::string& filefullpath, Real physical_time);
+		/** Read particle data in binary file for restart simulation. */
+		virtual void readParticlesFromBinaryForRestart(std::string& filefullpath);
 
 		/** Output particle position and volume in XML file for reloading particles. */
 		virtual void writeToXmlForReloadParticle(std::string &filefullpath);
 		/** Reload particle position and volume from XML files. */
 		virtual void readFromXmlForReloadParticle(std::string &filefullpath);
+		/** Output particle position and volume in binary file for reloading particles. */
+		virtual void writeToBinaryForReloadParticle(std::string& filefullpath, const std::string& key);
+		/** Reload particle position and volume from binary files. */
+		virtual void readFromBinaryForReloadParticle(std::string& filefullpath, const std::string& key);
 		
 		/** The pointer to derived class object. */
 		virtual SPHBody* pointToThisObject();
@@ -178,6 +199,8 @@ namespace SPH
 			ParticleGenerator* particle_generator = new ParticleGeneratorLattice());
 		virtual ~RealBody() {};
 
+		/** Replace the cell linked list and allocate its mesh data. */
+		virtual void replaceMeshCellLinkedList(BaseMeshCellLinkedList* mesh_cell_linked_list) override;
 		/** Update cell linked list. */
 		virtual void updateCellLinkedList() override;
 		/** The pointer to derived class object. */
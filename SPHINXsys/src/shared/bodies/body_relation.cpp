@@ -10,17 +10,121 @@
 #include "base_kernel.h"
 #include "body_relation.h"
 #include "body_relation.hpp"
+#include "sph_profiler.h"
 #include "base_particles.h"
+#include "memory_footprint.h"
 
 namespace SPH
 {
 	//=================================================================================================//
-	SPHBodyBaseRelation::SPHBodyBaseRelation(SPHBody* sph_body)
+	ConfigurationBuildRecord::ConfigurationBuildRecord(SPHBody* sph_body)
+		: sph_body_(sph_body), base_particles_(sph_body->base_particles_),
+		number_of_particles_(0), sorting_count_(0) {}
+	//=================================================================================================//
+	void ConfigurationBuildRecord::recordParticles()
+	{
+		number_of_particles_ = sph_body_->number_of_particles_;
+		sorting_count_ = base_particles_->sorting_count_;
+		pos_.resize(number_of_particles_);
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		parallel_for(blocked_range<size_t>(0, number_of_particles_),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) pos_[i] = pos_n[i];
+			}, ap);
+	}
+	//=================================================================================================//
+	Real ConfigurationBuildRecord::MaximumDisplacement()
+	{
+		if (pos_.empty() || number_of_particles_ != sph_body_->number_of_particles_ ||
+			sorting_count_ != base_particles_->sorting_count_ ||
+			base_particles_->number_of_ghost_particles_ != 0) return Infinity;
+
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		Real maximum_displacement_sqr = parallel_reduce(blocked_range<size_t>(0, number_of_particles_),
+			Real(0), [&](const blocked_range<size_t>& r, Real temp)->Real {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					temp = SMAX(temp, (pos_n[i] - pos_[i]).normSqr());
+				}
+				return temp;
+			},
+			[](Real x, Real y)->Real { return SMAX(x, y); });
+		return sqrt(maximum_displacement_sqr);
+	}
+	//=================================================================================================//
+	void ConfigurationBuildRecord::accountMemory(MemoryFootprint& footprint, const std::string& name)
+	{
+		footprint.addVector("configuration", name + " build record", pos_);
+	}
+	//=================================================================================================//
+	SPHBodyBaseRelation::SPHBodyBaseRelation(SPHBody* sph_body, bool use_compressed_configuration)
 		: sph_body_(sph_body), split_cell_lists_(sph_body->split_cell_lists_), base_particles_(sph_body->base_particles_),
-		mesh_cell_linked_list_(sph_body->mesh_cell_linked_list_)
+		mesh_cell_linked_list_(sph_body->mesh_cell_linked_list_), 
+		use_compressed_configuration_(use_compressed_configuration), skin_distance_(0.0),
+		is_used_by_split_cell_dynamics_(false)
 	{
 	}
 	//=================================================================================================//
+	void SPHBodyBaseRelation::setSkinDistance(Real skin_distance)
+	{
+		skin_distance_ = skin_distance;
+		checkSkinWithSplitCellDynamics();
+	}
+	//=================================================================================================//
+	void SPHBodyBaseRelation::setUsedBySplitCellDynamics()
+	{
+		is_used_by_split_cell_dynamics_ = true;
+		checkSkinWithSplitCellDynamics();
+	}
+	//=================================================================================================//
+	void SPHBodyBaseRelation::checkSkinWithSplitCellDynamics()
+	{
+		if (is_used_by_split_cell_dynamics_ && skin_distance_ > 0.0)
+		{
+			std::cout << "\n Error: the Verlet skin distance of the relation of " << sph_body_->GetBodyName()
+				<< " is not supported with the split cell dynamics, i.e. splitting or pairwise dynamics." << std::endl;
+			std::cout << " Use zero skin distance or another relation for the split cell dynamics." << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+	}
+	//=================================================================================================//
+	int SPHBodyBaseRelation::SkinSearchRange(BaseMeshCellLinkedList& target_mesh_cell_linked_list)
+	{
+		return int(ceil(skin_distance_ / target_mesh_cell_linked_list.CellSpacing()));
+	}
+	//=================================================================================================//
+	void SPHBodyBaseRelation::checkPeriodicImagesWithSkin(SPHBodyVector sph_bodies)
+	{
+		for (size_t k = 0; k != sph_bodies.size(); ++k)
+		{
+			if (sph_bodies[k]->checkPeriodicImagesInCellLinkedList())
+			{
+				std::cout << "\n Error: the Verlet skin distance of the relation of " << sph_body_->GetBodyName()
+					<< " is not supported with the periodic images in the cell linked list of "
+					<< sph_bodies[k]->GetBodyName() << "." << std::endl;
+				std::cout << " Use zero skin distance or the periodic condition using ghost particles." << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+		}
+	}
+	//=================================================================================================//
+	void SPHBodyBaseRelation::refreshNeighborhood(NeighborhoodView neighborhood, Kernel& kernel,
+		Vecd& pos_i, StdLargeVec<Vecd>& target_pos)
+	{
+		Real cutoff_radius_sqr = powern(kernel.GetCutOffRadius(), 2);
+		for (size_t n = 0; n != neighborhood.current_size_; ++n)
+		{
+			Vecd vec_r_ij = pos_i - target_pos[neighborhood.j_[n]];
+			bool is_within_cutoff = vec_r_ij.normSqr() <= cutoff_radius_sqr;
+			neighborhood.W_ij_[n] = is_within_cutoff ? kernel.W(vec_r_ij) : 0.0;
+			neighborhood.dW_ij_[n] = is_within_cutoff ? kernel.dW(vec_r_ij) : 0.0;
+			Real r_ij = vec_r_ij.norm();
+			neighborhood.r_ij_[n] = r_ij;
+			neighborhood.e_ij_[n] = vec_r_ij / (r_ij + TinyReal);
+		}
+	}
+	//=================================================================================================//
 	void SPHBodyBaseRelation::createNeighborRelation(Neighborhood& neighborhood,
 		Kernel& kernel, Vecd& vec_r_ij, size_t i_index, size_t j_index)
 	{
@@ -39,8 +143,9 @@ namespace SPH
 		neighborhood.e_ij_[current_count_of_neighbors] = vec_r_ij / (r_ij + TinyReal);
 	}
 	//=================================================================================================//
-	SPHBodyInnerRelation::SPHBodyInnerRelation(SPHBody* sph_body)
-		: SPHBodyBaseRelation(sph_body)
+	SPHBodyInnerRelation::SPHBodyInnerRelation(SPHBody* sph_body, bool use_compressed_configuration)
+		: SPHBodyBaseRelation(sph_body, use_compressed_configuration), 
+		is_half_configuration_(false), build_record_(sph_body)
 	{
 		subscribe_to_body();
 		updateConfigurationMemories();
@@ -52,10 +157,134 @@ namespace SPH
 		inner_configuration_.resize(updated_size, Neighborhood());
 	}
 	//=================================================================================================//
-	SPHBodyContactRelation::SPHBodyContactRelation(SPHBody* sph_body, SPHBodyVector contact_sph_bodies)
-		: SPHBodyBaseRelation(sph_body), contact_sph_bodies_(contact_sph_bodies) {
+	void SPHBodyInnerRelation::accountMemory(MemoryFootprint& footprint)
+	{
+		std::string name = is_half_configuration_ ? "half inner" : "inner";
+		accountConfigurationMemory(footprint, name, inner_configuration_);
+		accountConfigurationMemory(footprint, name, compressed_inner_configuration_);
+		build_record_.accountMemory(footprint, name);
+	}
+	//=================================================================================================//
+	void SPHBodyInnerRelation::updateConfiguration()
+	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
+		if (skin_distance_ > 0.0) checkPeriodicImagesWithSkin({ sph_body_ });
+		if (skin_distance_ > 0.0 && 2.0 * build_record_.MaximumDisplacement() < skin_distance_)
+		{
+			refreshConfiguration();
+			return;
+		}
+
+		use_compressed_configuration_ ? buildCompressedConfiguration() : buildConfiguration();
+		if (skin_distance_ > 0.0)
+		{
+			build_record_.recordParticles();
+			refreshConfiguration();
+		}
+	}
+	//=================================================================================================//
+	void SPHBodyInnerRelation::refreshConfiguration()
+	{
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		Kernel* current_kernel = sph_body_->kernel_;
+		parallel_for(blocked_range<size_t>(0, sph_body_->number_of_particles_),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t num = r.begin(); num != r.end(); ++num) {
+					NeighborhoodView neighborhood = use_compressed_configuration_ ?
+						compressed_inner_configuration_[num] : NeighborhoodView(inner_configuration_[num]);
+					refreshNeighborhood(neighborhood, *current_kernel, pos_n[num], pos_n);
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	void SPHBodyInnerRelation::buildConfiguration()
+	{
+		BaseParticles* base_particles = sph_body_->base_particles_;
+		Kernel* current_kernel = sph_body_->kernel_;
+		Real cutoff_radius_sqr = powern(current_kernel->GetCutOffRadius() + skin_distance_, 2);
+		int search_range = 1 + SkinSearchRange(*mesh_cell_linked_list_);
+
+		parallel_for(blocked_range<size_t>(0, sph_body_->number_of_particles_),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t num = r.begin(); num != r.end(); ++num) {
+					Vecd particle_position = base_particles->pos_n_[num];
+					Vecu cell_location
+						= mesh_cell_linked_list_->GridIndexFromPosition(particle_position);
+
+					Neighborhood& neighborhood = inner_configuration_[num];
+					size_t current_count_of_neighbors = 0;
+					mesh_cell_linked_list_->searchCellListDataAround(cell_location, search_range,
+						[&](ListData& list_data) {
+							//displacement pointing from neighboring particle to origin particle
+							Vecd displacement = particle_position - list_data.second;
+							if (displacement.normSqr() <= cutoff_radius_sqr && isNeighborToBeListed(num, list_data.first))
+							{
+								current_count_of_neighbors >= neighborhood.memory_size_ ?
+									createNeighborRelation(neighborhood, 
+										*current_kernel, displacement, num, list_data.first)
+									: initializeNeighborRelation(neighborhood, current_count_of_neighbors,
+										*current_kernel, displacement, num, list_data.first);
+								current_count_of_neighbors++;
+							}
+						});
+					neighborhood.current_size_ = current_count_of_neighbors;
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	void SPHBodyInnerRelation::buildCompressedConfiguration()
+	{
+		BaseParticles* base_particles = sph_body_->base_particles_;
+		Kernel* current_kernel = sph_body_->kernel_;
+		Real cutoff_radius_sqr = powern(current_kernel->GetCutOffRadius() + skin_distance_, 2);
+		int search_range = 1 + SkinSearchRange(*mesh_cell_linked_list_);
+		size_t number_of_particles = sph_body_->number_of_particles_;
+		CompressedParticleConfiguration& configuration = compressed_inner_configuration_;
+		StdLargeVec<size_t>& offset = configuration.offset_;
+
+		configuration.resetNeighborCounts(number_of_particles);
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t num = r.begin(); num != r.end(); ++num) {
+					Vecd particle_position = base_particles->pos_n_[num];
+					Vecu cell_location = mesh_cell_linked_list_->GridIndexFromPosition(particle_position);
+					size_t count_of_neighbors = 0;
+					mesh_cell_linked_list_->searchCellListDataAround(cell_location, search_range,
+						[&](ListData& list_data) {
+							Vecd displacement = particle_position - list_data.second;
+							if (displacement.normSqr() <= cutoff_radius_sqr && isNeighborToBeListed(num, list_data.first))
+								count_of_neighbors++;
+						});
+					offset[num + 1] = count_of_neighbors;
+				}
+			}, ap);
+
+		configuration.accumulateNeighborCounts();
+
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t num = r.begin(); num != r.end(); ++num) {
+					Vecd particle_position = base_particles->pos_n_[num];
+					Vecu cell_location = mesh_cell_linked_list_->GridIndexFromPosition(particle_position);
+					size_t entry = offset[num];
+					mesh_cell_linked_list_->searchCellListDataAround(cell_location, search_range,
+						[&](ListData& list_data) {
+							//displacement pointing from neighboring particle to origin particle
+							Vecd displacement = particle_position - list_data.second;
+							if (displacement.normSqr() <= cutoff_radius_sqr && isNeighborToBeListed(num, list_data.first))
+								configuration.setANeighbor(*current_kernel, displacement, entry++, list_data.first);
+						});
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	SPHBodyContactRelation::SPHBodyContactRelation(SPHBody* sph_body, 
+		SPHBodyVector contact_sph_bodies, bool use_compressed_configuration)
+		: SPHBodyBaseRelation(sph_body, use_compressed_configuration), build_record_(sph_body),
+		contact_sph_bodies_(contact_sph_bodies) {
 		for (size_t k = 0; k != contact_sph_bodies_.size(); ++k) {
 			target_mesh_cell_linked_lists_.push_back(contact_sph_bodies_[k]->mesh_cell_linked_list_);
+			contact_build_records_.push_back(ConfigurationBuildRecord(contact_sph_bodies_[k]));
 		}
 		subscribe_to_body();
 		updateConfigurationMemories();
@@ -68,11 +297,137 @@ namespace SPH
 		for (size_t k = 0; k != contact_sph_bodies_.size(); ++k) {
 			contact_configuration_[k].resize(updated_size, Neighborhood());
 		}
+		compressed_contact_configuration_.resize(contact_sph_bodies_.size());
+	}
+	//=================================================================================================//
+	void SPHBodyContactRelation::accountMemory(MemoryFootprint& footprint)
+	{
+		for (size_t k = 0; k != contact_sph_bodies_.size(); ++k) {
+			std::string name = "contact with " + contact_sph_bodies_[k]->GetBodyName();
+			accountConfigurationMemory(footprint, name, contact_configuration_[k]);
+			accountConfigurationMemory(footprint, name, compressed_contact_configuration_[k]);
+			contact_build_records_[k].accountMemory(footprint, name);
+		}
+		build_record_.accountMemory(footprint, "contact");
+	}
+	//=================================================================================================//
+	template<typename GetParticleIndex>
+	void SPHBodyContactRelation::
+		updateCompressedConfigurationForParticles(size_t number_of_particles, GetParticleIndex& get_particle_index)
+	{
+		BaseParticles* base_particles = sph_body_->base_particles_;
+		for (size_t relation_body_num = 0; relation_body_num < contact_sph_bodies_.size(); ++relation_body_num)
+		{
+			BaseMeshCellLinkedList& target_mesh_cell_linked_list
+				= *(target_mesh_cell_linked_lists_[relation_body_num]);
+			int search_range =
+				mesh_cell_linked_list_->computeSearchRange(sph_body_->refinement_level_,
+					contact_sph_bodies_[relation_body_num]->refinement_level_)
+				+ SkinSearchRange(target_mesh_cell_linked_list);
+			Kernel& current_kernel = mesh_cell_linked_list_->ChoosingKernel(sph_body_->kernel_,
+				contact_sph_bodies_[relation_body_num]->kernel_);
+			Real cutoff_radius_sqr = powern(current_kernel.GetCutOffRadius() + skin_distance_, 2);
+			CompressedParticleConfiguration& configuration = compressed_contact_configuration_[relation_body_num];
+			StdLargeVec<size_t>& offset = configuration.offset_;
+
+			/** Particles not given by get_particle_index keep zero neighbors. */
+			configuration.resetNeighborCounts(sph_body_->number_of_particles_);
+			parallel_for(blocked_range<size_t>(0, number_of_particles),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t num = r.begin(); num != r.end(); ++num) {
+						size_t index_i = get_particle_index(num);
+						Vecd particle_position = base_particles->pos_n_[index_i];
+						Vecu target_cell_index = target_mesh_cell_linked_list.GridIndexFromPosition(particle_position);
+						size_t count_of_neighbors = 0;
+						target_mesh_cell_linked_list.searchCellListDataAround(target_cell_index,
+							search_range, [&](ListData& list_data) {
+								Vecd displacement = particle_position - list_data.second;
+								if (displacement.normSqr() <= cutoff_radius_sqr) count_of_neighbors++;
+							});
+						offset[index_i + 1] = count_of_neighbors;
+					}
+				}, ap);
+
+			configuration.accumulateNeighborCounts();
+
+			parallel_for(blocked_range<size_t>(0, number_of_particles),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t num = r.begin(); num != r.end(); ++num) {
+						size_t index_i = get_particle_index(num);
+						Vecd particle_position = base_particles->pos_n_[index_i];
+						Vecu target_cell_index = target_mesh_cell_linked_list.GridIndexFromPosition(particle_position);
+						size_t entry = offset[index_i];
+						target_mesh_cell_linked_list.searchCellListDataAround(target_cell_index,
+							search_range, [&](ListData& list_data) {
+								//displacement pointing from neighboring particle to origin particle
+								Vecd displacement = particle_position - list_data.second;
+								if (displacement.normSqr() <= cutoff_radius_sqr)
+									configuration.setANeighbor(current_kernel, displacement, entry++, list_data.first);
+							});
+					}
+				}, ap);
+		}
+	}
+	//=================================================================================================//
+	template<typename GetParticleIndex>
+	void SPHBodyContactRelation::
+		refreshConfigurationForParticles(size_t number_of_particles, GetParticleIndex& get_particle_index)
+	{
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		for (size_t relation_body_num = 0; relation_body_num < contact_sph_bodies_.size(); ++relation_body_num)
+		{
+			StdLargeVec<Vecd>& target_pos_n = contact_sph_bodies_[relation_body_num]->base_particles_->pos_n_;
+			Kernel& current_kernel = mesh_cell_linked_list_->ChoosingKernel(sph_body_->kernel_,
+				contact_sph_bodies_[relation_body_num]->kernel_);
+			parallel_for(blocked_range<size_t>(0, number_of_particles),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t num = r.begin(); num != r.end(); ++num) {
+						size_t index_i = get_particle_index(num);
+						NeighborhoodView neighborhood = use_compressed_configuration_ ?
+							compressed_contact_configuration_[relation_body_num][index_i]
+							: NeighborhoodView(contact_configuration_[relation_body_num][index_i]);
+						refreshNeighborhood(neighborhood, current_kernel, pos_n[index_i], target_pos_n);
+					}
+				}, ap);
+		}
+	}
+	//=================================================================================================//
+	template<typename GetParticleIndex>
+	void SPHBodyContactRelation::
+		updateContactConfiguration(size_t number_of_particles, GetParticleIndex& get_particle_index)
+	{
+		if (skin_distance_ > 0.0)
+		{
+			checkPeriodicImagesWithSkin({ sph_body_ });
+			checkPeriodicImagesWithSkin(contact_sph_bodies_);
+			Real maximum_contact_displacement = 0.0;
+			for (size_t k = 0; k != contact_build_records_.size(); ++k)
+				maximum_contact_displacement = 
+					SMAX(maximum_contact_displacement, contact_build_records_[k].MaximumDisplacement());
+			/** Neighbor pairs may approach each other by the sum of their displacements. */
+			if (build_record_.MaximumDisplacement() + maximum_contact_displacement < skin_distance_)
+			{
+				refreshConfigurationForParticles(number_of_particles, get_particle_index);
+				return;
+			}
+		}
+
+		use_compressed_configuration_ ?
+			updateCompressedConfigurationForParticles(number_of_particles, get_particle_index)
+			: updateConfigurationForParticles(number_of_particles, get_particle_index);
+		if (skin_distance_ > 0.0)
+		{
+			build_record_.recordParticles();
+			for (size_t k = 0; k != contact_build_records_.size(); ++k)
+				contact_build_records_[k].recordParticles();
+			refreshConfigurationForParticles(number_of_particles, get_particle_index);
+		}
 	}
 	//=================================================================================================//
 	void SPHBodyContactRelation::updateConfiguration()
 	{
-		updateConfigurationForParticles(sph_body_->number_of_particles_, get_particle_index_);
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
+		updateContactConfiguration(sph_body_->number_of_particles_, get_particle_index_);
 	}
 	//=================================================================================================//
 	SolidBodyContactRelation::SolidBodyContactRelation(SPHBody* sph_body, SPHBodyVector contact_sph_bodies)
@@ -83,27 +438,34 @@ namespace SPH
 	//=================================================================================================//
 	void SolidBodyContactRelation::updateConfiguration()
 	{
-		updateConfigurationForParticles(body_part_particles_.size(), get_body_part_particle_index_);
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
+		updateContactConfiguration(body_part_particles_.size(), get_body_part_particle_index_);
 	}
 	//=================================================================================================//
-	SPHBodyComplexRelation::SPHBodyComplexRelation(SPHBody* body, SPHBodyVector contact_sph_bodies)
-		: SPHBodyBaseRelation(body),
-		inner_relation_(new SPHBodyInnerRelation(body)),
-		contact_relation_(new SPHBodyContactRelation(body, contact_sph_bodies)),
+	SPHBodyComplexRelation::SPHBodyComplexRelation(SPHBody* body, 
+		SPHBodyVector contact_sph_bodies, bool use_compressed_configuration)
+		: SPHBodyBaseRelation(body, use_compressed_configuration),
+		inner_relation_(new SPHBodyInnerRelation(body, use_compressed_configuration)),
+		contact_relation_(new SPHBodyContactRelation(body, contact_sph_bodies, use_compressed_configuration)),
 		contact_sph_bodies_(contact_sph_bodies),
 		inner_configuration_(inner_relation_->inner_configuration_),
-		contact_configuration_(contact_relation_->contact_configuration_) 
+		contact_configuration_(contact_relation_->contact_configuration_),
+		compressed_inner_configuration_(inner_relation_->compressed_inner_configuration_),
+		compressed_contact_configuration_(contact_relation_->compressed_contact_configuration_)
 	{
 		updateConfigurationMemories();
 	};
 	//=================================================================================================//
 	SPHBodyComplexRelation::SPHBodyComplexRelation(SPHBodyInnerRelation* body_inner_relation, 
-		SPHBodyVector contact_sph_bodies) : SPHBodyBaseRelation(body_inner_relation->sph_body_),
+		SPHBodyVector contact_sph_bodies) : SPHBodyBaseRelation(body_inner_relation->sph_body_,
+			body_inner_relation->use_compressed_configuration_),
 		inner_relation_(body_inner_relation),
-		contact_relation_(new SPHBodyContactRelation(sph_body_, contact_sph_bodies)),
+		contact_relation_(new SPHBodyContactRelation(sph_body_, contact_sph_bodies, use_compressed_configuration_)),
 		contact_sph_bodies_(contact_sph_bodies),
 		inner_configuration_(inner_relation_->inner_configuration_),
-		contact_configuration_(contact_relation_->contact_configuration_)
+		contact_configuration_(contact_relation_->contact_configuration_),
+		compressed_inner_configuration_(inner_relation_->compressed_inner_configuration_),
+		compressed_contact_configuration_(contact_relation_->compressed_contact_configuration_)
 	{
 		updateConfigurationMemories();
 	};	
@@ -116,8 +478,29 @@ namespace SPH
 	//=================================================================================================//
 	void SPHBodyComplexRelation::updateConfiguration()
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		inner_relation_->updateConfiguration();
 		contact_relation_->updateConfiguration();
 	}
 	//=================================================================================================//
+	void SPHBodyComplexRelation::setSkinDistance(Real skin_distance)
+	{
+		SPHBodyBaseRelation::setSkinDistance(skin_distance);
+		inner_relation_->setSkinDistance(skin_distance);
+		contact_relation_->setSkinDistance(skin_distance);
+	}
+	//=================================================================================================//
+	void SPHBodyComplexRelation::setUsedBySplitCellDynamics()
+	{
+		SPHBodyBaseRelation::setUsedBySplitCellDynamics();
+		inner_relation_->setUsedBySplitCellDynamics();
+		contact_relation_->setUsedBySplitCellDynamics();
+	}
+	//=================================================================================================//
+	void SPHBodyComplexRelation::accountMemory(MemoryFootprint& footprint)
+	{
+		inner_relation_->accountMemory(footprint);
+		contact_relation_->accountMemory(footprint);
+	}
+	//=================================================================================================//
 }
@@ -45,9 +45,41 @@ namespace SPH
 		size_t operator () (size_t particle_entry) const { return body_part_particles_[particle_entry]; };
 	};
 
+	/**
+	 * @class ConfigurationBuildRecord
+	 * @brief The state of the particles of a body when a configuration is built.
+	 * It is used to decide whether a configuration with Verlet skin should be rebuilt.
+	 */
+	class ConfigurationBuildRecord
+	{
+	public:
+		explicit ConfigurationBuildRecord(SPHBody* sph_body);
+		virtual ~ConfigurationBuildRecord() {};
+
+		/** record the particle positions at the build */
+		void recordParticles();
+		/** the maximum particle displacement since the build, 
+		  * infinity if the particles have been added, removed, sorted or have ghosts. */
+		Real MaximumDisplacement();
+		/** add the memory record of the recorded positions */
+		void accountMemory(MemoryFootprint& footprint, const std::string& name);
+	protected:
+		SPHBody* sph_body_;
+		BaseParticles* base_particles_;
+		size_t number_of_particles_;
+		size_t sorting_count_;
+		StdLargeVec<Vecd> pos_;
+	};
+
 	/**
 	 * @class SPHBodyBaseRelation
-	 * @brief The relation within a SPH body or with its contact SPH bodies
+	 * @brief The relation within a SPH body or with its contact SPH bodies.
+	 * With a Verlet skin distance, the configuration is built with the cutoff radius plus the skin
+	 * and only rebuilt when the particles have moved for more than half of the skin.
+	 * In between, only the kernel values and directions of the listed neighbors are updated,
+	 * and the neighbors beyond the cutoff radius have zero kernel values.
+	 * The skin is not supported for the bodies with the periodic condition using cell linked list,
+	 * nor for the relations used by the split cell dynamics, which require the neighbors within the adjacent cells.
 	 */
 	class SPHBodyBaseRelation
 	{
@@ -56,14 +88,36 @@ namespace SPH
 		SplitCellLists& split_cell_lists_;
 		BaseParticles* base_particles_;
 		BaseMeshCellLinkedList* mesh_cell_linked_list_;
+		/** whether the neighbor relations are saved in compressed configurations */
+		bool use_compressed_configuration_;
 
-		SPHBodyBaseRelation(SPHBody* sph_body);
+		SPHBodyBaseRelation(SPHBody* sph_body, bool use_compressed_configuration = false);
 		virtual ~SPHBodyBaseRelation() {};
 
 		void subscribe_to_body() { sph_body_->body_relations_.push_back(this); };
 		virtual void updateConfigurationMemories() = 0;
 		virtual void updateConfiguration() = 0;
+		/** set the Verlet skin distance, zero (the default) for rebuilding at every update */
+		virtual void setSkinDistance(Real skin_distance);
+		/** mark the relation used by a split cell dynamics, for which the skin is refused */
+		virtual void setUsedBySplitCellDynamics();
+		/** add the memory records of the configurations */
+		virtual void accountMemory(MemoryFootprint& footprint) = 0;
 	protected:
+		Real skin_distance_;
+		bool is_used_by_split_cell_dynamics_;
+
+		/** exit if the relation with a skin is used by a split cell dynamics, as the neighbors
+		  * beyond the adjacent cells are written by the concurrently computed cells of the same split cell list */
+		void checkSkinWithSplitCellDynamics();
+		/** exit if one of the bodies has periodic images in its cell linked list,
+		  * which are listed with the real particle indices and cannot be refreshed with the skin */
+		void checkPeriodicImagesWithSkin(SPHBodyVector sph_bodies);
+		/** the number of additional cells to be searched due to the skin */
+		int SkinSearchRange(BaseMeshCellLinkedList& target_mesh_cell_linked_list);
+		/** update kernel values, distances and directions of the listed neighbors */
+		void refreshNeighborhood(NeighborhoodView neighborhood, Kernel& kernel,
+			Vecd& pos_i, StdLargeVec<Vecd>& target_pos);
 		virtual void createNeighborRelation(Neighborhood& neighborhood,
 			Kernel& kernel, Vecd& vec_r_ij, size_t i_index, size_t j_index);
 		virtual void initializeNeighborRelation(Neighborhood& neighborhood, size_t current_count_of_neighbors, 
@@ -80,12 +134,45 @@ namespace SPH
 	public:
 		/** inner configuration for the neighbor relations. */
 		ParticleConfiguration inner_configuration_;
+		/** inner configuration in compressed layout, used when use_compressed_configuration_ is true. */
+		CompressedParticleConfiguration compressed_inner_configuration_;
 
-		SPHBodyInnerRelation(SPHBody* sph_body);
+		SPHBodyInnerRelation(SPHBody* sph_body, bool use_compressed_configuration = false);
 		virtual ~SPHBodyInnerRelation() {};
 
 		virtual void updateConfigurationMemories() override;
 		virtual void updateConfiguration() override;
+		virtual void accountMemory(MemoryFootprint& footprint) override;
+		bool isHalfConfiguration() { return is_half_configuration_; };
+	protected:
+		/** whether a particle pair is listed only once, i.e. particle i only has neighbors j > i */
+		bool is_half_configuration_;
+		ConfigurationBuildRecord build_record_;
+
+		bool isNeighborToBeListed(size_t index_i, size_t index_j)
+		{
+			return is_half_configuration_ ? index_j > index_i : index_j != index_i;
+		};
+
+		void buildConfiguration();
+		void buildCompressedConfiguration();
+		void refreshConfiguration();
+	};
+
+	/**
+	 * @class SPHBodyHalfInnerRelation
+	 * @brief The relation within a SPH body in which a particle pair is listed only once,
+	 * i.e. particle i only has the neighbors j > i. It is used by pairwise interaction dynamics.
+	 */
+	class SPHBodyHalfInnerRelation : public SPHBodyInnerRelation
+	{
+	public:
+		SPHBodyHalfInnerRelation(SPHBody* sph_body, bool use_compressed_configuration = false)
+			: SPHBodyInnerRelation(sph_body, use_compressed_configuration) 
+		{
+			is_half_configuration_ = true;
+		};
+		virtual ~SPHBodyHalfInnerRelation() {};
 	};
 
 	/**
@@ -99,18 +186,30 @@ namespace SPH
 		StdVec<BaseMeshCellLinkedList*> target_mesh_cell_linked_lists_;
 		template<typename GetParticleIndex> 
 		void updateConfigurationForParticles(size_t number_of_particles, GetParticleIndex& get_particle_index);
+		template<typename GetParticleIndex>
+		void updateCompressedConfigurationForParticles(size_t number_of_particles, GetParticleIndex& get_particle_index);
+		template<typename GetParticleIndex>
+		void refreshConfigurationForParticles(size_t number_of_particles, GetParticleIndex& get_particle_index);
+		/** build or refresh the configuration depending on the Verlet skin */
+		template<typename GetParticleIndex>
+		void updateContactConfiguration(size_t number_of_particles, GetParticleIndex& get_particle_index);
+		ConfigurationBuildRecord build_record_;
+		StdVec<ConfigurationBuildRecord> contact_build_records_;
 
 	public:
 		SPHBodyVector contact_sph_bodies_;
 
 		/** Configurations for particle interaction between bodies. */
 		ContatcParticleConfiguration contact_configuration_;
+		/** Compressed configurations, used when use_compressed_configuration_ is true. */
+		CompressedContactParticleConfiguration compressed_contact_configuration_;
 
-		SPHBodyContactRelation(SPHBody* body, SPHBodyVector relation_bodies);
+		SPHBodyContactRelation(SPHBody* body, SPHBodyVector relation_bodies, bool use_compressed_configuration = false);
 		virtual ~SPHBodyContactRelation() {};
 
 		virtual void updateConfigurationMemories() override;
 		virtual void updateConfiguration() override;
+		virtual void accountMemory(MemoryFootprint& footprint) override;
 	};
 
 	/**
@@ -147,8 +246,11 @@ namespace SPH
 		ParticleConfiguration& inner_configuration_;
 		/** Configurations for updated Lagrangian formulation. **/
 		ContatcParticleConfiguration& contact_configuration_;
+		/** compressed configurations, used when use_compressed_configuration_ is true. */
+		CompressedParticleConfiguration& compressed_inner_configuration_;
+		CompressedContactParticleConfiguration& compressed_contact_configuration_;
 
-		SPHBodyComplexRelation(SPHBody* body, SPHBodyVector contact_sph_bodies);
+		SPHBodyComplexRelation(SPHBody* body, SPHBodyVector contact_sph_bodies, bool use_compressed_configuration = false);
 		SPHBodyComplexRelation(SPHBodyInnerRelation* body_inner_relation, SPHBodyVector contact_sph_bodies);
 		virtual ~SPHBodyComplexRelation() {
 			delete inner_relation_;
@@ -160,5 +262,10 @@ namespace SPH
 
 		virtual void updateConfigurationMemories() override;
 		virtual void updateConfiguration()  override;
+		virtual void setSkinDistance(Real skin_distance) override;
+		virtual void setUsedBySplitCellDynamics() override;
+		/** the inner and contact relations are subscribed to the body and account their memories by themselves,
+		  * this is only for accounting the complex relation directly. */
+		virtual void accountMemory(MemoryFootprint& footprint) override;
 	};
 }
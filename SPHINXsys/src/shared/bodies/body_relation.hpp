@@ -7,10 +7,12 @@
  * 			Cell splitting algorithm are added.
  * 			Chi Zhang
  */
+#pragma once
+
 #include "body_relation.h"
 #include "base_particles.h"
 #include "base_kernel.h"
-#include "mesh_cell_linked_list.h"
+#include "mesh_cell_linked_list.hpp"
 
 namespace SPH
 {
@@ -24,13 +26,13 @@ namespace SPH
 		{
 			BaseMeshCellLinkedList& target_mesh_cell_linked_list
 				= *(target_mesh_cell_linked_lists_[relation_body_num]);
-			Vecu target_number_of_cells = target_mesh_cell_linked_list.NumberOfCells();
 			int search_range = 
 				mesh_cell_linked_list_->computeSearchRange(sph_body_->refinement_level_,
-					contact_sph_bodies_[relation_body_num]->refinement_level_);
+					contact_sph_bodies_[relation_body_num]->refinement_level_)
+				+ SkinSearchRange(target_mesh_cell_linked_list);
 			Kernel& current_kernel = mesh_cell_linked_list_->ChoosingKernel(sph_body_->kernel_,
 				contact_sph_bodies_[relation_body_num]->kernel_);
-			Real cutoff_radius_sqr = powern(current_kernel.GetCutOffRadius(), 2);
+			Real cutoff_radius_sqr = powern(current_kernel.GetCutOffRadius() + skin_distance_, 2);
 
 			parallel_for(blocked_range<size_t>(0, number_of_particles),
 				[&](const blocked_range<size_t>& r) {
@@ -40,32 +42,23 @@ namespace SPH
 						Vecd particle_position = base_particles->pos_n_[index_i];
 						Vecu target_cell_index = target_mesh_cell_linked_list
 							.GridIndexFromPosition(particle_position);
-						int i = (int)target_cell_index[0];
-						int j = (int)target_cell_index[1];
-						matrix_cell target_cell_linked_lists
-							= target_mesh_cell_linked_list.CellLinkedLists();
 
 						Neighborhood& neighborhood = contact_configuration_[relation_body_num][index_i];
 						size_t current_count_of_neighbors = 0;
-						for (int l = SMAX(i - search_range, 0); l <= SMIN(i + search_range, int(target_number_of_cells[0]) - 1); ++l)
-							for (int m = SMAX(j - search_range, 0); m <= SMIN(j + search_range, int(target_number_of_cells[1]) - 1); ++m)
-							{
-								CellListDataVector& target_particles = target_cell_linked_lists[l][m].cell_list_data_;
-								for (size_t n = 0; n < target_particles.size(); n++)
+						target_mesh_cell_linked_list.searchCellListDataAround(target_cell_index, search_range,
+							[&](ListData& list_data) {
+								//displacement pointing from neighboring particle to origin particle
+								Vecd displacement = particle_position - list_data.second;
+								if (displacement.normSqr() <= cutoff_radius_sqr)
 								{
-										//displacement pointing from neighboring particle to origin particle
-									Vecd displacement = particle_position - target_particles[n].second;
-									if (displacement.normSqr() <= cutoff_radius_sqr)
-									{
-										current_count_of_neighbors >= neighborhood.memory_size_ ?
-											createNeighborRelation(neighborhood,
-												current_kernel, displacement, index_i, target_particles[n].first)
-											: initializeNeighborRelation(neighborhood, current_count_of_neighbors,
-												current_kernel, displacement, index_i, target_particles[n].first);
-										current_count_of_neighbors++;
-									}
+									current_count_of_neighbors >= neighborhood.memory_size_ ?
+										createNeighborRelation(neighborhood,
+											current_kernel, displacement, index_i, list_data.first)
+										: initializeNeighborRelation(neighborhood, current_count_of_neighbors,
+											current_kernel, displacement, index_i, list_data.first);
+									current_count_of_neighbors++;
 								}
-							}
+							});
 						neighborhood.current_size_ = current_count_of_neighbors;
 					}
 				}, ap);
@@ -41,6 +41,7 @@ namespace SPH {
 	/**
 	 * @class FluidBody
 	 * @brief Declaration of fluid body.
+	 * The particle data are sorted by an adaptive sorting policy by default.
 	 */
 	class FluidBody : public RealBody
 	{
@@ -49,11 +50,7 @@ namespace SPH {
 			ParticleGenerator* particle_generator = new ParticleGeneratorLattice());
 		virtual ~FluidBody() {};
 
-		/** Update cell linked list with particle sorting. */
-		virtual void updateCellLinkedList() override;
 		/** The pointer to derived class object. */
 		virtual FluidBody* pointToThisObject() override { return this; };
-	protected:
-		size_t iteration_count_;
 	};
 }
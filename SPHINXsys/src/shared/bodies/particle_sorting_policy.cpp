@@ -0,0 +1,121 @@
+/**
+ * @file 	particle_sorting_policy.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "particle_sorting_policy.h"
+#include "base_body.h"
+#include "base_particles.h"
+#include "mesh_cell_linked_list.h"
+
+namespace SPH
+{
+	//=================================================================================================//
+	ParticleSortingPolicy::ParticleSortingPolicy(SPHBody* body, size_t sorting_interval)
+		: body_(body), sorting_interval_(sorting_interval), 
+		updates_since_sorting_(sorting_interval), total_updates_(0), total_sortings_(0),
+		is_reporting_(false) {}
+	//=================================================================================================//
+	bool ParticleSortingPolicy::isSortingNeeded()
+	{
+		return updates_since_sorting_ >= sorting_interval_;
+	}
+	//=================================================================================================//
+	void ParticleSortingPolicy::reportSorting(Real sorting_time)
+	{
+		std::cout << "\n Particle sorting of " << body_->GetBodyName() 
+			<< " after " << updates_since_sorting_ << " cell linked list updates,"
+			<< " sorting time " << sorting_time << " s." << std::endl;
+	}
+	//=================================================================================================//
+	void ParticleSortingPolicy::updateCellLinkedList()
+	{
+		BaseMeshCellLinkedList* mesh_cell_linked_list = body_->mesh_cell_linked_list_;
+		if (isSortingNeeded())
+		{
+			tick_count sorting_start = tick_count::now();
+			mesh_cell_linked_list->sortingParticleData();
+			Real sorting_time = (tick_count::now() - sorting_start).seconds();
+			if (is_reporting_) reportSorting(sorting_time);
+			recordSorting(sorting_time);
+			updates_since_sorting_ = 0;
+			total_sortings_++;
+		}
+
+		mesh_cell_linked_list->UpdateCellLists();
+		updates_since_sorting_++;
+		total_updates_++;
+	}
+	//=================================================================================================//
+	AdaptiveParticleSorting::AdaptiveParticleSorting(SPHBody* body)
+		: ParticleSortingPolicy(body), sorting_cost_(0), accumulated_slowdown_(0),
+		update_slowdown_(0), is_just_sorted_(false) {}
+	//=================================================================================================//
+	void AdaptiveParticleSorting::recordInteractionLoop(const std::type_info& dynamics_type,
+		Real loop_time, size_t number_of_particles)
+	{
+		if (total_sortings_ == 0 || number_of_particles == 0) return;
+
+		std::lock_guard<std::mutex> lock(mutex_records_);
+		Real loop_cost = loop_time / Real(number_of_particles);
+		std::map<std::type_index, Real>::iterator sorted_loop_cost = sorted_loop_costs_.find(std::type_index(dynamics_type));
+		if (sorted_loop_cost == sorted_loop_costs_.end())
+		{
+			sorted_loop_costs_[std::type_index(dynamics_type)] = loop_cost;
+		}
+		else if (is_just_sorted_)
+		{
+			/** the fastest loop of the first interval, as the first loop after a sorting may be slowed down by cold caches */
+			sorted_loop_cost->second = SMIN(sorted_loop_cost->second, loop_cost);
+		}
+		else
+		{
+			update_slowdown_ += loop_time - sorted_loop_cost->second * Real(number_of_particles);
+		}
+	}
+	//=================================================================================================//
+	bool AdaptiveParticleSorting::isSortingNeeded()
+	{
+		if (total_sortings_ == 0) return true;
+
+		std::lock_guard<std::mutex> lock(mutex_records_);
+		accumulated_slowdown_ = SMAX(accumulated_slowdown_ + update_slowdown_, Real(0));
+		update_slowdown_ = 0.0;
+		is_just_sorted_ = false;
+		return accumulated_slowdown_ > sorting_cost_;
+	}
+	//=================================================================================================//
+	void AdaptiveParticleSorting::recordSorting(Real sorting_time)
+	{
+		std::lock_guard<std::mutex> lock(mutex_records_);
+		sorting_cost_ = sorting_time;
+		sorted_loop_costs_.clear();
+		accumulated_slowdown_ = 0.0;
+		update_slowdown_ = 0.0;
+		is_just_sorted_ = true;
+	}
+	//=================================================================================================//
+	void AdaptiveParticleSorting::reportSorting(Real sorting_time)
+	{
+		std::cout << "\n Particle sorting of " << body_->GetBodyName()
+			<< " after " << updates_since_sorting_ << " cell linked list updates,"
+			<< " measured slowdown " << accumulated_slowdown_
+			<< " s, previous sorting time " << sorting_cost_
+			<< " s, sorting time " << sorting_time << " s." << std::endl;
+	}
+	//=================================================================================================//
+	InteractionLoopTimer::InteractionLoopTimer(const std::type_info& dynamics_type, SPHBody* body)
+		: body_(body), dynamics_type_(dynamics_type), particle_sorting_policy_(body->particle_sorting_policy_)
+	{
+		if (particle_sorting_policy_ != NULL) start_ = tick_count::now();
+	}
+	//=================================================================================================//
+	InteractionLoopTimer::~InteractionLoopTimer()
+	{
+		if (particle_sorting_policy_ != NULL)
+			particle_sorting_policy_->recordInteractionLoop(dynamics_type_,
+				(tick_count::now() - start_).seconds(), body_->number_of_particles_);
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,139 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+ * @file 	particle_sorting_policy.h
+ * @brief 	Here gives the policies deciding when the particle data of a body are sorted.
+ * @details The sorting improves the memory locality of the particle interactions,
+ *			but it has its own cost. The fixed policy sorts once for a given number of
+ *			cell linked list updates. The adaptive policy measures the wall time of the
+ *			interaction loops of the body and sorts when the measured slowdown since
+ *			the last sorting has paid off the sorting cost.
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_data_package.h"
+#include "sph_data_conainers.h"
+
+#include <string>
+#include <map>
+#include <mutex>
+#include <typeinfo>
+#include <typeindex>
+using namespace std;
+
+namespace SPH
+{
+	class SPHBody;
+
+	/**
+	 * @class ParticleSortingPolicy
+	 * @brief Sorting the particle data for a fixed number of cell linked list updates.
+	 */
+	class ParticleSortingPolicy
+	{
+	protected:
+		SPHBody* body_;
+		/** number of cell linked list updates between two sortings */
+		size_t sorting_interval_;
+		/** number of cell linked list updates since the last sorting */
+		size_t updates_since_sorting_;
+		size_t total_updates_;
+		size_t total_sortings_;
+		/** report each sorting decision to the screen */
+		bool is_reporting_;
+
+		/** decide whether the particle data are sorted before the cell linked list update */
+		virtual bool isSortingNeeded();
+		/** record the measured wall time of a sorting */
+		virtual void recordSorting(Real sorting_time) {};
+		/** report a sorting decision */
+		virtual void reportSorting(Real sorting_time);
+	public:
+		explicit ParticleSortingPolicy(SPHBody* body, size_t sorting_interval = 100);
+		virtual ~ParticleSortingPolicy() {};
+
+		/** update the cell linked list of the body, with sorting if it is needed */
+		void updateCellLinkedList();
+		/** record the measured wall time of an interaction loop over the particles of the body */
+		virtual void recordInteractionLoop(const std::type_info& dynamics_type,
+			Real loop_time, size_t number_of_particles) {};
+		void setReporting(bool is_reporting) { is_reporting_ = is_reporting; };
+		size_t TotalUpdates() { return total_updates_; };
+		size_t TotalSortings() { return total_sortings_; };
+	};
+
+	/**
+	 * @class AdaptiveParticleSorting
+	 * @brief Sorting the particle data when the measured slowdown exceeds the sorting cost.
+	 * The wall time per particle of each type of interaction loop is measured
+	 * during the first cell linked list update interval after a sorting, as the cost in sorted order.
+	 * Afterwards, the slowdown of each loop is its wall time minus the cost in sorted order.
+	 * The sorting is carried out once the accumulated slowdown exceeds the measured sorting cost,
+	 * so that slow flows are seldom sorted and violent flows are sorted more often.
+	 * The accumulated slowdown does not drop below zero, so that timing noise does not delay the sorting.
+	 * The records are guarded by a mutex, as the loops of concurrent tasks of a dynamics graph may record together.
+	 */
+	class AdaptiveParticleSorting : public ParticleSortingPolicy
+	{
+	protected:
+		/** wall time per particle of the interaction loops in sorted order */
+		std::map<std::type_index, Real> sorted_loop_costs_;
+		/** wall time of the last sorting */
+		Real sorting_cost_;
+		Real accumulated_slowdown_;
+		/** slowdown measured since the last cell linked list update */
+		Real update_slowdown_;
+		bool is_just_sorted_;
+		std::mutex mutex_records_;	/**< mutex exclusion for the records */
+
+		virtual bool isSortingNeeded() override;
+		virtual void recordSorting(Real sorting_time) override;
+		virtual void reportSorting(Real sorting_time) override;
+	public:
+		explicit AdaptiveParticleSorting(SPHBody* body);
+		virtual ~AdaptiveParticleSorting() {};
+
+		virtual void recordInteractionLoop(const std::type_info& dynamics_type,
+			Real loop_time, size_t number_of_particles) override;
+		Real AccumulatedSlowdown() { return accumulated_slowdown_; };
+	};
+
+	/**
+	 * @class InteractionLoopTimer
+	 * @brief Measures the wall time of an interaction loop within its scope
+	 * for the particle sorting policy of the body, no timing if the body has no policy.
+	 */
+	class InteractionLoopTimer
+	{
+	protected:
+		SPHBody* body_;
+		const std::type_info& dynamics_type_;
+		ParticleSortingPolicy* particle_sorting_policy_;
+		tick_count start_;
+	public:
+		InteractionLoopTimer(const std::type_info& dynamics_type, SPHBody* body);
+		virtual ~InteractionLoopTimer();
+	};
+}
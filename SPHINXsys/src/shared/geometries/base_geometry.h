@@ -36,6 +36,7 @@
 #include "sph_data_conainers.h"
 
 #include <string>
+#include <cstdint>
 using namespace std;
 
 namespace SPH
@@ -50,6 +51,18 @@ namespace SPH
 	 */
 	enum class ShapeBooleanOps { add, sub, sym_diff, intersect };
 
+	/** FNV-1a hash of the data defining a shape, which is the same for every run on the same platform. */
+	inline uint64_t hashShapeData(const void* data, size_t size, uint64_t hash = 14695981039346656037ULL)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i != size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
 	/**
 	 * @class Shape
 	 * @brief Base class for all geometries
@@ -63,6 +76,8 @@ namespace SPH
 		string getName() { return name_; };
 		virtual Vecd findClosestPoint(Vecd input_pnt) = 0;
 		virtual void findBounds(Vecd& lower_bound, Vecd& upper_bound) = 0;
+		/** add the memory records of the data describing the shape, if they are large */
+		virtual void accountMemory(MemoryFootprint& footprint) {};
 
 	protected:
 		string name_;
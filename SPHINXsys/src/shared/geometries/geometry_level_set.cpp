@@ -56,4 +56,9 @@ namespace SPH {
 	{
 		return level_set_->computeKernelIntegral(input_pnt, kernel);
 	}
+	//=================================================================================================//
+	void LevelSetComplexShape::accountMemory(MemoryFootprint& footprint)
+	{
+		level_set_->accountMemory(footprint);
+	}
 }
@@ -32,6 +32,7 @@ namespace SPH {
 		virtual Real findSignedDistance(Vecd input_pnt) override;
 		virtual Vecd findNormalDirection(Vecd input_pnt) override;
 		virtual Vecd computeKernelIntegral(Vecd input_pnt, Kernel * kernel) override;
+		virtual void accountMemory(MemoryFootprint& footprint) override;
 	protected:
 		BaseLevelSet* level_set_;	/**< narrow bounded levelset mesh. */
 	};
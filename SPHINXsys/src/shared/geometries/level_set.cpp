@@ -89,7 +89,7 @@ namespace SPH {
 	{
 		PackageFunctor<void, LevelSetDataPackage> update_normal_diraction
 			= std::bind(&LevelSet::updateNormalDirectionForAPackage, this, _1, _2);
-		PackageIterator_parallel<LevelSetDataPackage>(inner_data_pkgs_, update_normal_diraction);
+		PackageIterator_parallel<LevelSetDataPackage>(inner_data_pkgs_, update_normal_diraction, inner_pkgs_partitioner_);
 	}
 	//=================================================================================================//
 	Vecd LevelSet::probeNormalDirection(Vecd position)
@@ -120,14 +120,14 @@ namespace SPH {
 		PackageFunctor<void, LevelSetDataPackage> reinitialize_levelset
 			= std::bind(&LevelSet::stepReinitializationForAPackage, this, _1, _2);
 		for (size_t i = 0; i < 50; ++i)
-			PackageIterator_parallel<LevelSetDataPackage>(inner_data_pkgs_, reinitialize_levelset);
+			PackageIterator_parallel<LevelSetDataPackage>(inner_data_pkgs_, reinitialize_levelset, inner_pkgs_partitioner_);
 	}
 	//=================================================================================================//
 	void LevelSet::markNearInterface()
 	{
 		PackageFunctor<void, LevelSetDataPackage> mark_cutcell_by_levelset
 			= std::bind(&LevelSet::markNearInterfaceForAPackage, this, _1, _2);
-		PackageIterator_parallel<LevelSetDataPackage>(core_data_pkgs_, mark_cutcell_by_levelset);
+		PackageIterator_parallel<LevelSetDataPackage>(core_data_pkgs_, mark_cutcell_by_levelset, core_pkgs_partitioner_);
 	}
 	//=================================================================================================//
 	void LevelSet::markNearInterfaceForAPackage(LevelSetDataPackage* core_data_pkg, Real dt)
@@ -139,7 +139,7 @@ namespace SPH {
 	{
 		PackageFunctor<void, LevelSetDataPackage> clean_levelset
 			= std::bind(&LevelSet::redistanceInterfaceForAPackage, this, _1, _2);
-		PackageIterator_parallel<LevelSetDataPackage>(core_data_pkgs_, clean_levelset);
+		PackageIterator_parallel<LevelSetDataPackage>(core_data_pkgs_, clean_levelset, core_pkgs_partitioner_);
 	}
 	//=================================================================================================//
 	void LevelSet::cleanInterface(bool isSmoothed)
@@ -161,6 +161,8 @@ namespace SPH
 	public:
 		/** Core packages which are near to zero level set. */
 		ConcurrentVector<LevelSetDataPackage*> core_data_pkgs_;
+		/** Partitioner and grain size for the loops on the core packages. */
+		LoopPartitioner core_pkgs_partitioner_;
 
 		/** Constructor using domain and sph body information. */
 		LevelSet(ComplexShape& complex_shape,  	/**< Link to geomentry. */
@@ -0,0 +1,196 @@
+/**
+ * @file 	binary_restart_file.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "binary_restart_file.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace SPH
+{
+	namespace
+	{
+		const char restart_file_tag[8] = { 'S', 'P', 'H', 'R', 'S', 'T', '0', '1' };
+		/** the arrays start at multiples of the cache line size */
+		const size_t restart_array_alignment = 64;
+
+		void appendValue(std::string& header, uint64_t value)
+		{
+			header.append(reinterpret_cast<const char*>(&value), sizeof(uint64_t));
+		}
+
+		void appendString(std::string& header, const std::string& value)
+		{
+			appendValue(header, value.size());
+			header.append(value);
+		}
+
+		void restartFileError(const std::string& filefullpath, const std::string& message)
+		{
+			std::cout << "\n Error: the restart file " << filefullpath << " " << message << std::endl;
+			exit(1);
+		}
+
+		/** the header with the offsets computed for its own size */
+		std::string restartFileHeader(StdVec<RestartArray>& arrays, const std::string& body_name,
+			const std::string& key, size_t number_of_particles, Real physical_time)
+		{
+			std::string header;
+			for (size_t pass = 0; pass != 2; ++pass)
+			{
+				size_t offset = (header.size() + restart_array_alignment - 1) / restart_array_alignment * restart_array_alignment;
+				for (RestartArray& restart_array : arrays)
+				{
+					restart_array.offset_ = offset;
+					size_t array_size = number_of_particles * restart_array.element_size_;
+					offset += (array_size + restart_array_alignment - 1) / restart_array_alignment * restart_array_alignment;
+				}
+
+				header.assign(restart_file_tag, sizeof(restart_file_tag));
+				appendValue(header, sizeof(Real));
+				appendString(header, body_name);
+				appendString(header, key);
+				appendValue(header, number_of_particles);
+				header.append(reinterpret_cast<const char*>(&physical_time), sizeof(Real));
+				appendValue(header, arrays.size());
+				for (RestartArray& restart_array : arrays)
+				{
+					appendString(header, restart_array.name_);
+					appendValue(header, restart_array.element_size_);
+					appendValue(header, restart_array.offset_);
+				}
+			}
+			return header;
+		}
+	}
+	//=================================================================================================//
+	void BinaryRestartWriter::addArray(const std::string& name, const char* data, size_t element_size)
+	{
+		RestartArray restart_array = { name, element_size, 0, data };
+		arrays_.push_back(restart_array);
+	}
+	//=================================================================================================//
+	void BinaryRestartWriter::writeToFile(const std::string& filefullpath, const std::string& body_name,
+		size_t number_of_particles, Real physical_time, const std::string& key)
+	{
+		std::string header = restartFileHeader(arrays_, body_name, key, number_of_particles, physical_time);
+		std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+		out_file.write(header.data(), header.size());
+
+		const std::string padding(restart_array_alignment, '\0');
+		size_t position = header.size();
+		for (const RestartArray& restart_array : arrays_)
+		{
+			out_file.write(padding.data(), restart_array.offset_ - position);
+			size_t array_size = number_of_particles * restart_array.element_size_;
+			out_file.write(restart_array.data_, array_size);
+			position = restart_array.offset_ + array_size;
+		}
+		out_file.close();
+	}
+	//=================================================================================================//
+	BinaryRestartReader::BinaryRestartReader(const std::string& filefullpath)
+		: number_of_particles_(0), physical_time_(0.0), filefullpath_(filefullpath),
+		file_data_(NULL), file_size_(0)
+	{
+		namespace bip = boost::interprocess;
+		try
+		{
+			file_mapping_.reset(new bip::file_mapping(filefullpath.c_str(), bip::read_only));
+			mapped_region_.reset(new bip::mapped_region(*file_mapping_, bip::read_only));
+		}
+		catch (const bip::interprocess_exception& exception)
+		{
+			restartFileError(filefullpath, std::string("can not be mapped: ") + exception.what());
+		}
+		file_data_ = static_cast<const char*>(mapped_region_->get_address());
+		file_size_ = mapped_region_->get_size();
+
+		size_t position = 0;
+		auto read = [&](void* value, size_t size) {
+			if (position + size > file_size_) restartFileError(filefullpath_, "has an incomplete header.");
+			std::memcpy(value, file_data_ + position, size);
+			position += size;
+		};
+		auto readValue = [&]() { uint64_t value = 0; read(&value, sizeof(uint64_t)); return size_t(value); };
+		auto readString = [&]() {
+			size_t length = readValue();
+			if (position + length > file_size_) restartFileError(filefullpath_, "has an incomplete header.");
+			std::string value(file_data_ + position, length);
+			position += length;
+			return value;
+		};
+
+		char tag[sizeof(restart_file_tag)];
+		read(tag, sizeof(restart_file_tag));
+		if (std::memcmp(tag, restart_file_tag, sizeof(restart_file_tag)) != 0)
+			restartFileError(filefullpath_, "is not a binary restart file.");
+		if (readValue() != sizeof(Real))
+			restartFileError(filefullpath_, "was written with another floating point precision.");
+		body_name_ = readString();
+		key_ = readString();
+		number_of_particles_ = readValue();
+		read(&physical_time_, sizeof(Real));
+
+		size_t number_of_arrays = readValue();
+		for (size_t i = 0; i != number_of_arrays; ++i)
+		{
+			RestartArray restart_array;
+			restart_array.name_ = readString();
+			restart_array.element_size_ = readValue();
+			restart_array.offset_ = readValue();
+			restart_array.data_ = NULL;
+			if (restart_array.offset_ + number_of_particles_ * restart_array.element_size_ > file_size_)
+				restartFileError(filefullpath_, "is truncated in the array " + restart_array.name_ + ".");
+			restart_array.data_ = file_data_ + restart_array.offset_;
+			arrays_.push_back(restart_array);
+		}
+	}
+	//=================================================================================================//
+	BinaryRestartReader::~BinaryRestartReader() {}
+	//=================================================================================================//
+	bool BinaryRestartReader::probeKey(const std::string& filefullpath, std::string& key)
+	{
+		std::ifstream in_file(filefullpath.c_str(), std::ios::binary | std::ios::ate);
+		if (!in_file) return false;
+		size_t file_size = size_t(in_file.tellg());
+		in_file.seekg(0);
+
+		char tag[sizeof(restart_file_tag)];
+		uint64_t real_size = 0, body_name_length = 0, key_length = 0;
+		in_file.read(tag, sizeof(restart_file_tag));
+		in_file.read(reinterpret_cast<char*>(&real_size), sizeof(uint64_t));
+		in_file.read(reinterpret_cast<char*>(&body_name_length), sizeof(uint64_t));
+		if (!in_file || std::memcmp(tag, restart_file_tag, sizeof(restart_file_tag)) != 0
+			|| real_size != sizeof(Real) || body_name_length > file_size) return false;
+
+		in_file.seekg(body_name_length, std::ios::cur);
+		in_file.read(reinterpret_cast<char*>(&key_length), sizeof(uint64_t));
+		if (!in_file || key_length > file_size) return false;
+		key.assign(size_t(key_length), '\0');
+		if (!key.empty()) in_file.read(&key[0], key.size());
+		return bool(in_file);
+	}
+	//=================================================================================================//
+	void BinaryRestartReader::copyArray(size_t array_index, const std::string& name, char* destination,
+		size_t element_size, size_t destination_size)
+	{
+		if (array_index >= arrays_.size() || arrays_[array_index].name_ != name
+			|| arrays_[array_index].element_size_ != element_size)
+		{
+			restartFileError(filefullpath_, "does not have the array " + name + " at the position "
+				+ std::to_string(array_index) + " of its table.");
+		}
+		if (number_of_particles_ > destination_size)
+			restartFileError(filefullpath_, "has more particles than the array " + name + ".");
+		std::memcpy(destination, arrays_[array_index].data_, number_of_particles_ * element_size);
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,92 @@
+/**
+ * @file 	binary_restart_file.h
+ * @brief 	The binary restart file of the particles of a body.
+ * @details The file starts with a header with the body name, a key identifying the data,
+ *			the number of particles, the physical time and the table of the arrays,
+ *			i.e. their names, element sizes and offsets.
+ *			The raw arrays follow at cache-line aligned offsets.
+ *			The file is read through a read-only memory mapping,
+ *			so that the restart is a bulk copy for each array.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+
+#include <string>
+#include <memory>
+
+namespace boost
+{
+	namespace interprocess
+	{
+		class file_mapping;
+		class mapped_region;
+	}
+}
+
+namespace SPH
+{
+	/** The format of the restart and particle reload files. The xml format is kept for exporting. */
+	enum class RestartFormat { binary, xml };
+
+	/**
+	 * @struct RestartArray
+	 * @brief An entry of the array table of a restart file.
+	 */
+	struct RestartArray
+	{
+		std::string name_;
+		size_t element_size_;
+		size_t offset_;			/**< from the start of the file */
+		const char* data_;		/**< the data to be written */
+	};
+
+	/**
+	 * @class BinaryRestartWriter
+	 * @brief Collects the arrays of a body and writes them with one bulk write for each.
+	 */
+	class BinaryRestartWriter
+	{
+	public:
+		BinaryRestartWriter() {};
+		virtual ~BinaryRestartWriter() {};
+
+		void addArray(const std::string& name, const char* data, size_t element_size);
+		void writeToFile(const std::string& filefullpath, const std::string& body_name,
+			size_t number_of_particles, Real physical_time, const std::string& key = "");
+	protected:
+		StdVec<RestartArray> arrays_;
+	};
+
+	/**
+	 * @class BinaryRestartReader
+	 * @brief Maps a restart file and parses its header.
+	 * The arrays are copied in the same order as they were added when written.
+	 */
+	class BinaryRestartReader
+	{
+	public:
+		explicit BinaryRestartReader(const std::string& filefullpath);
+		virtual ~BinaryRestartReader();
+
+		std::string body_name_;
+		std::string key_;
+		size_t number_of_particles_;
+		Real physical_time_;
+		StdVec<RestartArray> arrays_;
+
+		/** read the key from the header without mapping the file, false instead of an error
+		 *  if the file is not a binary restart file written with the present floating point precision */
+		static bool probeKey(const std::string& filefullpath, std::string& key);
+		/** copy the data of the particles after checking the name, the element size and the destination size */
+		void copyArray(size_t array_index, const std::string& name, char* destination,
+			size_t element_size, size_t destination_size);
+	protected:
+		std::string filefullpath_;
+		std::unique_ptr<boost::interprocess::file_mapping> file_mapping_;
+		std::unique_ptr<boost::interprocess::mapped_region> mapped_region_;
+		const char* file_data_;
+		size_t file_size_;
+	};
+}
@@ -8,12 +8,13 @@
 #include "all_types_of_bodies.h"
 #include "level_set.h"
 #include "sph_system.h"
+#include "sph_profiler.h"
 
 namespace SPH
 {
 	//=============================================================================================//
 	In_Output::In_Output(SPHSystem& sph_system)
-		: sph_system_(sph_system)
+		: sph_system_(sph_system), time_series_format_(TimeSeriesFormat::text)
 	{
 		output_folder_ = sph_system.output_folder_;
 		restart_folder_ = sph_system.restart_folder_;
@@ -31,46 +32,65 @@ namespace SPH
 	//=============================================================================================//
 	void WriteBodyStatesToVtu::WriteToFile(Real time)
 	{
+		ProfilerSpan profiler_span(typeid(*this));
 		int Itime = int(time * 1.0e4);
 
 		for (SPHBody* body : bodies_)
 		{
 			if (body->checkNewlyUpdated())
 			{
+				/** an existing file is truncated by the pipeline task, which writes it */
 				std::string filefullpath = in_output_.output_folder_ + "/SPHBody_" + body->GetBodyName() + "_" + std::to_string(Itime) + ".vtu";
-				if (fs::exists(filefullpath))
+				std::shared_ptr<VtuFileWriter> vtu_file = std::make_shared<VtuFileWriter>(encoding_, compressed_);
+				std::string body_name = body->GetBodyName();
+				size_t number_of_particles = body->number_of_particles_;
 				{
-					fs::remove(filefullpath);
+					ProfilerSpan body_profiler_span("writeParticlesToVtuFile", body);
+					if (output_filter_ != NULL) output_filter_->applyTo(*vtu_file, body);
+					body->writeParticlesToVtuFile(*vtu_file);
 				}
-				std::ofstream out_file(filefullpath.c_str(), ios::trunc);
-				//begin of the XML file
-				out_file << "<?xml version=\"1.0\"?>\n";
-				out_file << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
-				out_file << " <UnstructuredGrid>\n";
-
+				number_of_particles = vtu_file->numberOfOutputPoints(number_of_particles);
+
+				in_output_.output_pipeline_.push([vtu_file, filefullpath, body_name, number_of_particles]() {
+					ProfilerSpan file_profiler_span("VtuFileWriter::writeToFile", NULL, number_of_particles);
+					std::ofstream out_file(filefullpath.c_str(), ios::trunc | ios::binary);
+					vtu_file->writeToFile(out_file, body_name, number_of_particles);
+					out_file.close();
+					});
+			}
+			body->setNotNewlyUpdated();
+		}
+	}
+	//=============================================================================================//
+	WriteBodyStatesToContainer::WriteBodyStatesToContainer(In_Output& in_output, SPHBodyVector bodies)
+		: WriteBodyStates(in_output, bodies), output_filter_(NULL)
+	{
+		container_ = std::make_shared<ParticleContainerWriter>(in_output_.output_folder_
+			+ "/SPHBodies_" + in_output_.restart_step_ + ".sphc");
+	}
+	//=============================================================================================//
+	void WriteBodyStatesToContainer::WriteToFile(Real time)
+	{
+		ProfilerSpan profiler_span(typeid(*this));
+		for (SPHBody* body : bodies_)
+		{
+			if (body->checkNewlyUpdated())
+			{
+				std::shared_ptr<VtuFileWriter> snapshot = std::make_shared<VtuFileWriter>();
+				std::string body_name = body->GetBodyName();
 				size_t number_of_particles = body->number_of_particles_;
-				out_file << "  <Piece Name =\"" << body->GetBodyName() << "\" NumberOfPoints=\"" << number_of_particles << "\" NumberOfCells=\"0\">\n";
-
-				body->writeParticlesToVtuFile(out_file);
-
-				out_file << "   </PointData>\n";
-
-				//write empty cells
-				out_file << "   <Cells>\n";
-				out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
-				out_file << "    </DataArray>\n";
-				out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
-				out_file << "    </DataArray>\n";
-				out_file << "    <DataArray type=\"types\"  Name=\"offsets\"  Format=\"ascii\">\n";
-				out_file << "    </DataArray>\n";
-				out_file << "   </Cells>\n";
-
-				out_file << "  </Piece>\n";
-
-				out_file << " </UnstructuredGrid>\n";
-				out_file << "</VTKFile>\n";
+				{
+					ProfilerSpan body_profiler_span("writeParticlesToVtuFile", body);
+					if (output_filter_ != NULL) output_filter_->applyTo(*snapshot, body);
+					body->writeParticlesToVtuFile(*snapshot);
+				}
+				number_of_particles = snapshot->numberOfOutputPoints(number_of_particles);
 
-				out_file.close();
+				std::shared_ptr<ParticleContainerWriter> container = container_;
+				in_output_.output_pipeline_.push([container, snapshot, body_name, time, number_of_particles]() {
+					ProfilerSpan record_profiler_span("ParticleContainerWriter::writeRecord", NULL, number_of_particles);
+					container->writeRecord(body_name, time, number_of_particles, *snapshot);
+					});
 			}
 			body->setNotNewlyUpdated();
 		}
@@ -78,6 +98,7 @@ namespace SPH
 	//=============================================================================================//
 	void WriteBodyStatesToPlt::WriteToFile(Real time)
 	{
+		ProfilerSpan profiler_span(typeid(*this));
 		int Itime = int(time * 1.0e4);
 
 		for (SPHBody* body : bodies_)
@@ -93,7 +114,10 @@ namespace SPH
 
 				//begin of the plt file writing
 
-				body->writeParticlesToPltFile(out_file);
+				{
+					ProfilerSpan body_profiler_span("writeParticlesToPltFile", body);
+					body->writeParticlesToPltFile(out_file);
+				}
 
 				out_file.close();
 			}
@@ -121,6 +145,7 @@ namespace SPH
 
 		if (out_of_bound_) {
 			WriteBodyStatesToVtu::WriteToFile(time);
+			in_output_.output_pipeline_.flush();
 			cout << "\n Velocity is out of bound at physical time " << GlobalStaticVariables::physical_time_
 				<< "\n The body states have been outputted and the simulation terminates here. \n";
 		}
@@ -142,24 +167,20 @@ namespace SPH
 	//=================================================================================================//
 	WriteTotalMechanicalEnergy
 		::WriteTotalMechanicalEnergy(In_Output& in_output, FluidBody* water_block, Gravity* gravity)
-		: WriteBodyStates(in_output, water_block), TotalMechanicalEnergy(water_block, gravity)
+		: WriteBodyStates(in_output, water_block),
+		InlinedParticleDynamicsReduce<fluid_dynamics::TotalMechanicalEnergy>(water_block, gravity)
 	{
 		filefullpath_ = in_output_.output_folder_ + "/" + water_block->GetBodyName()
 			+ "_water_mechanical_energy_" + in_output_.restart_step_ + ".dat";
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << "\"run_time\"" << "   ";
-		out_file << water_block->GetBodyName() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.openFile(filefullpath_, { "\"run_time\"", water_block->GetBodyName() },
+			in_output_.time_series_format_);
 	};
 	//=============================================================================================//
 	void WriteTotalMechanicalEnergy::WriteToFile(Real time)
 	{
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << time << "   ";
-		out_file << parallel_exec() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.newRow(time);
+		time_series_file_.addValue(parallel_exec());
+		time_series_file_.endRow();
 	};
 	//=================================================================================================//
 	WriteMaximumSpeed
@@ -168,20 +189,15 @@ namespace SPH
 	{
 		filefullpath_ = in_output_.output_folder_ + "/" + sph_body->GetBodyName()
 			+ "_maximum_speed_" + in_output_.restart_step_ + ".dat";
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << "\"run_time\"" << "   ";
-		out_file << sph_body->GetBodyName() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.openFile(filefullpath_, { "\"run_time\"", sph_body->GetBodyName() },
+			in_output_.time_series_format_);
 	};
 	//=============================================================================================//
 	void WriteMaximumSpeed::WriteToFile(Real time)
 	{
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << time << "   ";
-		out_file << parallel_exec() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.newRow(time);
+		time_series_file_.addValue(parallel_exec());
+		time_series_file_.endRow();
 	};
 	//=============================================================================================//
 	WriteTotalViscousForceOnSolid
@@ -192,24 +208,19 @@ namespace SPH
 		dimension_ = zero.size();
 
 		filefullpath_ = in_output_.output_folder_ + "/total_viscous_force_on_" + solid_body->GetBodyName() + ".dat";
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << "\"run_time\"" << "   ";
+		StdVec<std::string> column_names = { "\"run_time\"" };
 		for (int i = 0; i != dimension_; ++i)
-			out_file << "\"total_force[" << i << "]\"" << "   ";
-		out_file << "\n";
-		out_file.close();
+			column_names.push_back("\"total_force[" + std::to_string(i) + "]\"");
+		time_series_file_.openFile(filefullpath_, column_names, in_output_.time_series_format_);
 	}
 	//=============================================================================================//
 	void WriteTotalViscousForceOnSolid::WriteToFile(Real time)
 	{
 		Vecd total_force = parallel_exec();
 
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << time << "   ";
-		for (int i = 0; i < dimension_; ++i)
-			out_file << total_force[i] << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.newRow(time);
+		time_series_file_.addValue(total_force);
+		time_series_file_.endRow();
 	};
 	//=============================================================================================//
 	WriteTotalForceOnSolid
@@ -221,24 +232,19 @@ namespace SPH
 
 		filefullpath_ = in_output_.output_folder_ + "/total_force_on_" + solid_body->GetBodyName()
 			+ "_" + in_output_.restart_step_ + ".dat";
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << "\"run_time\"" << "   ";
+		StdVec<std::string> column_names = { "\"run_time\"" };
 		for (int i = 0; i < dimension_; ++i)
-			out_file << "\"total_force[" << i << "]\"" << "   ";
-		out_file << "\n";
-		out_file.close();
+			column_names.push_back("\"total_force[" + std::to_string(i) + "]\"");
+		time_series_file_.openFile(filefullpath_, column_names, in_output_.time_series_format_);
 	}
 	//=============================================================================================//
 	void WriteTotalForceOnSolid::WriteToFile(Real time)
 	{
 		Vecd total_force = parallel_exec();
 
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << time << "   ";
-		for (int i = 0; i < dimension_; ++i)
-			out_file << total_force[i] << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.newRow(time);
+		time_series_file_.addValue(total_force);
+		time_series_file_.endRow();
 	};
 	//=============================================================================================//
 	WriteUpperFrontInXDirection
@@ -247,32 +253,38 @@ namespace SPH
 	{
 		filefullpath_ = in_output_.output_folder_ + "/" + body->GetBodyName()
 			+ "_upper_bound_in_x_direction_" + in_output_.restart_step_ + ".dat";
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << "\"run_time\"" << "   ";
-		out_file << body->GetBodyName() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.openFile(filefullpath_, { "\"run_time\"", body->GetBodyName() },
+			in_output_.time_series_format_);
 	};
 	//=============================================================================================//
 	void WriteUpperFrontInXDirection::WriteToFile(Real time)
 	{
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << time << "   ";
-		out_file << parallel_exec() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.newRow(time);
+		time_series_file_.addValue(parallel_exec());
+		time_series_file_.endRow();
 	};
 	//=============================================================================================//
-	ReloadParticleIO::ReloadParticleIO(In_Output& in_output, SPHBodyVector bodies)
+	ReloadParticleIO::ReloadParticleIO(In_Output& in_output, SPHBodyVector bodies, RestartFormat reload_format)
+		: reload_format_(reload_format)
 	{
+		file_extension_ = reload_format_ == RestartFormat::binary ? "_rld.bin" : "_rld.xml";
 		for (SPHBody* body : bodies)
 		{
-			file_paths_.push_back(in_output.reload_folder_ + "/SPHBody_" + body->GetBodyName() + "_rld.xml");
+			file_paths_.push_back(in_output.reload_folder_ + "/SPHBody_" + body->GetBodyName() + file_extension_);
 		}
 	}
 	//=============================================================================================//
-	WriteReloadParticle::WriteReloadParticle(In_Output& in_output, SPHBodyVector bodies)
-		: ReloadParticleIO(in_output, bodies), WriteBodyStates(in_output, bodies)
+	std::string ReloadParticleIO::reloadKey(SPHBody* body)
+	{
+		uint64_t shape_hash = body->body_shape_ != NULL ? body->body_shape_->computeShapeHash() : 0;
+		std::stringstream key;
+		key << "particle_spacing=" << std::setprecision(17) << body->particle_spacing_
+			<< ";shape_hash=" << std::hex << shape_hash;
+		return key.str();
+	}
+	//=============================================================================================//
+	WriteReloadParticle::WriteReloadParticle(In_Output& in_output, SPHBodyVector bodies, RestartFormat reload_format)
+		: ReloadParticleIO(in_output, bodies, reload_format), WriteBodyStates(in_output, bodies)
 	{
 		if (!fs::exists(in_output.reload_folder_))
 		{
@@ -280,16 +292,17 @@ namespace SPH
 		}
 	};
 	WriteReloadParticle::WriteReloadParticle(In_Output& in_output, SPHBodyVector bodies,
-		StdVec<string> given_body_names) : WriteReloadParticle(in_output, bodies)
+		StdVec<string> given_body_names, RestartFormat reload_format) : WriteReloadParticle(in_output, bodies, reload_format)
 	{
 		for (size_t i = 0; i != bodies.size(); ++i)
 		{
-			file_paths_[i] = in_output.reload_folder_ + "/SPHBody_" + given_body_names[i] + "_rld.xml";
+			file_paths_[i] = in_output.reload_folder_ + "/SPHBody_" + given_body_names[i] + file_extension_;
 		}
 	}
 	//=============================================================================================//
 	void WriteReloadParticle::WriteToFile(Real time)
 	{
+		ProfilerSpan profiler_span(typeid(*this));
 		std::string reload_particle_folder = in_output_.reload_folder_;
 		if (!fs::exists(reload_particle_folder))
 		{
@@ -304,20 +317,21 @@ namespace SPH
 			{
 				fs::remove(filefullpath);
 			}
-			bodies_[i]->writeToXmlForReloadParticle(filefullpath);
+			if (reload_format_ == RestartFormat::binary)
+			{
+				bodies_[i]->writeToBinaryForReloadParticle(filefullpath, reloadKey(bodies_[i]));
+			}
+			else
+			{
+				bodies_[i]->writeToXmlForReloadParticle(filefullpath);
+			}
 		}
 	}
 	//=============================================================================================//
-	ReadReloadParticle::ReadReloadParticle(In_Output& in_output, SPHBodyVector bodies, StdVec<std::string> reload_body_names)
-		: ReloadParticleIO(in_output, bodies), ReadBodyStates(in_output, bodies)
+	ReadReloadParticle::ReadReloadParticle(In_Output& in_output, SPHBodyVector bodies,
+		StdVec<std::string> reload_body_names, RestartFormat reload_format)
+		: ReloadParticleIO(in_output, bodies, reload_format), ReadBodyStates(in_output, bodies)
 	{
-		if (!fs::exists(in_output.reload_folder_))
-		{
-			std::cout << "\n Error: the particle reload folder:" << in_output.reload_folder_ << " is not exists" << std::endl;
-			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-			exit(1);
-		}
-
 		if (bodies.size() != reload_body_names.size())
 		{
 			std::cout << "\n Error: reload bodies boes not match" << std::endl;
@@ -326,9 +340,29 @@ namespace SPH
 		}
 	}
 	//=============================================================================================//
+	bool ReadReloadParticle::checkReloadFiles()
+	{
+		for (size_t i = 0; i < bodies_.size(); ++i)
+		{
+			if (!fs::exists(file_paths_[i])) return false;
+			std::string key;
+			if (reload_format_ == RestartFormat::binary
+				&& (!BinaryRestartReader::probeKey(file_paths_[i], key) || key != reloadKey(bodies_[i])))
+				return false;
+		}
+		return true;
+	}
+	//=============================================================================================//
 	void ReadReloadParticle::ReadFromFile(size_t restart_step)
 	{
 		std::cout << "\n Reloading particles from files." << std::endl;
+		if (!fs::exists(in_output_.reload_folder_))
+		{
+			std::cout << "\n Error: the particle reload folder:" << in_output_.reload_folder_ << " is not exists" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
 		for (size_t i = 0; i < bodies_.size(); ++i)
 		{
 			std::string filefullpath = file_paths_[i];
@@ -340,12 +374,21 @@ namespace SPH
 				exit(1);
 			}
 
-			bodies_[i]->readFromXmlForReloadParticle(filefullpath);
+			if (reload_format_ == RestartFormat::binary)
+			{
+				bodies_[i]->readFromBinaryForReloadParticle(filefullpath, reloadKey(bodies_[i]));
+			}
+			else
+			{
+				bodies_[i]->readFromXmlForReloadParticle(filefullpath);
+			}
 		}
 	}
 	//=============================================================================================//
-	RestartIO::RestartIO(In_Output& in_output, SPHBodyVector bodies)
+	RestartIO::RestartIO(In_Output& in_output, SPHBodyVector bodies, RestartFormat restart_format)
+		: restart_format_(restart_format)
 	{
+		file_extension_ = restart_format_ == RestartFormat::binary ? ".bin" : ".xml";
 		overall_file_path_ = in_output.restart_folder_ + "/Restart_time_";
 		for (SPHBody* body : bodies)
 		{
@@ -355,6 +398,7 @@ namespace SPH
 	//=============================================================================================//
 	void WriteRestart::WriteToFile(Real time)
 	{
+		ProfilerSpan profiler_span(typeid(*this));
 		int Itime = int(time);
 		std::string overall_filefullpath = overall_file_path_ + std::to_string(Itime) + ".dat";
 		if (fs::exists(overall_filefullpath))
@@ -367,13 +411,20 @@ namespace SPH
 
 		for (size_t i = 0; i < bodies_.size(); ++i)
 		{
-			std::string filefullpath = file_paths_[i] + std::to_string(Itime) + ".xml";
+			std::string filefullpath = file_paths_[i] + std::to_string(Itime) + file_extension_;
 
 			if (fs::exists(filefullpath))
 			{
 				fs::remove(filefullpath);
 			}
-			bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
+			if (restart_format_ == RestartFormat::binary)
+			{
+				bodies_[i]->writeParticlesToBinaryForRestart(filefullpath, GlobalStaticVariables::physical_time_);
+			}
+			else
+			{
+				bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
+			}
 		}
 	}
 	//=============================================================================================//
@@ -399,7 +450,7 @@ namespace SPH
 	{
 		for (size_t i = 0; i < bodies_.size(); ++i)
 		{
-			std::string filefullpath = file_paths_[i] + std::to_string(restart_step) + ".xml";
+			std::string filefullpath = file_paths_[i] + std::to_string(restart_step) + file_extension_;
 
 			if (!fs::exists(filefullpath))
 			{
@@ -408,7 +459,14 @@ namespace SPH
 				exit(1);
 			}
 
-			bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+			if (restart_format_ == RestartFormat::binary)
+			{
+				bodies_[i]->readParticlesFromBinaryForRestart(filefullpath);
+			}
+			else
+			{
+				bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+			}
 		}
 	}
 	//=============================================================================================//
@@ -416,26 +474,17 @@ namespace SPH
 		: WriteSimBodyStates<SimTK::MobilizedBody::Pin>(in_output, integ, pinbody)
 	{
 		filefullpath_ = in_output_.output_folder_ + "/mb_pinbody_data.dat";
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-
-		out_file << "\"time\"" << "   ";
-		out_file << "  " << "angles" << " ";
-		out_file << "  " << "angle_rates" << " ";
-		out_file << "\n";
-
-		out_file.close();
+		time_series_file_.openFile(filefullpath_, { "\"time\"", "angles", "angle_rates" },
+			in_output_.time_series_format_);
 	};
 	//=============================================================================================//
 	void WriteSimBodyPinData::WriteToFile(Real time)
 	{
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << time << "   ";
 		const SimTK::State& state = integ_.getState();
-
-		out_file << "  " << mobody_.getAngle(state) << "  " << mobody_.getRate(state) << "  ";
-
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.newRow(time);
+		time_series_file_.addValue(mobody_.getAngle(state));
+		time_series_file_.addValue(mobody_.getRate(state));
+		time_series_file_.endRow();
 	};
 	//=================================================================================================//
 	ReloadMaterialPropertyIO::ReloadMaterialPropertyIO(In_Output& in_output, BaseMaterial* material)
@@ -482,20 +531,15 @@ namespace SPH
 		: WriteBodyStates(in_output, water_block), FreeSurfaceProbeOnFluidBody(water_block, body_part)
 	{
 		filefullpath_ = in_output_.output_folder_ + "/" + body_part->BodyPartName() + ".dat";
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << "\"run_time\"" << "   ";
-		out_file << body_part->BodyPartName() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.openFile(filefullpath_, { "\"run_time\"", body_part->BodyPartName() },
+			in_output_.time_series_format_);
 	};
 	//=============================================================================================//
 	void WriteFreeSurfaceElevation::WriteToFile(Real time)
 	{
-		std::ofstream out_file(filefullpath_.c_str(), ios::app);
-		out_file << time << "   ";
-		out_file << parallel_exec() << "   ";
-		out_file << "\n";
-		out_file.close();
+		time_series_file_.newRow(time);
+		time_series_file_.addValue(parallel_exec());
+		time_series_file_.endRow();
 	};
 	//=================================================================================================//
 }
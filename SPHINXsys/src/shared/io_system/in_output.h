@@ -33,12 +33,19 @@
 #include "base_data_package.h"
 #include "sph_data_conainers.h"
 #include "all_physical_dynamics.h"
+#include "vtu_file_writer.h"
+#include "output_pipeline.h"
+#include "binary_restart_file.h"
+#include "time_series_file.h"
+#include "particle_container_file.h"
+#include "output_filter.h"
  
 #include "SimTKcommon.h"
 #include "SimTKmath.h"
 #include "Simbody.h"
 
 #include <fstream>
+#include <memory>
 /** Macro for APPLE compilers*/
 #ifdef __APPLE__
 #include <boost/filesystem.hpp>
@@ -59,6 +66,11 @@ namespace SPH {
 	 * @class In_Output
 	 * @brief The base class which defines folders for output, 
 	 * restart and particle reload folders.
+	 * The output pipeline writes the body states asynchronously,
+	 * it is flushed when the in_output is destroyed at the end of the simulation.
+	 * Note that exit() does not destroy the in_output, so the snapshots still queued are dropped,
+	 * call output_pipeline_.flush() before exit() to keep them.
+	 * The time series, such as observed quantities, are buffered and written in the time series format.
 	 */
 	class In_Output
 	{
@@ -71,6 +83,8 @@ namespace SPH {
 		std::string restart_folder_;
 		std::string reload_folder_;
 		std::string restart_step_;
+		OutputPipeline output_pipeline_;
+		TimeSeriesFormat time_series_format_;
 	};
 
 	/**
@@ -176,17 +190,50 @@ namespace SPH {
 	 * @brief  Write files for bodies
 	 * the output file is VTK XML format can visualized by ParaView
 	 * the data type vtkUnstructedGrid
+	 * the data arrays are binary in the appended data section,
+	 * raw or base64 encoded and optionally compressed by zlib
+	 * the particle data is copied into a snapshot and the file is
+	 * encoded and written by the output pipeline of the in_output
+	 * the particles and the precision of the variables are selected by the output filter if given
 	 */
 	class WriteBodyStatesToVtu : public WriteBodyStates
 	{
 	public:
-		WriteBodyStatesToVtu(In_Output& in_output, SPHBodyVector bodies)
-			: WriteBodyStates(in_output, bodies) {};
+		WriteBodyStatesToVtu(In_Output& in_output, SPHBodyVector bodies,
+			VtuEncoding encoding = VtuEncoding::raw, bool compressed = false)
+			: WriteBodyStates(in_output, bodies), encoding_(encoding), compressed_(compressed),
+			output_filter_(NULL) {};
 		virtual ~WriteBodyStatesToVtu() {};
 
+		VtuEncoding encoding_;
+		bool compressed_;
+		OutputFilter* output_filter_;
+
 		virtual void WriteToFile(Real time) override;
 	};
 	
+	/**
+	 * @class WriteBodyStatesToContainer
+	 * @brief  Write the states of all bodies at all output times into one append-only
+	 * particle container of the run, SPHBodies_<restart_step>.sphc in the output folder.
+	 * Only the bodies updated since the last output are written, so that static bodies
+	 * are written once. The records are written by the output pipeline of the in_output.
+	 * The vtu files and a pvd series are exported by a ParticleContainerReader.
+	 * The particles and the precision of the variables are selected by the output filter if given.
+	 */
+	class WriteBodyStatesToContainer : public WriteBodyStates
+	{
+	protected:
+		std::shared_ptr<ParticleContainerWriter> container_;
+	public:
+		WriteBodyStatesToContainer(In_Output& in_output, SPHBodyVector bodies);
+		virtual ~WriteBodyStatesToContainer() {};
+
+		OutputFilter* output_filter_;
+
+		virtual void WriteToFile(Real time) override;
+	};
+
 	/**
 	 * @class WriteBodyStatesToPlt
 	 * @brief  Write files for bodies
@@ -205,7 +252,8 @@ namespace SPH {
 	/**
 	 * @class WriteToVtuIfVelocityOutOfBound
 	 * @brief  output body sates if particle velocity is
-	 * out of a bound
+	 * out of a bound, the output pipeline is flushed
+	 * so that all files are written before the simulation terminates
 	 */
 	class WriteToVtuIfVelocityOutOfBound
 		: public WriteBodyStatesToVtu
@@ -249,21 +297,14 @@ namespace SPH {
 	protected:
 		SPHBody* observer_;
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 
-		void writeFileHead(std::ofstream& out_file, Real& observed_quantity, string quantity_name, size_t i) {
-			out_file << "  " << quantity_name << "[" << i << "]" << " ";
-		};
-		void writeDataToFile(std::ofstream& out_file, Real& observed_quantity) {
-			out_file << "  " << observed_quantity << " ";
-		};
-
-		void writeFileHead(std::ofstream& out_file, Vecd& observed_quantity, string quantity_name, size_t i) {
-			for (int j = 0; j < observed_quantity.size(); ++j)
-				out_file << "  " << quantity_name <<"[" << i << "][" << j << "]" << " ";
+		void addColumnNames(StdVec<std::string>& column_names, Real& observed_quantity, string quantity_name, size_t i) {
+			column_names.push_back(quantity_name + "[" + std::to_string(i) + "]");
 		};
-		void writeDataToFile(std::ofstream& out_file, Vecd& observed_quantity) {
+		void addColumnNames(StdVec<std::string>& column_names, Vecd& observed_quantity, string quantity_name, size_t i) {
 			for (int j = 0; j < observed_quantity.size(); ++j)
-				out_file << "  " << observed_quantity[j] << " ";
+				column_names.push_back(quantity_name + "[" + std::to_string(i) + "][" + std::to_string(j) + "]");
 		};
 
 	public:
@@ -274,28 +315,24 @@ namespace SPH {
 		{
 			filefullpath_ = in_output_.output_folder_ + "/" + observer_->GetBodyName()
 				+ "_" + quantity_name + "_" + in_output_.restart_step_ + ".dat";
-			std::ofstream out_file(filefullpath_.c_str(), ios::app);
-			out_file << "run_time" << "   ";
+			StdVec<std::string> column_names = { "run_time" };
 			for (size_t i = 0; i != observer_->number_of_particles_; ++i)
 			{
-				writeFileHead(out_file, this->observed_quantities_[i], quantity_name, i);
+				addColumnNames(column_names, this->observed_quantities_[i], quantity_name, i);
 			}
-			out_file << "\n";
-			out_file.close();
+			time_series_file_.openFile(filefullpath_, column_names, in_output_.time_series_format_);
 		};
 		virtual ~WriteAnObservedQuantity() {};
 
 		virtual void WriteToFile(Real time = 0.0) override 
 		{
 			this->parallel_exec();
-			std::ofstream out_file(filefullpath_.c_str(), ios::app);
-			out_file << time << "   ";
+			time_series_file_.newRow(time);
 			for (size_t i = 0; i != observer_->number_of_particles_; ++i)
 			{
-				writeDataToFile(out_file, this->observed_quantities_[i]);
+				time_series_file_.addValue(this->observed_quantities_[i]);
 			}
-			out_file << "\n";
-			out_file.close();
+			time_series_file_.endRow();
 		};
 	};
 
@@ -311,6 +348,7 @@ namespace SPH {
 	protected:
 		SPHBody* observer_;
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		/** Constructor and Destructor. */
 		WriteObservedDiffusionReactionQuantity(string species_name, In_Output& in_output, SPHBodyContactRelation* body_contact_relation)
@@ -320,14 +358,12 @@ namespace SPH {
 		{
 			filefullpath_ = in_output_.output_folder_ + "/" + observer_->GetBodyName()
 				+ "_" + species_name + "_" + in_output_.restart_step_ + ".dat";
-			std::ofstream out_file(filefullpath_.c_str(), ios::app);
-			out_file << "run_time" << "   ";
+			StdVec<std::string> column_names = { "run_time" };
 			for (size_t i = 0; i != observer_->number_of_particles_; ++i)
 			{
-				out_file << "  " << species_name << "[" << i << "]" << " ";
+				column_names.push_back(species_name + "[" + std::to_string(i) + "]");
 			}
-			out_file << "\n";
-			out_file.close();
+			time_series_file_.openFile(filefullpath_, column_names, in_output_.time_series_format_);
 		};
 
 		virtual ~WriteObservedDiffusionReactionQuantity() {};
@@ -338,14 +374,12 @@ namespace SPH {
 		virtual void WriteToFile(Real time) override 
 		{
 			this->parallel_exec();
-			std::ofstream out_file(filefullpath_.c_str(), ios::app);
-			out_file << time << "   ";
+			time_series_file_.newRow(time);
 			for (size_t i = 0; i != observer_->number_of_particles_; ++i)
 			{
-				out_file << "  " << this->observed_quantities_[i] << " ";
+				time_series_file_.addValue(this->observed_quantities_[i]);
 			}
-			out_file << "\n";
-			out_file.close();
+			time_series_file_.endRow();
 		};
 	};
 
@@ -354,10 +388,11 @@ namespace SPH {
 	 * @brief write files for the total mechanical energy of a weakly compressible fluid body
 	 */
 	class WriteTotalMechanicalEnergy 
-		: public WriteBodyStates, public fluid_dynamics::TotalMechanicalEnergy
+		: public WriteBodyStates, public InlinedParticleDynamicsReduce<fluid_dynamics::TotalMechanicalEnergy>
 	{
 	protected:
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		WriteTotalMechanicalEnergy(In_Output& in_output, FluidBody* water_block, Gravity* gravity);
 		virtual ~WriteTotalMechanicalEnergy() {};
@@ -372,6 +407,7 @@ namespace SPH {
 	{
 	protected:
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		WriteMaximumSpeed(In_Output& in_output, SPHBody* sph_body);
 		virtual ~WriteMaximumSpeed() {};
@@ -388,6 +424,7 @@ namespace SPH {
 	protected:
 		int dimension_;
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		WriteTotalViscousForceOnSolid(In_Output& in_output, SolidBody *solid_body);
 		virtual ~WriteTotalViscousForceOnSolid() {};
@@ -404,6 +441,7 @@ namespace SPH {
 	protected:
 		int dimension_;
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		WriteTotalForceOnSolid(In_Output& in_output, SolidBody *solid_body);
 		virtual ~WriteTotalForceOnSolid() {};
@@ -419,6 +457,7 @@ namespace SPH {
 	{
 	protected:
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		WriteUpperFrontInXDirection(In_Output& in_output, SPHBody* body);
 		virtual ~WriteUpperFrontInXDirection() {};
@@ -428,26 +467,34 @@ namespace SPH {
 	/**
 	 * @class ReloadParticleIO
 	 * @brief For write  and read particle reload.
+	 * The binary reload files have a key of the particle spacing and the shape of the body,
+	 * so that the relaxed particles are only reloaded for the same resolution and geometry.
 	 */
 	class ReloadParticleIO
 	{
 	protected:
+		RestartFormat reload_format_;
+		std::string file_extension_;
 		StdVec<std::string> file_paths_;
 
+		/** the key of the particle spacing and the hash of the body shape */
+		std::string reloadKey(SPHBody* body);
 	public:
-		ReloadParticleIO(In_Output& in_output, SPHBodyVector bodies);
+		ReloadParticleIO(In_Output& in_output, SPHBodyVector bodies, RestartFormat reload_format);
 		virtual ~ReloadParticleIO() {};
 	};
 
 	/**
 	  * @class WriteReloadParticle
-	  * @brief Write the reload particles file in XML format.
+	  * @brief Write the reload particles file in binary or XML format.
 	  */
 	class WriteReloadParticle : public ReloadParticleIO, public WriteBodyStates
 	{
 	public:
-		WriteReloadParticle(In_Output& in_output, SPHBodyVector bodies);
-		WriteReloadParticle(In_Output& in_output, SPHBodyVector bodies, StdVec<string> given_body_names);
+		WriteReloadParticle(In_Output& in_output, SPHBodyVector bodies,
+			RestartFormat reload_format = RestartFormat::binary);
+		WriteReloadParticle(In_Output& in_output, SPHBodyVector bodies, StdVec<string> given_body_names,
+			RestartFormat reload_format = RestartFormat::binary);
 		virtual ~WriteReloadParticle() {};
 
 		virtual void WriteToFile(Real time = 0.0) override;
@@ -455,57 +502,64 @@ namespace SPH {
 
 	/**
 	  * @class ReadReloadParticle
-	  * @brief Write the reload particles file in XML format.
+	  * @brief Read the reload particles file in binary or XML format.
 	  */
 	class ReadReloadParticle : public ReloadParticleIO, public ReadBodyStates
 	{
 	public:
-		ReadReloadParticle(In_Output& in_output, SPHBodyVector bodies, StdVec<std::string> reload_body_names);
+		ReadReloadParticle(In_Output& in_output, SPHBodyVector bodies, StdVec<std::string> reload_body_names,
+			RestartFormat reload_format = RestartFormat::binary);
 		virtual ~ReadReloadParticle() { };
 
+		/** true if the reload files exist and, for binary files, were written for the present resolution and shapes,
+		 *  so that the particle relaxation can be skipped. */
+		bool checkReloadFiles();
 		virtual void ReadFromFile(size_t iteration_step = 0) override;
 	};
 
 	/**
 	 * @class RestartIO
-	 * @brief Write the restart file in XML format.
+	 * @brief The restart files in binary format, or in XML format for exporting.
+	 * The binary files have all registered particle data and the physical time.
 	 */
 	class RestartIO
 	{
 	protected:
+		RestartFormat restart_format_;
 		std::string overall_file_path_;
 		StdVec<std::string> file_paths_;
+		std::string file_extension_;
 
 	public:
-		RestartIO(In_Output& in_output, SPHBodyVector bodies);
+		RestartIO(In_Output& in_output, SPHBodyVector bodies, RestartFormat restart_format);
 		virtual ~RestartIO() {};
 	};
 
 	/**
 	 * @class WriteRestart
-	 * @brief Write the restart file in XML format.
+	 * @brief Write the restart files.
 	 */
 	class WriteRestart : public RestartIO, public WriteBodyStates
 	{
 	public:
-		WriteRestart(In_Output& in_output, SPHBodyVector bodies)
-			: RestartIO(in_output, bodies), WriteBodyStates(in_output, bodies) {};
+		WriteRestart(In_Output& in_output, SPHBodyVector bodies, RestartFormat restart_format = RestartFormat::binary)
+			: RestartIO(in_output, bodies, restart_format), WriteBodyStates(in_output, bodies) {};
 		virtual ~WriteRestart() {};
 
 		virtual void WriteToFile(Real time = 0.0) override;
 	};
 
 	/**
-	 * @class WriteRestart
-	 * @brief Write the restart file in XML format.
+	 * @class ReadRestart
+	 * @brief Read the restart files.
 	 */
 	class ReadRestart : public RestartIO, public ReadBodyStates
 	{
 	protected:
 		Real ReadRestartTime(size_t restart_step);
 	public:
-		ReadRestart(In_Output& in_output, SPHBodyVector bodies)
-			: RestartIO(in_output, bodies), ReadBodyStates(in_output, bodies) {};
+		ReadRestart(In_Output& in_output, SPHBodyVector bodies, RestartFormat restart_format = RestartFormat::binary)
+			: RestartIO(in_output, bodies, restart_format), ReadBodyStates(in_output, bodies) {};
 		virtual ~ReadRestart() {};
 		virtual Real ReadRestartFiles(size_t restart_step) {
 			ReadFromFile(restart_step);
@@ -522,6 +576,7 @@ namespace SPH {
 	{
 	protected:
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		WriteSimBodyPinData(In_Output& in_output, SimTK::RungeKuttaMersonIntegrator& integ, SimTK::MobilizedBody::Pin& pinbody);
 		virtual ~WriteSimBodyPinData() {};
@@ -631,6 +686,7 @@ namespace SPH {
 	{
 	protected:
 		std::string filefullpath_;
+		TimeSeriesFile time_series_file_;
 	public:
 		WriteFreeSurfaceElevation(In_Output& in_output, FluidBody* water_block, BodyPartByCell* body_part);
 		virtual ~WriteFreeSurfaceElevation() {};
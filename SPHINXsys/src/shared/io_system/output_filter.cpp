@@ -0,0 +1,125 @@
+/**
+ * @file 	output_filter.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "output_filter.h"
+#include "base_body.h"
+#include "base_particles.h"
+
+#include <cstdint>
+#include <algorithm>
+
+namespace SPH
+{
+	namespace
+	{
+		/** a uniform random number in [0, 1) given by the particle index */
+		Real particleRandomNumber(size_t particle_index)
+		{
+			uint64_t z = uint64_t(particle_index) + 0x9E3779B97F4A7C15ull;
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			z = z ^ (z >> 31);
+			return Real(z >> 11) * (1.0 / 9007199254740992.0);
+		}
+	}
+	//=================================================================================================//
+	OutputFilter::OutputFilter()
+		: stride_(1), random_fraction_(1.0), free_surface_only_(false), free_surface_threshold_(0.0) {}
+	//=================================================================================================//
+	void OutputFilter::addBox(Vecd lower_bound, Vecd upper_bound)
+	{
+		boxes_.push_back(std::make_pair(lower_bound, upper_bound));
+	}
+	//=================================================================================================//
+	void OutputFilter::addBodyPart(BodyPart* body_part)
+	{
+		if (body_part->getBodyPartShape() == NULL)
+		{
+			std::cout << "\n Error: the body part " << body_part->BodyPartName()
+				<< " has no shape for the output filter." << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		body_parts_.push_back(body_part);
+	}
+	//=================================================================================================//
+	void OutputFilter::setFreeSurfaceOnly(Real free_surface_threshold)
+	{
+		free_surface_only_ = true;
+		Vecd zero(0);
+		free_surface_threshold_ = free_surface_threshold < 0.0 ? 0.75 * Real(zero.size()) : free_surface_threshold;
+	}
+	//=================================================================================================//
+	void OutputFilter::setPrecision(const std::string& variable_name, OutputPrecision precision)
+	{
+		StdVec<std::string>::iterator found =
+			std::find(half_precision_variables_.begin(), half_precision_variables_.end(), variable_name);
+		if (precision == OutputPrecision::float16 && found == half_precision_variables_.end())
+			half_precision_variables_.push_back(variable_name);
+		if (precision == OutputPrecision::float32 && found != half_precision_variables_.end())
+			half_precision_variables_.erase(found);
+	}
+	//=================================================================================================//
+	void OutputFilter::applyTo(VtuFileWriter& vtu_file, SPHBody* body)
+	{
+		vtu_file.setHalfPrecisionVariables(half_precision_variables_);
+		if (boxes_.empty() && body_parts_.empty() && stride_ == 1 && random_fraction_ >= 1.0 && !free_surface_only_)
+			return;
+
+		BaseParticles* base_particles = body->base_particles_;
+		StdLargeVec<Vecd>& pos_n = base_particles->pos_n_;
+		StdLargeVec<size_t>& unsorted_id = base_particles->unsorted_id_;
+		StdLargeVec<Real>* pos_div = NULL;
+		if (free_surface_only_)
+		{
+			if (base_particles->scalars_map_.find("PositionDivergence") == base_particles->scalars_map_.end())
+			{
+				std::cout << "\n Error: the body " << body->GetBodyName()
+					<< " has no PositionDivergence for the free surface output filter." << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			pos_div = base_particles->registered_scalars_[base_particles->scalars_map_["PositionDivergence"]];
+		}
+
+		size_t number_of_particles = body->number_of_particles_;
+		StdLargeVec<char> is_selected(number_of_particles, 0);
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					size_t particle_id = unsorted_id[i];
+					if (particle_id % stride_ != 0) continue;
+					if (random_fraction_ < 1.0 && particleRandomNumber(particle_id) >= random_fraction_) continue;
+					if (pos_div != NULL && (*pos_div)[i] >= free_surface_threshold_) continue;
+
+					bool is_in_region = boxes_.empty() && body_parts_.empty();
+					for (size_t l = 0; l != boxes_.size() && !is_in_region; ++l)
+					{
+						is_in_region = true;
+						for (int k = 0; k < pos_n[i].size(); ++k)
+						{
+							if (pos_n[i][k] < boxes_[l].first[k] || pos_n[i][k] > boxes_[l].second[k])
+								is_in_region = false;
+						}
+					}
+					for (size_t l = 0; l != body_parts_.size() && !is_in_region; ++l)
+					{
+						is_in_region = body_parts_[l]->getBodyPartShape()->checkContain(pos_n[i]);
+					}
+					is_selected[i] = is_in_region ? 1 : 0;
+				}
+			}, ap);
+
+		StdVec<size_t> selected_particles;
+		for (size_t i = 0; i != number_of_particles; ++i)
+		{
+			if (is_selected[i] != 0) selected_particles.push_back(i);
+		}
+		vtu_file.setParticleSelection(selected_particles);
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,61 @@
+/**
+ * @file 	output_filter.h
+ * @brief 	The filters of the particles and the precision of the variables
+ *			written by a body states writer.
+ * @details The particles are selected by spatial boxes or body part shapes,
+ *			by stride or random decimation and by the free surface indicated
+ *			by the position divergence of RegularFreeSurfaceIndication.
+ *			The decimation uses the unsorted particle index, so that the same particles
+ *			are written at all output times. The selection is given to the vtu snapshot,
+ *			which only converts the selected particles.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+#include "vtu_file_writer.h"
+
+#include <string>
+#include <utility>
+
+namespace SPH
+{
+	class SPHBody;
+	class BodyPart;
+
+	/** The precision of a written variable. The half precision values are written as Float32. */
+	enum class OutputPrecision { float16, float32 };
+
+	/**
+	 * @class OutputFilter
+	 * @brief A particle is written if it is in one of the boxes or body parts, all particles if there is none,
+	 * if it is at the free surface when only the free surface is written and if it is not decimated.
+	 */
+	class OutputFilter
+	{
+	public:
+		OutputFilter();
+		virtual ~OutputFilter() {};
+
+		void addBox(Vecd lower_bound, Vecd upper_bound);
+		void addBodyPart(BodyPart* body_part);
+		/** write every stride-th particle */
+		void setStride(size_t stride) { stride_ = SMAX(stride, size_t(1)); };
+		/** write a random fraction of the particles */
+		void setRandomFraction(Real random_fraction) { random_fraction_ = random_fraction; };
+		/** write only the particles with a position divergence below the threshold,
+		 *  the default threshold is 0.75 of the position divergence within the fluid */
+		void setFreeSurfaceOnly(Real free_surface_threshold = -1.0);
+		void setPrecision(const std::string& variable_name, OutputPrecision precision);
+		/** set the selected particles of the body and the precision of the variables to the snapshot */
+		void applyTo(VtuFileWriter& vtu_file, SPHBody* body);
+	protected:
+		StdVec<std::pair<Vecd, Vecd>> boxes_;
+		StdVec<BodyPart*> body_parts_;
+		size_t stride_;
+		Real random_fraction_;
+		bool free_surface_only_;
+		Real free_surface_threshold_;
+		StdVec<std::string> half_precision_variables_;
+	};
+}
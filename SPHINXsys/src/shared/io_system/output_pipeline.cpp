@@ -0,0 +1,50 @@
+/**
+ * @file 	output_pipeline.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "output_pipeline.h"
+
+namespace SPH
+{
+	//=================================================================================================//
+	OutputPipeline::OutputPipeline(size_t capacity)
+	{
+		setCapacity(capacity);
+	}
+	//=================================================================================================//
+	OutputPipeline::~OutputPipeline()
+	{
+		flush();
+	}
+	//=================================================================================================//
+	void OutputPipeline::setCapacity(size_t capacity)
+	{
+		tasks_.set_capacity(SMAX(capacity, size_t(1)));
+	}
+	//=================================================================================================//
+	void OutputPipeline::push(const std::function<void()>& task)
+	{
+		if (!task) return;
+		if (!background_thread_.joinable())
+		{
+			background_thread_ = std::thread([this]() {
+				std::function<void()> task;
+				/** an empty task stops the thread */
+				for (tasks_.pop(task); task; tasks_.pop(task)) task();
+				});
+		}
+		tasks_.push(task);
+	}
+	//=================================================================================================//
+	void OutputPipeline::flush()
+	{
+		if (background_thread_.joinable())
+		{
+			tasks_.push(std::function<void()>());
+			background_thread_.join();
+		}
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,44 @@
+/**
+ * @file 	output_pipeline.h
+ * @brief 	The asynchronous writing of output files by a background thread.
+ * @details The output tasks, which own snapshots of the data to be written, are pushed
+ *			into a bounded queue and executed in order by a background thread,
+ *			so that the simulation continues while the files are encoded and written.
+ *			When the queue is full, the push waits for the background thread (backpressure),
+ *			so that the memory of the snapshots is bounded.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+
+#include "tbb/concurrent_queue.h"
+
+#include <functional>
+#include <thread>
+
+namespace SPH
+{
+	/**
+	 * @class OutputPipeline
+	 * @brief A bounded queue of output tasks executed by a background thread.
+	 * The thread is started with the first task and stopped by flush.
+	 * The default capacity of one waiting task gives double buffering,
+	 * i.e. one snapshot is written while the next one is staged.
+	 */
+	class OutputPipeline
+	{
+	public:
+		explicit OutputPipeline(size_t capacity = 1);
+		virtual ~OutputPipeline();
+
+		/** push a task, wait if the queue is full */
+		void push(const std::function<void()>& task);
+		/** wait until all pushed tasks are executed */
+		void flush();
+		void setCapacity(size_t capacity);
+	protected:
+		concurrent_bounded_queue<std::function<void()>> tasks_;
+		std::thread background_thread_;
+	};
+}
@@ -0,0 +1,269 @@
+/**
+ * @file 	particle_container_file.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "particle_container_file.h"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+
+namespace SPH
+{
+	namespace
+	{
+		const char container_file_tag[8] = { 'S', 'P', 'H', 'P', 'C', 'F', '0', '1' };
+		const char container_record_tag[8] = { 'S', 'P', 'H', 'R', 'E', 'C', '0', '1' };
+
+		void appendValue(std::string& bytes, uint64_t value)
+		{
+			bytes.append(reinterpret_cast<const char*>(&value), sizeof(uint64_t));
+		}
+
+		void appendString(std::string& bytes, const std::string& value)
+		{
+			appendValue(bytes, value.size());
+			bytes.append(value);
+		}
+
+		size_t readValue(std::ifstream& in_file)
+		{
+			uint64_t value = 0;
+			in_file.read(reinterpret_cast<char*>(&value), sizeof(uint64_t));
+			return size_t(value);
+		}
+
+		std::string readString(std::ifstream& in_file)
+		{
+			std::string value(readValue(in_file), '\0');
+			if (!value.empty()) in_file.read(&value[0], value.size());
+			return value;
+		}
+
+		void containerFileError(const std::string& filefullpath, const std::string& message)
+		{
+			std::cout << "\n Error: the particle container " << filefullpath << " " << message << std::endl;
+			exit(1);
+		}
+	}
+	//=================================================================================================//
+	ParticleContainerWriter::ParticleContainerWriter(const std::string& filefullpath)
+		: filefullpath_(filefullpath), file_size_(0)
+	{
+		std::ifstream in_file(filefullpath.c_str(), std::ios::binary | std::ios::ate);
+		if (in_file) file_size_ = size_t(in_file.tellg());
+		in_file.close();
+
+		out_file_.open(filefullpath.c_str(), std::ios::app | std::ios::binary);
+		if (file_size_ == 0)
+		{
+			std::string header(container_file_tag, sizeof(container_file_tag));
+			appendValue(header, sizeof(Real));
+			out_file_.write(header.data(), header.size());
+			out_file_.flush();
+			file_size_ = header.size();
+		}
+	}
+	//=================================================================================================//
+	void ParticleContainerWriter::writeRecord(const std::string& body_name, Real time,
+		size_t number_of_points, VtuFileWriter& snapshot)
+	{
+		number_of_points = snapshot.numberOfOutputPoints(number_of_points);
+		StdVec<const VtuDataArray*> data_arrays = { &snapshot.getPoints() };
+		for (const VtuDataArray& data_array : snapshot.getPointData()) data_arrays.push_back(&data_array);
+
+		size_t data_size = 0;
+		for (const VtuDataArray* data_array : data_arrays) data_size += data_array->data_.size();
+
+		/** the size of the header does not depend on the offsets, which are given in the second pass */
+		std::string header;
+		size_t record_size = 0;
+		for (size_t pass = 0; pass != 2; ++pass)
+		{
+			size_t offset = file_size_ + header.size();
+			record_size = header.size() + data_size;
+			header.assign(container_record_tag, sizeof(container_record_tag));
+			appendValue(header, record_size);
+			appendString(header, body_name);
+			header.append(reinterpret_cast<const char*>(&time), sizeof(Real));
+			appendValue(header, number_of_points);
+			appendValue(header, data_arrays.size());
+			for (const VtuDataArray* data_array : data_arrays)
+			{
+				appendString(header, data_array->name_);
+				appendString(header, data_array->type_);
+				appendValue(header, data_array->number_of_components_);
+				appendValue(header, offset);
+				appendValue(header, data_array->data_.size());
+				offset += data_array->data_.size();
+			}
+		}
+
+		out_file_.write(header.data(), header.size());
+		for (const VtuDataArray* data_array : data_arrays)
+			out_file_.write(data_array->data_.data(), data_array->data_.size());
+		/** so that the complete records are available while the simulation runs */
+		out_file_.flush();
+		file_size_ += record_size;
+	}
+	//=================================================================================================//
+	ParticleContainerReader::ParticleContainerReader(const std::string& filefullpath)
+		: filefullpath_(filefullpath)
+	{
+		in_file_.open(filefullpath.c_str(), std::ios::binary | std::ios::ate);
+		if (!in_file_) containerFileError(filefullpath_, "is not exists.");
+		size_t file_size = size_t(in_file_.tellg());
+		in_file_.seekg(0);
+
+		char tag[sizeof(container_file_tag)];
+		in_file_.read(tag, sizeof(tag));
+		if (!in_file_ || std::memcmp(tag, container_file_tag, sizeof(tag)) != 0)
+			containerFileError(filefullpath_, "is not a particle container file.");
+		if (readValue(in_file_) != sizeof(Real))
+			containerFileError(filefullpath_, "was written with another floating point precision.");
+
+		size_t position = size_t(in_file_.tellg());
+		while (position < file_size)
+		{
+			in_file_.read(tag, sizeof(tag));
+			size_t record_size = readValue(in_file_);
+			if (!in_file_ || std::memcmp(tag, container_record_tag, sizeof(tag)) != 0
+				|| position + record_size > file_size)
+			{
+				std::cout << "\n Warning: the particle container " << filefullpath_
+					<< " ends with an incomplete record, which is not read." << std::endl;
+				break;
+			}
+
+			ContainerRecord record;
+			record.body_name_ = readString(in_file_);
+			in_file_.read(reinterpret_cast<char*>(&record.time_), sizeof(Real));
+			record.number_of_points_ = readValue(in_file_);
+			size_t number_of_arrays = readValue(in_file_);
+			for (size_t i = 0; i != number_of_arrays; ++i)
+			{
+				ContainerArray container_array;
+				container_array.name_ = readString(in_file_);
+				container_array.type_ = readString(in_file_);
+				container_array.number_of_components_ = readValue(in_file_);
+				container_array.offset_ = readValue(in_file_);
+				container_array.size_ = readValue(in_file_);
+				record.arrays_.push_back(container_array);
+			}
+			records_.push_back(record);
+
+			position += record_size;
+			in_file_.seekg(position);
+		}
+		in_file_.clear();
+	}
+	//=================================================================================================//
+	StdVec<std::string> ParticleContainerReader::getBodyNames()
+	{
+		StdVec<std::string> body_names;
+		for (const ContainerRecord& record : records_)
+		{
+			if (std::find(body_names.begin(), body_names.end(), record.body_name_) == body_names.end())
+				body_names.push_back(record.body_name_);
+		}
+		return body_names;
+	}
+	//=================================================================================================//
+	StdVec<Real> ParticleContainerReader::getOutputTimes()
+	{
+		StdVec<Real> output_times;
+		for (const ContainerRecord& record : records_) output_times.push_back(record.time_);
+		std::sort(output_times.begin(), output_times.end());
+		output_times.erase(std::unique(output_times.begin(), output_times.end()), output_times.end());
+		return output_times;
+	}
+	//=================================================================================================//
+	const ContainerRecord* ParticleContainerReader::findRecord(const std::string& body_name, Real time)
+	{
+		const ContainerRecord* found_record = NULL;
+		for (const ContainerRecord& record : records_)
+		{
+			if (record.body_name_ == body_name && record.time_ <= time
+				&& (found_record == NULL || record.time_ >= found_record->time_))
+				found_record = &record;
+		}
+		return found_record;
+	}
+	//=================================================================================================//
+	std::string ParticleContainerReader::readArray(const ContainerRecord& record, const std::string& variable_name)
+	{
+		for (const ContainerArray& container_array : record.arrays_)
+		{
+			if (container_array.name_ == variable_name) return readArray(container_array);
+		}
+		containerFileError(filefullpath_, "does not have the variable " + variable_name
+			+ " of the body " + record.body_name_ + ".");
+		return std::string();
+	}
+	//=================================================================================================//
+	std::string ParticleContainerReader::readArray(const ContainerArray& container_array)
+	{
+		std::string bytes(container_array.size_, '\0');
+		in_file_.seekg(container_array.offset_);
+		if (!bytes.empty()) in_file_.read(&bytes[0], bytes.size());
+		if (!in_file_) containerFileError(filefullpath_, "is truncated in the array " + container_array.name_ + ".");
+		return bytes;
+	}
+	//=================================================================================================//
+	std::string ParticleContainerReader::vtuFileName(size_t record_index)
+	{
+		return "SPHBody_" + records_[record_index].body_name_ + "_" + std::to_string(record_index) + ".vtu";
+	}
+	//=================================================================================================//
+	void ParticleContainerReader::exportToVtu(const std::string& output_folder, VtuEncoding encoding, bool compressed)
+	{
+		for (size_t l = 0; l != records_.size(); ++l)
+		{
+			const ContainerRecord& record = records_[l];
+			VtuFileWriter vtu_file(encoding, compressed);
+			for (size_t i = 0; i != record.arrays_.size(); ++i)
+			{
+				const ContainerArray& container_array = record.arrays_[i];
+				VtuDataArray data_array = { container_array.name_, container_array.type_,
+					container_array.number_of_components_, "", readArray(container_array) };
+				if (i == 0)
+				{
+					vtu_file.setPoints(data_array);
+				}
+				else
+				{
+					vtu_file.addPointData(data_array);
+				}
+			}
+			std::ofstream out_file((output_folder + "/" + vtuFileName(l)).c_str(), std::ios::trunc | std::ios::binary);
+			vtu_file.writeToFile(out_file, record.body_name_, record.number_of_points_);
+			out_file.close();
+		}
+
+		StdVec<std::string> body_names = getBodyNames();
+		std::ofstream pvd_file((output_folder + "/SPHBodies.pvd").c_str(), std::ios::trunc);
+		/** the times are written with full precision, so that close output times are distinct */
+		pvd_file << std::setprecision(std::numeric_limits<Real>::digits10 + 1);
+		pvd_file << "<?xml version=\"1.0\"?>\n";
+		pvd_file << "<VTKFile type=\"Collection\" version=\"1.0\" byte_order=\"LittleEndian\">\n";
+		pvd_file << " <Collection>\n";
+		for (Real output_time : getOutputTimes())
+		{
+			for (size_t k = 0; k != body_names.size(); ++k)
+			{
+				const ContainerRecord* record = findRecord(body_names[k], output_time);
+				if (record == NULL) continue;
+				pvd_file << "  <DataSet timestep=\"" << output_time << "\" group=\"\" part=\"" << k
+					<< "\" file=\"" << vtuFileName(record - records_.data()) << "\"/>\n";
+			}
+		}
+		pvd_file << " </Collection>\n";
+		pvd_file << "</VTKFile>\n";
+		pvd_file.close();
+	}
+	//=================================================================================================//
+}
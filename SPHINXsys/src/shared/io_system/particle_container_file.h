@@ -0,0 +1,100 @@
+/**
+ * @file 	particle_container_file.h
+ * @brief 	The append-only container of the body states of a run.
+ * @details All bodies and all output times are written into one file.
+ *			Each snapshot of a body is a record with a header, which gives the body name, the time,
+ *			the number of particles and the table of the arrays with their absolute offsets,
+ *			followed by the arrays in the binary values of the vtu files.
+ *			A record is appended with sequential writes. Bodies which are not updated,
+ *			such as static walls, are only written once.
+ *			The reader builds the index of the records from their headers,
+ *			so that any variable of any body at any output time is read directly,
+ *			and exports the records into vtu files with a pvd series on demand.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+#include "vtu_file_writer.h"
+
+#include <string>
+#include <fstream>
+
+namespace SPH
+{
+	/**
+	 * @struct ContainerArray
+	 * @brief An entry of the array table of a record.
+	 */
+	struct ContainerArray
+	{
+		std::string name_;
+		std::string type_;
+		size_t number_of_components_;
+		size_t offset_;		/**< from the start of the file */
+		size_t size_;		/**< in bytes */
+	};
+
+	/**
+	 * @struct ContainerRecord
+	 * @brief The index entry of a snapshot of a body. The first array is the positions.
+	 */
+	struct ContainerRecord
+	{
+		std::string body_name_;
+		Real time_;
+		size_t number_of_points_;
+		StdVec<ContainerArray> arrays_;
+	};
+
+	/**
+	 * @class ParticleContainerWriter
+	 * @brief Appends the snapshots of bodies into a container file.
+	 */
+	class ParticleContainerWriter
+	{
+	public:
+		explicit ParticleContainerWriter(const std::string& filefullpath);
+		virtual ~ParticleContainerWriter() {};
+
+		/** append the arrays of the snapshot, which are not encoded, as a record */
+		void writeRecord(const std::string& body_name, Real time, size_t number_of_points, VtuFileWriter& snapshot);
+	protected:
+		std::string filefullpath_;
+		std::ofstream out_file_;
+		size_t file_size_;
+	};
+
+	/**
+	 * @class ParticleContainerReader
+	 * @brief Reads the index of a container file, the arrays of the records and exports them.
+	 */
+	class ParticleContainerReader
+	{
+	public:
+		explicit ParticleContainerReader(const std::string& filefullpath);
+		virtual ~ParticleContainerReader() {};
+
+		/** the records in the order as they were written */
+		StdVec<ContainerRecord> records_;
+
+		StdVec<std::string> getBodyNames();
+		/** the sorted times with at least one record */
+		StdVec<Real> getOutputTimes();
+		/** the last record of the body at or before the time, NULL if there is none */
+		const ContainerRecord* findRecord(const std::string& body_name, Real time);
+		/** the binary values of a variable of a record, the positions are named Position */
+		std::string readArray(const ContainerRecord& record, const std::string& variable_name);
+		/** write a vtu file for each record and the series SPHBodies.pvd, which refers to the
+		 *  file of the last record of each body at each output time */
+		void exportToVtu(const std::string& output_folder,
+			VtuEncoding encoding = VtuEncoding::raw, bool compressed = false);
+	protected:
+		std::string filefullpath_;
+		std::ifstream in_file_;
+
+		std::string readArray(const ContainerArray& container_array);
+		/** named by the index of the record, as the records of a body may be closer in time than the precision of a name */
+		std::string vtuFileName(size_t record_index);
+	};
+}
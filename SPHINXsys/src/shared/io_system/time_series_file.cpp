@@ -0,0 +1,197 @@
+/**
+ * @file 	time_series_file.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "time_series_file.h"
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+
+namespace SPH
+{
+	namespace
+	{
+		const char time_series_file_tag[8] = { 'S', 'P', 'H', 'T', 'S', 'B', '0', '1' };
+		const char time_series_index_tag[8] = { 'S', 'P', 'H', 'T', 'S', 'I', '0', '1' };
+		/** the default buffer of 8 MB in double precision */
+		const size_t default_time_series_buffer_size = 1 << 20;
+		const Real default_time_series_flush_interval = 10.0;
+
+		void appendValue(std::string& bytes, uint64_t value)
+		{
+			bytes.append(reinterpret_cast<const char*>(&value), sizeof(uint64_t));
+		}
+
+		void appendReal(std::string& bytes, Real value)
+		{
+			bytes.append(reinterpret_cast<const char*>(&value), sizeof(Real));
+		}
+
+		size_t existingFileSize(const std::string& filefullpath)
+		{
+			std::ifstream in_file(filefullpath.c_str(), std::ios::binary | std::ios::ate);
+			return in_file ? size_t(in_file.tellg()) : 0;
+		}
+
+		/** the quotes of the names in the text heads are not kept in the binary files */
+		std::string unquotedName(const std::string& name)
+		{
+			size_t begin = name.find_first_not_of('"');
+			size_t end = name.find_last_not_of('"');
+			return begin == std::string::npos ? std::string() : name.substr(begin, end - begin + 1);
+		}
+	}
+	//=================================================================================================//
+	TimeSeriesFile::TimeSeriesFile()
+		: format_(TimeSeriesFormat::text), head_written_(false),
+		buffer_size_(default_time_series_buffer_size), flush_interval_(default_time_series_flush_interval),
+		last_flush_(std::chrono::steady_clock::now()) {}
+	//=================================================================================================//
+	TimeSeriesFile::~TimeSeriesFile()
+	{
+		flush();
+	}
+	//=================================================================================================//
+	void TimeSeriesFile::openFile(const std::string& filefullpath, const StdVec<std::string>& column_names,
+		TimeSeriesFormat format)
+	{
+		flush();
+		format_ = format;
+		column_names_ = column_names;
+		head_written_ = false;
+		filefullpath_ = filefullpath;
+		if (format_ == TimeSeriesFormat::binary)
+		{
+			std::string base_path = filefullpath;
+			if (base_path.size() > 4 && base_path.compare(base_path.size() - 4, 4, ".dat") == 0)
+				base_path.erase(base_path.size() - 4);
+			filefullpath_ = base_path + ".bin";
+			index_filefullpath_ = base_path + ".idx";
+		}
+		last_flush_ = std::chrono::steady_clock::now();
+	}
+	//=================================================================================================//
+	void TimeSeriesFile::newRow(Real time)
+	{
+		rows_.push_back(time);
+	}
+	//=================================================================================================//
+	void TimeSeriesFile::addValue(const Vecd& value)
+	{
+		for (int j = 0; j < value.size(); ++j) rows_.push_back(value[j]);
+	}
+	//=================================================================================================//
+	void TimeSeriesFile::endRow()
+	{
+		if (column_names_.empty()) return;
+		if (rows_.size() % column_names_.size() != 0)
+		{
+			std::cout << "\n Error: the row of the time series " << filefullpath_ << " does not have "
+				<< column_names_.size() << " columns." << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+
+		std::chrono::duration<Real> since_last_flush = std::chrono::steady_clock::now() - last_flush_;
+		if (rows_.size() >= buffer_size_ || since_last_flush.count() >= flush_interval_) flush();
+	}
+	//=================================================================================================//
+	void TimeSeriesFile::flush()
+	{
+		if (filefullpath_.empty()) return;
+		if (format_ == TimeSeriesFormat::binary)
+		{
+			writeBinaryBlock();
+		}
+		else
+		{
+			writeTextRows();
+		}
+		rows_.clear();
+		last_flush_ = std::chrono::steady_clock::now();
+	}
+	//=================================================================================================//
+	void TimeSeriesFile::writeTextRows()
+	{
+		if (head_written_ && rows_.empty()) return;
+
+		std::ostringstream text;
+		if (!head_written_)
+		{
+			for (const std::string& column_name : column_names_) text << column_name << "   ";
+			text << "\n";
+			head_written_ = true;
+		}
+		size_t number_of_columns = column_names_.size();
+		for (size_t i = 0; i != rows_.size(); ++i)
+		{
+			text << rows_[i] << "   ";
+			if ((i + 1) % number_of_columns == 0) text << "\n";
+		}
+
+		std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
+		std::string bytes = text.str();
+		out_file.write(bytes.data(), bytes.size());
+		out_file.close();
+	}
+	//=================================================================================================//
+	void TimeSeriesFile::writeBinaryBlock()
+	{
+		std::string bytes;
+		size_t file_size = existingFileSize(filefullpath_);
+		/** the files of a restarted run with the same name are continued with new blocks */
+		if (!head_written_ && file_size == 0)
+		{
+			bytes.assign(time_series_file_tag, sizeof(time_series_file_tag));
+			appendValue(bytes, sizeof(Real));
+			appendValue(bytes, column_names_.size());
+			for (const std::string& column_name : column_names_)
+			{
+				std::string name = unquotedName(column_name);
+				appendValue(bytes, name.size());
+				bytes.append(name);
+			}
+		}
+		head_written_ = true;
+
+		size_t number_of_columns = column_names_.size();
+		size_t number_of_rows = rows_.size() / number_of_columns;
+		std::string index_entry;
+		if (number_of_rows != 0)
+		{
+			size_t block_offset = file_size + bytes.size();
+			appendValue(bytes, number_of_rows);
+			for (size_t j = 0; j != number_of_columns; ++j)
+				for (size_t i = 0; i != number_of_rows; ++i)
+					appendReal(bytes, rows_[i * number_of_columns + j]);
+
+			if (existingFileSize(index_filefullpath_) == 0)
+			{
+				index_entry.assign(time_series_index_tag, sizeof(time_series_index_tag));
+				appendValue(index_entry, sizeof(Real));
+			}
+			appendValue(index_entry, block_offset);
+			appendValue(index_entry, number_of_rows);
+			appendReal(index_entry, rows_[0]);
+			appendReal(index_entry, rows_[(number_of_rows - 1) * number_of_columns]);
+		}
+
+		if (!bytes.empty())
+		{
+			std::ofstream out_file(filefullpath_.c_str(), std::ios::app | std::ios::binary);
+			out_file.write(bytes.data(), bytes.size());
+			out_file.close();
+		}
+		/** the index is written after the block, so that it only refers to complete blocks */
+		if (!index_entry.empty())
+		{
+			std::ofstream index_file(index_filefullpath_.c_str(), std::ios::app | std::ios::binary);
+			index_file.write(index_entry.data(), index_entry.size());
+			index_file.close();
+		}
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,65 @@
+/**
+ * @file 	time_series_file.h
+ * @brief 	The buffered file of a time series, such as observed quantities or
+ *			the total force on a body.
+ * @details The rows are buffered in memory and written in large blocks,
+ *			when the buffer is full, when the last block is older than the flush interval,
+ *			by an explicit flush and when the file is destroyed.
+ *			The text format gives the usual columns of the .dat files.
+ *			The binary format has a header with the column names and blocks with the columns
+ *			of the buffered rows, i.e. it is columnar within each block.
+ *			A small index file gives the offset, the number of rows and the time range of the blocks.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+
+#include <string>
+#include <chrono>
+
+namespace SPH
+{
+	/** The format of the time series files. */
+	enum class TimeSeriesFormat { text, binary };
+
+	/**
+	 * @class TimeSeriesFile
+	 * @brief A time series file with buffered rows.
+	 * A row is started with the time and the values are added in the order of the columns.
+	 */
+	class TimeSeriesFile
+	{
+	public:
+		TimeSeriesFile();
+		virtual ~TimeSeriesFile();
+
+		/** The first column is the time. For the text format, the names are written as given.
+		 *  The binary files replace the extension .dat by .bin and .idx. */
+		void openFile(const std::string& filefullpath, const StdVec<std::string>& column_names,
+			TimeSeriesFormat format = TimeSeriesFormat::text);
+		void newRow(Real time);
+		void addValue(Real value) { rows_.push_back(value); };
+		void addValue(const Vecd& value);
+		/** flush the buffer if it is full or if the last flush is too long ago */
+		void endRow();
+		/** write the buffered rows */
+		void flush();
+		/** the buffer size is given by the number of values, at least one row is buffered */
+		void setBufferSize(size_t buffer_size) { buffer_size_ = buffer_size; };
+		void setFlushInterval(Real flush_interval) { flush_interval_ = flush_interval; };
+	protected:
+		std::string filefullpath_;
+		std::string index_filefullpath_;
+		TimeSeriesFormat format_;
+		StdVec<std::string> column_names_;
+		bool head_written_;
+		size_t buffer_size_;
+		Real flush_interval_;	/**< in seconds of wall clock time */
+		std::chrono::steady_clock::time_point last_flush_;
+		StdVec<Real> rows_;		/**< the buffered rows one after another */
+
+		void writeTextRows();
+		void writeBinaryBlock();
+	};
+}
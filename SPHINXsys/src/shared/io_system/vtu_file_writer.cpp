@@ -0,0 +1,253 @@
+/**
+ * @file 	vtu_file_writer.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "vtu_file_writer.h"
+
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#ifdef _VTU_ZLIB_COMPRESSION_
+#include <zlib.h>
+#endif
+
+namespace SPH
+{
+	namespace
+	{
+		/** the uncompressed size of the compressed blocks, the same as that of VTK */
+		const size_t compression_block_size = 32768;
+
+		std::string encodeBase64(const std::string& input)
+		{
+			static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+			std::string output((input.size() + 2) / 3 * 4, '=');
+			const unsigned char* bytes = reinterpret_cast<const unsigned char*>(input.data());
+			size_t number_of_triplets = input.size() / 3;
+			parallel_for(blocked_range<size_t>(0, number_of_triplets),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t i = r.begin(); i != r.end(); ++i)
+					{
+						uint32_t triplet = (uint32_t(bytes[3 * i]) << 16) | (uint32_t(bytes[3 * i + 1]) << 8) | bytes[3 * i + 2];
+						output[4 * i] = table[(triplet >> 18) & 0x3F];
+						output[4 * i + 1] = table[(triplet >> 12) & 0x3F];
+						output[4 * i + 2] = table[(triplet >> 6) & 0x3F];
+						output[4 * i + 3] = table[triplet & 0x3F];
+					}
+				}, ap);
+
+			size_t remainder = input.size() - 3 * number_of_triplets;
+			if (remainder != 0)
+			{
+				size_t i = number_of_triplets;
+				uint32_t triplet = uint32_t(bytes[3 * i]) << 16;
+				if (remainder == 2) triplet |= uint32_t(bytes[3 * i + 1]) << 8;
+				output[4 * i] = table[(triplet >> 18) & 0x3F];
+				output[4 * i + 1] = table[(triplet >> 12) & 0x3F];
+				if (remainder == 2) output[4 * i + 2] = table[(triplet >> 6) & 0x3F];
+			}
+			return output;
+		}
+
+		std::string headerBytes(const StdVec<uint64_t>& header)
+		{
+			std::string bytes(header.size() * sizeof(uint64_t), '\0');
+			if (!header.empty()) std::memcpy(&bytes[0], header.data(), bytes.size());
+			return bytes;
+		}
+	}
+	//=================================================================================================//
+	VtuFileWriter::VtuFileWriter(VtuEncoding encoding, bool compressed)
+		: encoding_(encoding), compressed_(compressed), is_selected_output_(false)
+	{
+#ifndef _VTU_ZLIB_COMPRESSION_
+		if (compressed_)
+		{
+			std::cout << "\n Warning: the vtu compression is not available without _VTU_ZLIB_COMPRESSION_,"
+				<< " the data is written uncompressed.\n";
+			compressed_ = false;
+		}
+#endif
+	}
+	//=================================================================================================//
+	void VtuFileWriter::setParticleSelection(const StdVec<size_t>& selected_particles)
+	{
+		is_selected_output_ = true;
+		selected_particles_ = selected_particles;
+	}
+	//=================================================================================================//
+	void VtuFileWriter::setHalfPrecisionVariables(const StdVec<std::string>& variable_names)
+	{
+		half_precision_variables_ = variable_names;
+	}
+	//=================================================================================================//
+	size_t VtuFileWriter::numberOfOutputPoints(size_t number_of_points)
+	{
+		return is_selected_output_ ? selected_particles_.size() : number_of_points;
+	}
+	//=================================================================================================//
+	void VtuFileWriter::roundToHalfPrecision(VtuDataArray& data_array)
+	{
+		if (data_array.type_ != "Float32" || std::find(half_precision_variables_.begin(),
+			half_precision_variables_.end(), data_array.name_) == half_precision_variables_.end()) return;
+
+		/** round to nearest even with the 10 bits mantissa of half precision, the exponent is kept */
+		uint32_t* values = reinterpret_cast<uint32_t*>(&data_array.data_[0]);
+		size_t number_of_values = data_array.data_.size() / sizeof(uint32_t);
+		parallel_for(blocked_range<size_t>(0, number_of_values),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					uint32_t bits = values[i];
+					if ((bits & 0x7F800000) == 0x7F800000) continue; //infinity and nan
+					bits += 0x00000FFF + ((bits >> 13) & 1);
+					values[i] = bits & 0xFFFFE000;
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	void VtuFileWriter::addPoints(StdLargeVec<Vecd>& positions, size_t number_of_points)
+	{
+		points_ = createDataArray<float>("Position", "Float32", 3, number_of_points,
+			[&](size_t i, float* values) {
+				Vec3d position = upgradeToVector3D(positions[i]);
+				for (size_t k = 0; k != 3; ++k) values[k] = float(position[k]);
+			});
+	}
+	//=================================================================================================//
+	void VtuFileWriter::addPointData(const std::string& name, StdLargeVec<Vecd>& variable, size_t number_of_points)
+	{
+		point_data_.push_back(createDataArray<float>(name, "Float32", 3, number_of_points,
+			[&](size_t i, float* values) {
+				Vec3d vector_value = upgradeToVector3D(variable[i]);
+				for (size_t k = 0; k != 3; ++k) values[k] = float(vector_value[k]);
+			}));
+	}
+	//=================================================================================================//
+	void VtuFileWriter::addPointData(const std::string& name, StdLargeVec<Real>& variable, size_t number_of_points)
+	{
+		addScalarPointData(name, number_of_points, [&](size_t i) { return variable[i]; });
+	}
+	//=================================================================================================//
+	void VtuFileWriter::addPointData(const std::string& name, StdLargeVec<size_t>& variable, size_t number_of_points)
+	{
+		addIndexPointData(name, number_of_points, [&](size_t i) { return variable[i]; });
+	}
+	//=================================================================================================//
+	void VtuFileWriter::encodeDataArray(VtuDataArray& data_array)
+	{
+		std::string& bytes = data_array.data_;
+		StdVec<uint64_t> header;
+		if (compressed_)
+		{
+#ifdef _VTU_ZLIB_COMPRESSION_
+			/** the header gives the number of blocks, the block size, the size of
+			 * the last partial block, zero if there is none, and the compressed sizes */
+			size_t number_of_blocks = (bytes.size() + compression_block_size - 1) / compression_block_size;
+			StdVec<std::string> compressed_blocks(number_of_blocks);
+			parallel_for(blocked_range<size_t>(0, number_of_blocks),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t n = r.begin(); n != r.end(); ++n)
+					{
+						size_t block_start = n * compression_block_size;
+						uLong block_size = uLong(SMIN(compression_block_size, bytes.size() - block_start));
+						uLongf compressed_size = compressBound(block_size);
+						std::string& compressed_block = compressed_blocks[n];
+						compressed_block.resize(compressed_size);
+						compress2(reinterpret_cast<Bytef*>(&compressed_block[0]), &compressed_size,
+							reinterpret_cast<const Bytef*>(bytes.data() + block_start), block_size, Z_BEST_SPEED);
+						compressed_block.resize(compressed_size);
+					}
+				}, ap);
+
+			header.push_back(number_of_blocks);
+			header.push_back(compression_block_size);
+			header.push_back(bytes.size() % compression_block_size);
+			size_t total_compressed_size = 0;
+			for (const std::string& compressed_block : compressed_blocks)
+			{
+				header.push_back(compressed_block.size());
+				total_compressed_size += compressed_block.size();
+			}
+			bytes.clear();
+			bytes.reserve(total_compressed_size);
+			for (const std::string& compressed_block : compressed_blocks) bytes += compressed_block;
+#endif
+		}
+		else
+		{
+			header.push_back(bytes.size());
+		}
+
+		/** the header and the data are encoded separately as expected by VTK readers */
+		if (encoding_ == VtuEncoding::base64)
+		{
+			data_array.header_ = encodeBase64(headerBytes(header));
+			data_array.data_ = encodeBase64(bytes);
+		}
+		else
+		{
+			data_array.header_ = headerBytes(header);
+		}
+	}
+	//=================================================================================================//
+	void VtuFileWriter::writeDataArrayHeader(std::ofstream& out_file, const VtuDataArray& data_array, size_t& offset)
+	{
+		out_file << "    <DataArray Name=\"" << data_array.name_ << "\" type=\"" << data_array.type_ << "\"";
+		if (data_array.number_of_components_ != 1)
+			out_file << " NumberOfComponents=\"" << data_array.number_of_components_ << "\"";
+		out_file << " format=\"appended\" offset=\"" << offset << "\"/>\n";
+		offset += data_array.header_.size() + data_array.data_.size();
+	}
+	//=================================================================================================//
+	void VtuFileWriter::writeToFile(std::ofstream& out_file, const std::string& piece_name, size_t number_of_points)
+	{
+		number_of_points = numberOfOutputPoints(number_of_points);
+		encodeDataArray(points_);
+		for (VtuDataArray& data_array : point_data_) encodeDataArray(data_array);
+
+		out_file << "<?xml version=\"1.0\"?>\n";
+		out_file << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\"";
+		if (compressed_) out_file << " compressor=\"vtkZLibDataCompressor\"";
+		out_file << ">\n";
+		out_file << " <UnstructuredGrid>\n";
+		out_file << "  <Piece Name=\"" << piece_name << "\" NumberOfPoints=\"" << number_of_points << "\" NumberOfCells=\"0\">\n";
+
+		size_t offset = 0;
+		out_file << "   <Points>\n";
+		writeDataArrayHeader(out_file, points_, offset);
+		out_file << "   </Points>\n";
+
+		out_file << "   <PointData Vectors=\"vector\">\n";
+		for (const VtuDataArray& data_array : point_data_) writeDataArrayHeader(out_file, data_array, offset);
+		out_file << "   </PointData>\n";
+
+		//empty cells
+		out_file << "   <Cells>\n";
+		out_file << "    <DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n";
+		out_file << "    </DataArray>\n";
+		out_file << "    <DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n";
+		out_file << "    </DataArray>\n";
+		out_file << "    <DataArray type=\"UInt8\" Name=\"types\" format=\"ascii\">\n";
+		out_file << "    </DataArray>\n";
+		out_file << "   </Cells>\n";
+
+		out_file << "  </Piece>\n";
+		out_file << " </UnstructuredGrid>\n";
+
+		out_file << " <AppendedData encoding=\"" << (encoding_ == VtuEncoding::base64 ? "base64" : "raw") << "\">\n";
+		out_file << "_";
+		out_file.write(points_.header_.data(), points_.header_.size());
+		out_file.write(points_.data_.data(), points_.data_.size());
+		for (const VtuDataArray& data_array : point_data_)
+		{
+			out_file.write(data_array.header_.data(), data_array.header_.size());
+			out_file.write(data_array.data_.data(), data_array.data_.size());
+		}
+		out_file << "\n </AppendedData>\n";
+		out_file << "</VTKFile>\n";
+	}
+	//=================================================================================================//
+}
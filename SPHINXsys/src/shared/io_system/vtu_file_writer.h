@@ -0,0 +1,122 @@
+/**
+ * @file 	vtu_file_writer.h
+ * @brief 	The writer of the particle data in the binary VTK XML unstructured grid format.
+ * @details The data arrays are converted in parallel into 32-bit binary values when they are added,
+ *			so that the writer is a snapshot of the particle data which can be written later.
+ *			When written, the arrays are encoded, either raw or base64, optionally compressed by zlib,
+ *			and each array is written in the appended data section with one bulk write.
+ *			The compression is available when compiled with _VTU_ZLIB_COMPRESSION_.
+ *			When a selection of particles is set, e.g. by an output filter, only the selected
+ *			particles are converted from the particle data, so that no full array is copied.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "base_data_package.h"
+
+#include <string>
+#include <fstream>
+
+namespace SPH
+{
+	/** The encoding of the appended data section. */
+	enum class VtuEncoding { raw, base64 };
+
+	/**
+	 * @struct VtuDataArray
+	 * @brief A data array with its binary values, which are replaced by the encoded data,
+ * with the size header, for the appended data section.
+	 */
+	struct VtuDataArray
+	{
+		std::string name_;
+		std::string type_;
+		size_t number_of_components_;
+		std::string header_;
+		std::string data_;
+	};
+
+	/**
+	 * @class VtuFileWriter
+	 * @brief Collects the particle positions and point data of a body and writes them into a vtu file.
+	 * The XML headers, which give the offsets of the arrays, are written first
+	 * and the arrays follow in the appended data section.
+	 */
+	class VtuFileWriter
+	{
+	public:
+		explicit VtuFileWriter(VtuEncoding encoding = VtuEncoding::raw, bool compressed = false);
+		virtual ~VtuFileWriter() {};
+
+		/** only the selected particles are written, to be set before the arrays are added */
+		void setParticleSelection(const StdVec<size_t>& selected_particles);
+		/** the values of these variables are rounded to the mantissa of half precision,
+		 *  they are still written as Float32 but are compressed much better */
+		void setHalfPrecisionVariables(const StdVec<std::string>& variable_names);
+		/** the number of written points for the number of particles of the body */
+		size_t numberOfOutputPoints(size_t number_of_points);
+
+		void addPoints(StdLargeVec<Vecd>& positions, size_t number_of_points);
+		void addPointData(const std::string& name, StdLargeVec<Vecd>& variable, size_t number_of_points);
+		void addPointData(const std::string& name, StdLargeVec<Real>& variable, size_t number_of_points);
+		void addPointData(const std::string& name, StdLargeVec<size_t>& variable, size_t number_of_points);
+		/** add a scalar computed for each point, such as the von Mises stress */
+		template<class GetScalar>
+		void addScalarPointData(const std::string& name, size_t number_of_points, const GetScalar& get_scalar)
+		{
+			point_data_.push_back(createDataArray<float>(name, "Float32", 1, number_of_points,
+				[&](size_t i, float* values) { values[0] = float(get_scalar(i)); }));
+		};
+		/** add an index computed for each point, such as the sorted particle index */
+		template<class GetIndex>
+		void addIndexPointData(const std::string& name, size_t number_of_points, const GetIndex& get_index)
+		{
+			point_data_.push_back(createDataArray<int32_t>(name, "Int32", 1, number_of_points,
+				[&](size_t i, int32_t* values) { values[0] = int32_t(get_index(i)); }));
+		};
+		/** the arrays of binary values before they are encoded */
+		const VtuDataArray& getPoints() { return points_; };
+		const StdVec<VtuDataArray>& getPointData() { return point_data_; };
+		/** set the points and add point data from arrays of binary values, e.g. read from a particle container */
+		void setPoints(const VtuDataArray& points) { points_ = points; };
+		void addPointData(const VtuDataArray& data_array) { point_data_.push_back(data_array); };
+		/** encode the arrays and write the file with a single piece without cells, only once */
+		void writeToFile(std::ofstream& out_file, const std::string& piece_name, size_t number_of_points);
+	protected:
+		VtuEncoding encoding_;
+		bool compressed_;
+		VtuDataArray points_;
+		StdVec<VtuDataArray> point_data_;
+		bool is_selected_output_;
+		StdVec<size_t> selected_particles_;
+		StdVec<std::string> half_precision_variables_;
+
+		/** convert the values of all points in parallel */
+		template<typename ValueType, class GetValues>
+		VtuDataArray createDataArray(const std::string& name, const std::string& type,
+			size_t number_of_components, size_t number_of_points, const GetValues& get_values)
+		{
+			size_t number_of_output_points = numberOfOutputPoints(number_of_points);
+			std::string bytes(number_of_output_points * number_of_components * sizeof(ValueType), '\0');
+			ValueType* values = reinterpret_cast<ValueType*>(&bytes[0]);
+			parallel_for(blocked_range<size_t>(0, number_of_output_points),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t k = r.begin(); k != r.end(); ++k)
+					{
+						size_t i = is_selected_output_ ? selected_particles_[k] : k;
+						get_values(i, values + k * number_of_components);
+					}
+				}, ap);
+
+			VtuDataArray data_array = { name, type, number_of_components, "", "" };
+			data_array.data_.swap(bytes);
+			roundToHalfPrecision(data_array);
+			return data_array;
+		};
+		/** only for the Float32 arrays of the half precision variables */
+		void roundToHalfPrecision(VtuDataArray& data_array);
+		/** set the size header and encode the data */
+		void encodeDataArray(VtuDataArray& data_array);
+		void writeDataArrayHeader(std::ofstream& out_file, const VtuDataArray& data_array, size_t& offset);
+	};
+}
@@ -136,6 +136,16 @@ namespace SPH
          *@param[out] (size_t) 1D index.
          */
         size_t transferMeshIndexToMortonOrder(Vecu grid_index);
+        /**
+         *@brief This function converts mesh index into a Hilbert order.
+         * The transpose of the Hilbert index is obtained by the algorithm of J. Skilling,
+         * Programming the Hilbert curve, AIP Conference Proceedings 707, 2004,
+         * and its bits are interleaved into the Hilbert index.
+         *@param[in] grid_index Mesh index in each direction.
+         *@param[in] number_of_bits Number of bits of the mesh index in each direction.
+         *@param[out] (size_t) 1D index.
+         */
+        size_t transferMeshIndexToHilbertOrder(Vecu grid_index, size_t number_of_bits);
     };
 
 	/**
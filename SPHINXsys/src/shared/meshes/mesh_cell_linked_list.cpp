@@ -5,56 +5,189 @@
  */
 
 #include "mesh_cell_linked_list.h"
+#include "mesh_cell_linked_list.hpp"
 #include "base_kernel.h"
 #include "base_body.h"
 #include "base_particles.h"
+#include "sph_profiler.h"
+#include "memory_footprint.h"
 
 
 namespace SPH {
 	//=================================================================================================//
-	SwapParticleData::SwapParticleData(BaseParticles* base_particles) :
+	size_t CellList::UsedBytes()
+	{
+		return sizeof(CellList) + concurrent_particle_indexes_.size() * sizeof(size_t)
+			+ cell_list_data_.size() * sizeof(ListData) + real_particle_indexes_.size() * sizeof(size_t);
+	}
+	//=================================================================================================//
+	size_t CellList::AllocatedBytes()
+	{
+		return sizeof(CellList) + concurrent_particle_indexes_.capacity() * sizeof(size_t)
+			+ cell_list_data_.capacity() * sizeof(ListData) + real_particle_indexes_.capacity() * sizeof(size_t);
+	}
+	//=================================================================================================//
+	SortParticleData::SortParticleData(BaseParticles* base_particles) :
 		sequence_(base_particles->sequence_),
+		sorted_id_(base_particles->sorted_id_),
 		unsorted_id_(base_particles->unsorted_id_),
 		sortable_matrices_(base_particles->sortable_matrices_),
 		sortable_vectors_(base_particles->sortable_vectors_),
 		sortable_scalars_(base_particles->sortable_scalars_) {}
 	//=================================================================================================//
-	void SwapParticleData::operator () (size_t* a, size_t* b)
+	void SortParticleData::radixSortSequence(size_t number_of_particles)
 	{
-		std::swap(*a, *b);
-
-		size_t index_a = a - sequence_.data();
-		size_t index_b = b - sequence_.data();
-		std::swap(unsorted_id_[index_a], unsorted_id_[index_b]);
-		for (size_t i = 0; i != sortable_matrices_.size(); ++i) {
-			StdLargeVec<Matd>& matrices = *(sortable_matrices_[i]);
-			std::swap(matrices[index_a], matrices[index_b]);
+		/** The memory is only increased so that no reallocation is required for most sortings. */
+		if (number_of_particles > permutation_.size())
+		{
+			permutation_.resize(number_of_particles);
+			sequence_buffer_.resize(number_of_particles);
+			permutation_buffer_.resize(number_of_particles);
 		}
-		for (size_t i = 0; i != sortable_vectors_.size(); ++i) {
-			StdLargeVec<Vecd>& vectors = *(sortable_vectors_[i]);
-			std::swap(vectors[index_a], vectors[index_b]);
+		size_t number_of_blocks = (number_of_particles + block_size_ - 1) / block_size_;
+		block_digit_counts_.resize(number_of_blocks * radix_);
+
+		size_t max_key = parallel_reduce(blocked_range<size_t>(0, number_of_particles), size_t(0),
+			[&](const blocked_range<size_t>& r, size_t local_max)->size_t {
+				for (size_t i = r.begin(); i != r.end(); ++i) 
+					local_max = sequence_[i] > local_max ? sequence_[i] : local_max;
+				return local_max;
+			},
+			[](size_t x, size_t y)->size_t { return x > y ? x : y; });
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) permutation_[i] = i;
+			}, ap);
+
+		size_t* keys = sequence_.data();
+		size_t* keys_out = sequence_buffer_.data();
+		size_t* indexes = permutation_.data();
+		size_t* indexes_out = permutation_buffer_.data();
+		/** only the digits present in the largest key are sorted */
+		for (size_t shift = 0; shift < 8 * sizeof(size_t) && (max_key >> shift) != 0; shift += radix_bits_)
+		{
+			parallel_for(blocked_range<size_t>(0, number_of_blocks),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t b = r.begin(); b != r.end(); ++b) {
+						size_t* digit_counts = block_digit_counts_.data() + b * radix_;
+						for (size_t d = 0; d != radix_; ++d) digit_counts[d] = 0;
+						size_t end = SMIN((b + 1) * block_size_, number_of_particles);
+						for (size_t i = b * block_size_; i != end; ++i)
+							digit_counts[(keys[i] >> shift) & (radix_ - 1)]++;
+					}
+				});
+
+			/** exclusive prefix sum in digit-major order keeps the sort stable */
+			size_t offset = 0;
+			for (size_t d = 0; d != radix_; ++d)
+				for (size_t b = 0; b != number_of_blocks; ++b) {
+					size_t& digit_count = block_digit_counts_[b * radix_ + d];
+					size_t count = digit_count;
+					digit_count = offset;
+					offset += count;
+				}
+
+			parallel_for(blocked_range<size_t>(0, number_of_blocks),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t b = r.begin(); b != r.end(); ++b) {
+						size_t* digit_offsets = block_digit_counts_.data() + b * radix_;
+						size_t end = SMIN((b + 1) * block_size_, number_of_particles);
+						for (size_t i = b * block_size_; i != end; ++i) {
+							size_t destination = digit_offsets[(keys[i] >> shift) & (radix_ - 1)]++;
+							keys_out[destination] = keys[i];
+							indexes_out[destination] = indexes[i];
+						}
+					}
+				});
+			std::swap(keys, keys_out);
+			std::swap(indexes, indexes_out);
 		}
-		for (size_t i = 0; i != sortable_scalars_.size(); ++i) {
-			StdLargeVec<Real>& scalars = *(sortable_scalars_[i]);
-			std::swap(scalars[index_a], scalars[index_b]);
+
+		if (keys != sequence_.data())
+		{
+			parallel_for(blocked_range<size_t>(0, number_of_particles),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t i = r.begin(); i != r.end(); ++i) {
+						sequence_[i] = keys[i];
+						permutation_[i] = indexes[i];
+					}
+				}, ap);
 		}
-	}	
+	}
+	//=================================================================================================//
+	template<class VariableType>
+	void SortParticleData::gatherParticleData(StdLargeVec<VariableType>& variable,
+		StdLargeVec<VariableType>& buffer, size_t number_of_particles)
+	{
+		if (number_of_particles > buffer.size()) buffer.resize(number_of_particles);
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) buffer[i] = variable[permutation_[i]];
+			}, ap);
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) variable[i] = buffer[i];
+			}, ap);
+	}
+	//=================================================================================================//
+	void SortParticleData::gatherParticleIds(size_t number_of_particles)
+	{
+		StdLargeVec<size_t>& id_buffer = sequence_buffer_;
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) id_buffer[i] = unsorted_id_[permutation_[i]];
+			}, ap);
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					unsorted_id_[i] = id_buffer[i];
+					sorted_id_[id_buffer[i]] = i;
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	void SortParticleData::sortingParticleData(size_t number_of_particles)
+	{
+		radixSortSequence(number_of_particles);
+		gatherParticleIds(number_of_particles);
+		for (size_t i = 0; i != sortable_matrices_.size(); ++i)
+			gatherParticleData(*sortable_matrices_[i], matrix_buffer_, number_of_particles);
+		for (size_t i = 0; i != sortable_vectors_.size(); ++i)
+			gatherParticleData(*sortable_vectors_[i], vector_buffer_, number_of_particles);
+		for (size_t i = 0; i != sortable_scalars_.size(); ++i)
+			gatherParticleData(*sortable_scalars_[i], scalar_buffer_, number_of_particles);
+	}
+	//=================================================================================================//
+	void SortParticleData::accountMemory(MemoryFootprint& footprint)
+	{
+		footprint.addVector("particle sorting", "permutation", permutation_);
+		footprint.addVector("particle sorting", "sequence buffer", sequence_buffer_);
+		footprint.addVector("particle sorting", "permutation buffer", permutation_buffer_);
+		footprint.addVector("particle sorting", "block digit counts", block_digit_counts_);
+		footprint.addVector("particle sorting", "matrix buffer", matrix_buffer_);
+		footprint.addVector("particle sorting", "vector buffer", vector_buffer_);
+		footprint.addVector("particle sorting", "scalar buffer", scalar_buffer_);
+	}
 	//=================================================================================================//
 	BaseMeshCellLinkedList
 		::BaseMeshCellLinkedList(SPHBody* body, Vecd lower_bound, Vecd upper_bound,
 			Real cell_spacing, size_t buffer_width)
 		: Mesh(lower_bound, upper_bound, cell_spacing, buffer_width), 
 		body_(body), base_particles_(NULL), kernel_(body->kernel_),
-		swap_particle_data_(NULL) {}
+		sort_particle_data_(NULL), split_cell_lists_version_(0), space_filling_curve_(SpaceFillingCurve::morton) 
+	{
+		setSpaceFillingCurve(space_filling_curve_);
+	}
 	//=================================================================================================//
 	BaseMeshCellLinkedList
 		::BaseMeshCellLinkedList(SPHBody* body, 
 			Vecd mesh_lower_bound, Vecu number_of_cells, Real cell_spacing)
 		: Mesh(mesh_lower_bound, number_of_cells, cell_spacing),
 		body_(body), base_particles_(NULL), kernel_(body->kernel_),
-		swap_particle_data_(NULL), compare_(),
-		quick_sort_particle_range_(NULL),
-		quick_sort_particle_body_() {}
+		sort_particle_data_(NULL), split_cell_lists_version_(0), space_filling_curve_(SpaceFillingCurve::morton)
+	{
+		setSpaceFillingCurve(space_filling_curve_);
+	}
 	//=================================================================================================//
 	int BaseMeshCellLinkedList::computeSearchRange(int origin_refinement_level,
 		int target_refinement_level)
@@ -74,11 +207,8 @@ namespace SPH {
 	void BaseMeshCellLinkedList::assignBaseParticles(BaseParticles* base_particles) 
 	{ 
 		base_particles_ = base_particles; 
-		swap_particle_data_ = new SwapParticleData(base_particles);
-		size_t* begin = base_particles_->sequence_.data();
-		quick_sort_particle_range_ = new tbb::interafce9::internal::
-			QuickSortParticleRange<size_t*, CompareParticleSequence, SwapParticleData>
-			(begin, 0, compare_, *swap_particle_data_);
+		delete sort_particle_data_;
+		sort_particle_data_ = new SortParticleData(base_particles);
 	};
 	//=================================================================================================//
 	void BaseMeshCellLinkedList::reassignKernel(Kernel* kernel)
@@ -90,16 +220,52 @@ namespace SPH {
 	{
 		for (size_t i = 0; i < split_cell_lists.size(); i++)
 			split_cell_lists[i].clear();
+		split_cell_lists_version_++;
+	}
+	//=================================================================================================//
+	void BaseMeshCellLinkedList::accountMemory(MemoryFootprint& footprint)
+	{
+		SplitCellLists& split_cell_lists = body_->split_cell_lists_;
+		size_t used_bytes = 0, allocated_bytes = 0;
+		for (size_t i = 0; i != split_cell_lists.size(); ++i)
+		{
+			used_bytes += split_cell_lists[i].size() * sizeof(CellList*);
+			allocated_bytes += split_cell_lists[i].capacity() * sizeof(CellList*);
+		}
+		footprint.addRecord("cell linked list", "split cell lists", used_bytes, allocated_bytes);
+		if (sort_particle_data_ != NULL) sort_particle_data_->accountMemory(footprint);
 	}
 	//=================================================================================================//
 	void BaseMeshCellLinkedList::sortingParticleData()
 	{
-		StdLargeVec<size_t>& sequence = base_particles_->sequence_;
-		computingSequence(sequence);
-		quick_sort_particle_range_->begin_ = sequence.data();
-		quick_sort_particle_range_->size_ = body_->number_of_particles_;
-		parallel_for(*quick_sort_particle_range_, quick_sort_particle_body_, ap);
-		updateSortedId();
+		ProfilerSpan profiler_span("sortingParticleData", body_);
+		computingSequence(base_particles_->sequence_);
+		sort_particle_data_->sortingParticleData(body_->number_of_particles_);
+		base_particles_->sorting_count_++;
+	}
+	//=================================================================================================//
+	void BaseMeshCellLinkedList::setSpaceFillingCurve(SpaceFillingCurve space_filling_curve)
+	{
+		space_filling_curve_ = space_filling_curve;
+		/** the Hilbert curve covers the smallest power-of-two square or cube enclosing the mesh */
+		size_t max_number_of_cells = 1;
+		for (size_t i = 0; i != number_of_cells_.size(); ++i)
+			max_number_of_cells = SMAX(max_number_of_cells, number_of_cells_[i]);
+		hilbert_order_bits_ = 1;
+		while ((size_t(1) << hilbert_order_bits_) < max_number_of_cells) hilbert_order_bits_++;
+	}
+	//=================================================================================================//
+	size_t BaseMeshCellLinkedList::transferMeshIndexToSequence(const Vecu& cell_index)
+	{
+		switch (space_filling_curve_)
+		{
+		case SpaceFillingCurve::hilbert:
+			return transferMeshIndexToHilbertOrder(cell_index, hilbert_order_bits_);
+		case SpaceFillingCurve::row_major:
+			return transferMeshIndexTo1D(number_of_cells_, cell_index);
+		default:
+			return transferMeshIndexToMortonOrder(cell_index);
+		}
 	}
 	//=================================================================================================//
 	void BaseMeshCellLinkedList::updateSortedId()
@@ -118,12 +284,12 @@ namespace SPH {
 	MeshCellLinkedList::MeshCellLinkedList(SPHBody* body, Vecd lower_bound,
 		Vecd upper_bound, Real cell_spacing, size_t buffer_width)
 		: BaseMeshCellLinkedList(body, lower_bound, upper_bound, cell_spacing, buffer_width),
-		cutoff_radius_(cell_spacing) {}
+		cutoff_radius_(cell_spacing), cell_linked_lists_(NULL) {}
 	//=================================================================================================//
 	MeshCellLinkedList::MeshCellLinkedList(SPHBody* body, Vecd mesh_lower_bound,
 		Vecu number_of_cells, Real cell_spacing)
 		: BaseMeshCellLinkedList(body, mesh_lower_bound, number_of_cells, cell_spacing),
-		cutoff_radius_(cell_spacing) {}
+		cutoff_radius_(cell_spacing), cell_linked_lists_(NULL) {}
 	//=================================================================================================//
 	void MeshCellLinkedList::UpdateCellLists()
 	{
@@ -140,6 +306,14 @@ namespace SPH {
 		UpdateSplitCellLists(body_->split_cell_lists_, number_of_cells_, cell_linked_lists_);
 	}
 	//=================================================================================================//
+	void MeshCellLinkedList::accountMemory(MemoryFootprint& footprint)
+	{
+		BaseMeshCellLinkedList::accountMemory(footprint);
+		/** the cell lists are not allocated for fictitious bodies */
+		if (cell_linked_lists_ != NULL)
+			accountCellListsMemory(footprint, "cell lists", number_of_cells_, cell_linked_lists_);
+	}
+	//=================================================================================================//
 	void MeshCellLinkedList::computingSequence(StdLargeVec<size_t>& sequence)
 	{
 		StdLargeVec<Vecd>& positions = base_particles_->pos_n_;
@@ -147,7 +321,243 @@ namespace SPH {
 		parallel_for(blocked_range<size_t>(0, number_of_particles),
 			[&](const blocked_range<size_t>& r) {
 				for (size_t i = r.begin(); i != r.end(); ++i) {
-                    sequence[i] = transferMeshIndexToMortonOrder(GridIndexFromPosition(positions[i]));
+                    sequence[i] = transferMeshIndexToSequence(GridIndexFromPosition(positions[i]));
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	FlatMeshCellLinkedList::FlatMeshCellLinkedList(SPHBody* body, Vecd lower_bound,
+		Vecd upper_bound, Real cell_spacing, size_t buffer_width)
+		: MeshCellLinkedList(body, lower_bound, upper_bound, cell_spacing, buffer_width) {}
+	//=================================================================================================//
+	size_t FlatMeshCellLinkedList::TotalNumberOfCells()
+	{
+		size_t total_number_of_cells = 1;
+		for (size_t k = 0; k != number_of_cells_.size(); ++k)
+			total_number_of_cells *= number_of_cells_[k];
+		return total_number_of_cells;
+	}
+	//=================================================================================================//
+	void FlatMeshCellLinkedList::allocateMeshDataMatrix()
+	{
+		MeshCellLinkedList::allocateMeshDataMatrix();
+		size_t total_number_of_cells = TotalNumberOfCells();
+		cell_counts_ = StdVec<std::atomic<size_t>>(total_number_of_cells);
+		cell_offsets_.resize(total_number_of_cells + 1, 0);
+	}
+	//=================================================================================================//
+	void FlatMeshCellLinkedList::sortParticlesIntoCells()
+	{
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		size_t number_of_particles = body_->number_of_particles_;
+		size_t total_number_of_cells = TotalNumberOfCells();
+		/** The memory is only increased so that no reallocation is required for most updates. */
+		if (number_of_particles > particle_cell_.size())
+		{
+			particle_cell_.resize(number_of_particles);
+			particle_rank_.resize(number_of_particles);
+			flat_particle_indexes_.resize(number_of_particles);
+		}
+
+		parallel_for(blocked_range<size_t>(0, total_number_of_cells),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					cell_counts_[i].store(0, std::memory_order_relaxed);
+				}
+			}, ap);
+
+		/** Only one atomic increment per particle, the contention is limited to particles in the same cell. */
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					size_t cell_index = transferMeshIndexTo1D(number_of_cells_, GridIndexFromPosition(pos_n[i]));
+					particle_cell_[i] = cell_index;
+					particle_rank_[i] = cell_counts_[cell_index].fetch_add(1, std::memory_order_relaxed);
+				}
+			}, ap);
+
+		parallel_for(blocked_range<size_t>(0, total_number_of_cells),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					cell_offsets_[i + 1] = cell_counts_[i].load(std::memory_order_relaxed);
+				}
+			}, ap);
+
+		parallel_scan(blocked_range<size_t>(1, cell_offsets_.size()), size_t(0),
+			[&](const blocked_range<size_t>& r, size_t sum, bool is_final_scan)->size_t {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					sum += cell_offsets_[i];
+					if (is_final_scan) cell_offsets_[i] = sum;
+				}
+				return sum;
+			},
+			[](size_t x, size_t y)->size_t { return x + y; });
+
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					flat_particle_indexes_[cell_offsets_[particle_cell_[i]] + particle_rank_[i]] = i;
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	void FlatMeshCellLinkedList::UpdateCellLists()
+	{
+		sortParticlesIntoCells();
+		UpdateCellListsFromFlatData(body_->split_cell_lists_);
+	}
+	//=================================================================================================//
+	void FlatMeshCellLinkedList::accountMemory(MemoryFootprint& footprint)
+	{
+		MeshCellLinkedList::accountMemory(footprint);
+		footprint.addVector("cell linked list", "particle cells", particle_cell_);
+		footprint.addVector("cell linked list", "particle ranks", particle_rank_);
+		footprint.addVector("cell linked list", "cell counts", cell_counts_);
+		footprint.addVector("cell linked list", "cell offsets", cell_offsets_);
+		footprint.addVector("cell linked list", "flat particle indexes", flat_particle_indexes_);
+	}
+	//=================================================================================================//
+	SparseMeshCellLinkedList::SparseMeshCellLinkedList(SPHBody* body, Vecd lower_bound,
+		Vecd upper_bound, Real cell_spacing, size_t buffer_width)
+		: BaseMeshCellLinkedList(body, lower_bound, upper_bound, cell_spacing, buffer_width),
+		generation_(0), eviction_age_(8) {}
+	//=================================================================================================//
+	size_t SparseMeshCellLinkedList::SplitCellListIndex(size_t cell_key)
+	{
+		Vecu cell_index = transfer1DtoMeshIndex(number_of_cells_, cell_key);
+		Vecu split_index(0);
+		for (size_t k = 0; k != cell_index.size(); ++k)
+			split_index[k] = cell_index[k] % 3;
+		return transferMeshIndexTo1D(Vecu(3), split_index);
+	}
+	//=================================================================================================//
+	CellList* SparseMeshCellLinkedList::CellListFromIndex(Vecu cell_index)
+	{
+		SparseCellList& cell_list = cell_lists_[CellKey(cell_index)];
+		cell_list.is_pinned_ = true;
+		return &cell_list;
+	}
+	//=================================================================================================//
+	CellList* SparseMeshCellLinkedList::findCellList(const Vecu& cell_index)
+	{
+		auto stored_cell = cell_lists_.find(CellKey(cell_index));
+		return stored_cell == cell_lists_.end() ? NULL : &stored_cell->second;
+	}
+	//=================================================================================================//
+	void SparseMeshCellLinkedList::UpdateCellLists()
+	{
+		StdLargeVec<Vecd>& pos_n = base_particles_->pos_n_;
+		size_t number_of_particles = body_->number_of_particles_;
+		cell_particle_pairs_.resize(number_of_particles);
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					cell_particle_pairs_[i] = std::make_pair(CellKey(GridIndexFromPosition(pos_n[i])), i);
+				}
+			}, ap);
+		parallel_sort(cell_particle_pairs_.begin(), cell_particle_pairs_.end());
+
+		generation_++;
+		/** the eviction is not concurrent, therefore, only checked once in the eviction age */
+		if (generation_ % eviction_age_ == 0) evictEmptyCells();
+
+		/** All stored cells are cleared, including these only with ghost particle data. */
+		parallel_for(cell_lists_.range(),
+			[&](const tbb::concurrent_unordered_map<size_t, SparseCellList>::range_type& r) {
+				for (auto cell = r.begin(); cell != r.end(); ++cell) {
+					cell->second.real_particle_indexes_.clear();
+					cell->second.cell_list_data_.clear();
+				}
+			});
+		SplitCellLists& split_cell_lists = body_->split_cell_lists_;
+		ClearSplitCellLists(split_cell_lists);
+
+		/** Each cell is filled by the thread which owns the first particle of the cell. */
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t s = r.begin(); s != r.end(); ++s) {
+					size_t cell_key = cell_particle_pairs_[s].first;
+					if (s != 0 && cell_particle_pairs_[s - 1].first == cell_key) continue;
+
+					SparseCellList& cell_list = cell_lists_[cell_key];
+					cell_list.occupied_generation_ = generation_;
+					for (size_t n = s; n != number_of_particles && cell_particle_pairs_[n].first == cell_key; ++n) {
+						size_t particle_index = cell_particle_pairs_[n].second;
+						cell_list.real_particle_indexes_.push_back(particle_index);
+						cell_list.cell_list_data_.emplace_back(make_pair(particle_index, pos_n[particle_index]));
+					}
+					cell_list.cell_index_ = transfer1DtoMeshIndex(number_of_cells_, cell_key);
+					split_cell_lists[SplitCellListIndex(cell_key)].push_back(&cell_list);
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	void SparseMeshCellLinkedList::evictEmptyCells()
+	{
+		for (auto cell = cell_lists_.begin(); cell != cell_lists_.end();)
+		{
+			if (!cell->second.is_pinned_ && cell->second.occupied_generation_ + eviction_age_ < generation_)
+			{
+				cell = cell_lists_.unsafe_erase(cell);
+			}
+			else
+			{
+				++cell;
+			}
+		}
+	}
+	//=================================================================================================//
+	void SparseMeshCellLinkedList
+		::InsertACellLinkedParticleIndex(size_t particle_index, Vecd particle_position)
+	{
+		findOrCreateCellList(GridIndexFromPosition(particle_position))
+			->concurrent_particle_indexes_.emplace_back(particle_index);
+	}
+	//=================================================================================================//
+	void SparseMeshCellLinkedList
+		::InsertACellLinkedListDataEntry(size_t particle_index, Vecd particle_position)
+	{
+		findOrCreateCellList(GridIndexFromPosition(particle_position))
+			->cell_list_data_.emplace_back(make_pair(particle_index, particle_position));
+	}
+	//=================================================================================================//
+	void SparseMeshCellLinkedList::accountMemory(MemoryFootprint& footprint)
+	{
+		BaseMeshCellLinkedList::accountMemory(footprint);
+		size_t used_bytes = 0, allocated_bytes = 0;
+		for (auto& key_cell_list : cell_lists_)
+		{
+			used_bytes += sizeof(size_t) + key_cell_list.second.UsedBytes();
+			allocated_bytes += sizeof(size_t) + key_cell_list.second.AllocatedBytes();
+		}
+		footprint.addRecord("cell linked list", "hashed cell lists", used_bytes, allocated_bytes);
+		footprint.addVector("cell linked list", "cell particle pairs", cell_particle_pairs_);
+	}
+	//=================================================================================================//
+	ListData SparseMeshCellLinkedList::findNearestListDataEntry(Vecd& position)
+	{
+		Real min_distance = Infinity;
+		ListData nearest_entry = std::make_pair(MaxSize_t, Vecd(Infinity));
+		searchCellListDataAround(GridIndexFromPosition(position), 1,
+			[&](ListData& list_data) {
+				Real distance = (position - list_data.second).norm();
+				if (distance < min_distance)
+				{
+					min_distance = distance;
+					nearest_entry = list_data;
+				}
+			});
+		return nearest_entry;
+	}
+	//=================================================================================================//
+	void SparseMeshCellLinkedList::computingSequence(StdLargeVec<size_t>& sequence)
+	{
+		StdLargeVec<Vecd>& positions = base_particles_->pos_n_;
+		size_t number_of_particles = body_->number_of_particles_;
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					sequence[i] = transferMeshIndexToSequence(GridIndexFromPosition(positions[i]));
 				}
 			}, ap);
 	}
@@ -234,6 +644,17 @@ namespace SPH {
 		mesh_cell_linked_list_levels_[current_level]->InsertACellLinkedParticleIndex(index_i, particle_position);
 	}
 	//=================================================================================================//
+	void MultilevelMeshCellLinkedList::accountMemory(MemoryFootprint& footprint)
+	{
+		BaseMeshCellLinkedList::accountMemory(footprint);
+		for (size_t l = 0; l != total_levels_; ++l) {
+			accountCellListsMemory(footprint, "cell lists of level " + std::to_string(l),
+				number_of_cells_levels_[l], mesh_cell_linked_list_levels_[l]->CellLinkedLists());
+			accountCellListsMemory(footprint, "projected cell lists of level " + std::to_string(l),
+				number_of_cells_levels_[l], cell_linked_lists_levels_[l]);
+		}
+	}
+	//=================================================================================================//
 	void MultilevelMeshCellLinkedList::allocateMeshDataMatrix()
 	{
 		for (size_t l = 0; l != total_levels_; ++l) {
@@ -35,150 +35,7 @@
 
 #include "base_mesh.h"
 
-/** this is a reformulation of tbb parallel_sort for particle data */
-namespace tbb {
-	namespace interafce9 {
-		namespace internal {
-
-			using tbb::internal::no_assign;
-
-			/** sorting particle */
-			template<typename RandomAccessIterator, typename Compare, typename SwapType>
-			class QuickSortParticleRange : private no_assign {
-
-				inline size_t median_of_three(const RandomAccessIterator& array, size_t l, size_t m, size_t r) const {
-					return comp_(array[l], array[m]) ? (comp_(array[m], array[r]) ? m : (comp_(array[l], array[r]) ? r : l))
-						: (comp_(array[r], array[m]) ? m : (comp_(array[r], array[l]) ? r : l));
-				}
-
-				inline size_t PseudoMedianOfNine(const RandomAccessIterator& array, const QuickSortParticleRange& range) const {
-					size_t offset = range.size_ / 8u;
-					return median_of_three(array,
-						median_of_three(array, 0, offset, offset * 2),
-						median_of_three(array, offset * 3, offset * 4, offset * 5),
-						median_of_three(array, offset * 6, offset * 7, range.size_ - 1));
-
-				}
-
-				size_t splitRange(QuickSortParticleRange& range) {
-					RandomAccessIterator array = range.begin_;
-					RandomAccessIterator key0 = range.begin_;
-					size_t m = PseudoMedianOfNine(array, range);
-					if (m) swap_particle_data_(array, array + m);
-
-					size_t i = 0;
-					size_t j = range.size_;
-					// Partition interval [i+1,j-1] with key *key0.
-					for (;;) {
-						__TBB_ASSERT(i < j, NULL);
-						// Loop must terminate since array[l]==*key0.
-						do {
-							--j;
-							__TBB_ASSERT(i <= j, "bad ordering relation?");
-						} while (comp_(*key0, array[j]));
-						do {
-							__TBB_ASSERT(i <= j, NULL);
-							if (i == j) goto quick_sort_particle_partition;
-							++i;
-						} while (comp_(array[i], *key0));
-						if (i == j) goto quick_sort_particle_partition;
-						swap_particle_data_(array + i, array + j);
-					}
-				quick_sort_particle_partition:
-					// Put the partition key were it belongs
-					swap_particle_data_(array + j, key0);
-					// array[l..j) is less or equal to key.
-					// array(j..r) is greater or equal to key.
-					// array[j] is equal to key
-					i = j + 1;
-					size_t new_range_size = range.size_ - i;
-					range.size_ = j;
-					return new_range_size;
-				}
-
-			public:
-
-				static const size_t grainsize_ = 500;
-				const Compare& comp_;
-				SwapType& swap_particle_data_;
-				size_t size_;
-				RandomAccessIterator begin_;
-
-				QuickSortParticleRange(RandomAccessIterator begin,
-					size_t size, const Compare& compare, SwapType& swap_particle_data) :
-					comp_(compare), swap_particle_data_(swap_particle_data),
-					size_(size), begin_(begin) {}
-
-				bool empty() const { return size_ == 0; }
-				bool is_divisible() const { return size_ >= grainsize_; }
-
-				QuickSortParticleRange(QuickSortParticleRange& range, split)
-					: comp_(range.comp_), swap_particle_data_(range.swap_particle_data_)
-					, size_(splitRange(range))
-					// +1 accounts for the pivot element, which is at its correct place
-					// already and, therefore, is not included into subranges.
-					, begin_(range.begin_ + range.size_ + 1) {}
-			};
-
-			/*
-			Description : QuickSort in Iterator format
-			Link        : https://stackoverflow.com/a/54976413/3547485
-			Ref			: http://www.cs.fsu.edu/~lacher/courses/COP4531/lectures/sorts/slide09.html
-			*/
-			template <typename RandomAccessIterator, typename Compare, typename SwapType>
-			RandomAccessIterator Partition(RandomAccessIterator first, RandomAccessIterator last, Compare& compare, SwapType& swap_particle_data)
-			{
-				auto pivot = std::prev(last, 1);
-				auto i = first;
-				for (auto j = first; j != pivot; ++j) {
-					// bool format 
-					if (compare(*j, *pivot)) {
-						swap_particle_data(i++, j);
-					}
-				}
-				swap_particle_data(i, pivot);
-				return i;
-			}
-
-			template <typename RandomAccessIterator, typename Compare, typename SwapType>
-			void SerialQuickSort(RandomAccessIterator first, RandomAccessIterator last, Compare& compare, SwapType& swap_particle_data)
-			{
-				if (std::distance(first, last) > 1) {
-					RandomAccessIterator bound = Partition(first, last, compare, swap_particle_data);
-					SerialQuickSort(first, bound, compare, swap_particle_data);
-					SerialQuickSort(bound + 1, last, compare, swap_particle_data);
-				}
-			}
-
-			/*
-			Description : Insertsort in Iterator format
-			Link        : http://www.codecodex.com/wiki/Insertion_sort
-			*/
-
-			template< typename RandomAccessIterator, typename Compare, typename SwapType>
-			void InsertionSort(RandomAccessIterator First, RandomAccessIterator Last, Compare& compare, SwapType& swap_particle_data)
-			{
-				RandomAccessIterator min = First;
-				for (RandomAccessIterator i = First + 1; i < Last; ++i)
-					if (compare(*i, *min)) min = i;
-
-				swap_particle_data(First, min);
-				while (++First < Last)
-					for (RandomAccessIterator j = First; compare(*j, *(j - 1)); --j)
-						swap_particle_data((j - 1), j);
-			}
-
-			/** Body class used to sort elements in a range that is smaller than the grainsize. */
-			template<typename RandomAccessIterator, typename Compare, typename SwapType>
-			struct QuickSortParticleBody {
-				void operator()(const QuickSortParticleRange<RandomAccessIterator, Compare, SwapType>& range) const {
-					SerialQuickSort(range.begin_, range.begin_ + range.size_, range.comp_, range.swap_particle_data_);
-				}
-			};
-
-		}
-	}
-}
+#include <atomic>
 
 namespace SPH {
 
@@ -188,36 +45,56 @@ namespace SPH {
 	class Kernel;
 
 	/**
-	 * @class CompareParticleSequence
-	 * @brief compare the sequence of two particles
-	 */
-	struct CompareParticleSequence 
-	{ 
-		bool operator () (const size_t& x, const size_t& y) const 
-		{ return x < y; }; 
-	};
-
-	/**
-	 * @class SwapParticleData
-	 * @brief swap sortable particle data according to a sequence
+	 * @class SortParticleData
+	 * @brief Sort the sortable particle data according to the sequence.
+	 * A parallel least-significant-digit radix sort on the sequence gives a permutation,
+	 * then each sortable variable is gathered once through a reusable scratch buffer.
+	 * The radix sort is stable and its blocks are fixed, so that the result is deterministic.
 	 */
-	class SwapParticleData
+	class SortParticleData
 	{
 	protected:
+		/** number of bits and buckets of a radix digit */
+		static const size_t radix_bits_ = 8;
+		static const size_t radix_ = 256;
+		/** number of particles of a block with its own digit counts */
+		static const size_t block_size_ = 4096;
+
 		StdLargeVec<size_t>& sequence_;
+		StdLargeVec<size_t>& sorted_id_;
 		StdLargeVec<size_t>& unsorted_id_;
 		StdVec<StdLargeVec<Matd>*>& sortable_matrices_;
 		StdVec<StdLargeVec<Vecd>*>& sortable_vectors_;
 		StdVec<StdLargeVec<Real>*>& sortable_scalars_;
 
+		/** the new position of a particle is given by its old index in permutation */
+		StdLargeVec<size_t> permutation_;
+		/** buffers for the radix sort passes, also used as index scratch buffer */
+		StdLargeVec<size_t> sequence_buffer_;
+		StdLargeVec<size_t> permutation_buffer_;
+		/** digit counts and then offsets of the blocks */
+		StdLargeVec<size_t> block_digit_counts_;
+		/** scratch buffers for gathering sortable variables */
+		StdLargeVec<Matd> matrix_buffer_;
+		StdLargeVec<Vecd> vector_buffer_;
+		StdLargeVec<Real> scalar_buffer_;
+
+		/** sort the sequence and obtain the permutation */
+		void radixSortSequence(size_t number_of_particles);
+		/** gather a variable according to the permutation */
+		template<class VariableType>
+		void gatherParticleData(StdLargeVec<VariableType>& variable,
+			StdLargeVec<VariableType>& buffer, size_t number_of_particles);
+		/** update unsorted and sorted ids according to the permutation */
+		void gatherParticleIds(size_t number_of_particles);
 	public:
-		SwapParticleData(BaseParticles* base_particles);
-		~SwapParticleData() {};
+		explicit SortParticleData(BaseParticles* base_particles);
+		virtual ~SortParticleData() {};
 
-		/** the operater overload for swapping particle data.
-		 *  the arguments are the same with std::iter_swap
-		 */
-		void operator () (size_t* a, size_t* b);
+		/** sort particle data with the sequence computed already */
+		void sortingParticleData(size_t number_of_particles);
+		/** add the memory records of the permutation and the scratch buffers */
+		void accountMemory(MemoryFootprint& footprint);
 	};
 
 	/**
@@ -233,11 +110,21 @@ namespace SPH {
 		CellListDataVector cell_list_data_;
 		/** the index vector for real particles. */
 		IndexVector real_particle_indexes_;
+		/** the mesh index of the cell, given when the cell is put into the split cell lists */
+		Vecu cell_index_;
 
 		CellList();
 		~CellList() {};
+
+		/** bytes of the cell and its current particle indexes and list data */
+		size_t UsedBytes();
+		/** bytes of the cell and the capacities of its particle indexes and list data */
+		size_t AllocatedBytes();
 	};
 
+	/** space-filling curves giving the sequence of sorted particle data */
+	enum class SpaceFillingCurve { morton, hilbert, row_major };
+
 	/**
 	 * @class BaseMeshCellLinkedList
 	 * @brief Abstract class for mesh cell linked list.
@@ -248,14 +135,13 @@ namespace SPH {
 		SPHBody* body_;
 		BaseParticles* base_particles_;
 		Kernel* kernel_;
-		SwapParticleData* swap_particle_data_;
-		CompareParticleSequence compare_;
-		tbb::interafce9::internal::
-			QuickSortParticleRange<size_t*, CompareParticleSequence, SwapParticleData>* 
-			quick_sort_particle_range_;
-		tbb::interafce9::internal::
-			QuickSortParticleBody<size_t*, CompareParticleSequence, SwapParticleData> 
-			quick_sort_particle_body_;
+		SortParticleData* sort_particle_data_;
+		/** increased when the split cell lists are cleared for rebuilding */
+		size_t split_cell_lists_version_;
+		/** the curve along which the particle data are sorted, Morton by default */
+		SpaceFillingCurve space_filling_curve_;
+		/** number of bits of the cell index in each direction for the Hilbert order */
+		size_t hilbert_order_bits_;
 
 		/** clear the cell lists */
 		void ClearCellLists(Vecu& number_of_cells, matrix_cell cell_linked_lists);
@@ -266,6 +152,9 @@ namespace SPH {
 			Vecu& number_of_cells, matrix_cell cell_linked_lists);
 		/** update cell linked list data in this mesh */
 		void UpdateCellListData(matrix_cell cell_linked_lists);
+		/** add the memory record of the cell lists in this mesh */
+		void accountCellListsMemory(MemoryFootprint& footprint, const std::string& name,
+			Vecu& number_of_cells, matrix_cell cell_linked_lists);
 	public:
 		/** The buffer size 2 used to expand computational domian for particle searching. */
 		BaseMeshCellLinkedList(SPHBody* body, Vecd lower_bound, Vecd upper_bound, 
@@ -274,7 +163,7 @@ namespace SPH {
 		BaseMeshCellLinkedList(SPHBody* body, 
 			Vecd mesh_lower_bound, Vecu number_of_cells, Real cell_spacing);
 		/**In the destructor, the dynamically located memory is released.*/
-		virtual ~BaseMeshCellLinkedList() {};
+		virtual ~BaseMeshCellLinkedList() { delete sort_particle_data_; };
 
 		/** computing search range for building contact configuration */
 		int computeSearchRange(int origin_refinement_level, int target_refinement_level);
@@ -282,8 +171,16 @@ namespace SPH {
 		Kernel& ChoosingKernel(Kernel* original_kernel, Kernel* target_kernel);
 		/** get the address of cell list */
 		virtual CellList* CellListFromIndex(Vecu cell_index) = 0;
+		/** find the cell list for neighbor search, NULL if the cell is not stored */
+		virtual CellList* findCellList(const Vecu& cell_index) { return CellListFromIndex(cell_index); };
 		/** Get the array for of mesh cell linked lists.*/
 		virtual matrix_cell CellLinkedLists() = 0;
+		/** the version of the split cell lists, changed when they are rebuilt */
+		size_t SplitCellListsVersion() { return split_cell_lists_version_; };
+		/** apply a function to the cell list data in the cells around a cell within the search range */
+		template<typename ListDataFunction>
+		void searchCellListDataAround(const Vecu& cell_index, int search_range,
+			const ListDataFunction& list_data_function);
 
 		/** Assign base particles to the mesh cell linked list. */
 		void assignBaseParticles(BaseParticles* base_particles);
@@ -304,9 +201,15 @@ namespace SPH {
 		virtual void sortingParticleData();
 		/** computing the sequence which indicate the order of sorted particle data */
 		virtual void computingSequence(StdLargeVec<size_t>& sequence) = 0;
+		/** choose the space-filling curve for sorting particle data */
+		void setSpaceFillingCurve(SpaceFillingCurve space_filling_curve);
+		SpaceFillingCurve getSpaceFillingCurve() { return space_filling_curve_; };
+		/** the position of a cell along the chosen space-filling curve */
+		size_t transferMeshIndexToSequence(const Vecu& cell_index);
 		/** update the reference of sorted data from unsorted data */
 		virtual void updateSortedId();
-
+		/** add the memory records of the cell lists, split cell lists and sorting buffers */
+		virtual void accountMemory(MemoryFootprint& footprint);
 	};
 
 	/**
@@ -344,6 +247,7 @@ namespace SPH {
 
 		/** update the cell lists */
 		virtual void UpdateCellLists() override;
+		virtual void accountMemory(MemoryFootprint& footprint) override;
 
 		/** output mesh data for visualization */
 		virtual void writeMeshToVtuFile(ofstream &output_file) override {};
@@ -359,6 +263,134 @@ namespace SPH {
 		virtual void computingSequence(StdLargeVec<size_t>& sequence) override;
 	};
 
+	/**
+	 * @class FlatMeshCellLinkedList
+	 * @brief A mesh cell linked list rebuilt by a counting sort.
+	 * The linear cell index of each particle is computed first,
+	 * the particles in each cell are counted and a parallel prefix sum gives the cell offsets.
+	 * Then the particle indexes are scattered into one flat array ordered by cells.
+	 * The cell lists are copied from the flat array without concurrent vector insertions,
+	 * so that rebuilding is free of memory allocation once the memories are warmed up.
+	 * As for the concurrent insertions, the order of the particles within a cell is not fixed.
+	 */
+	class FlatMeshCellLinkedList : public MeshCellLinkedList
+	{
+	protected:
+		/** linear cell index of each particle */
+		StdLargeVec<size_t> particle_cell_;
+		/** rank of each particle within its cell */
+		StdLargeVec<size_t> particle_rank_;
+		/** number of particles counted in each cell */
+		StdVec<std::atomic<size_t>> cell_counts_;
+		/** offsets of cells in the flat arrays, with one more entry than cells */
+		StdLargeVec<size_t> cell_offsets_;
+		/** particle indexes ordered by cells */
+		StdLargeVec<size_t> flat_particle_indexes_;
+
+		/** total number of cells of the mesh */
+		size_t TotalNumberOfCells();
+		/** count the particles in cells and scatter them into the flat array */
+		void sortParticlesIntoCells();
+		/** fill the cell lists and the split cell lists from the flat array */
+		void UpdateCellListsFromFlatData(SplitCellLists& split_cell_lists);
+	public:
+		FlatMeshCellLinkedList(SPHBody* body, Vecd lower_bound, Vecd upper_bound,
+			Real cell_spacing, size_t buffer_width = 2);
+		virtual ~FlatMeshCellLinkedList() {};
+
+		/** allcate memories for mesh data */
+		virtual void allocateMeshDataMatrix() override;
+
+		/** update the cell lists */
+		virtual void UpdateCellLists() override;
+		virtual void accountMemory(MemoryFootprint& footprint) override;
+	};
+
+	/**
+	 * @class SparseCellList
+	 * @brief The cell list of a sparse mesh cell linked list.
+	 */
+	class SparseCellList : public CellList
+	{
+	public:
+		/** the last rebuild of the cell lists in which the cell has real particles */
+		size_t occupied_generation_;
+		/** whether the address of the cell is given out, so that it is never evicted */
+		bool is_pinned_;
+
+		SparseCellList() : CellList(), occupied_generation_(0), is_pinned_(false) {};
+		~SparseCellList() {};
+	};
+
+	/**
+	 * @class SparseMeshCellLinkedList
+	 * @brief A mesh cell linked list only storing the occupied cells.
+	 * The cell lists are saved in a concurrent hash map keyed by the linear cell index,
+	 * so that the memory scales with the particles instead of the volume of the domain.
+	 * The particles are sorted by their cell keys to build the cell lists.
+	 * Each rebuild is a generation, with which the cells having real particles are stamped.
+	 * The cells without real particles for more than the eviction age are evicted,
+	 * except the cells whose addresses are given out by CellListFromIndex, such as the cells of body parts.
+	 */
+	class SparseMeshCellLinkedList : public BaseMeshCellLinkedList
+	{
+	protected:
+		/** hashed cell lists of the occupied cells */
+		tbb::concurrent_unordered_map<size_t, SparseCellList> cell_lists_;
+		/** pairs of linear cell index and particle index sorted by cells */
+		StdLargeVec<std::pair<size_t, size_t>> cell_particle_pairs_;
+		/** the number of rebuilds of the cell lists */
+		size_t generation_;
+		/** the number of rebuilds after which an empty cell is evicted */
+		size_t eviction_age_;
+
+		/** the key of a cell in the hash map */
+		size_t CellKey(const Vecu& cell_index) { return transferMeshIndexTo1D(number_of_cells_, cell_index); };
+		/** the split cell list of a cell for the cell splitting algorithm */
+		size_t SplitCellListIndex(size_t cell_key);
+		/** the stored or created cell, which is not pinned */
+		CellList* findOrCreateCellList(const Vecu& cell_index) { return &cell_lists_[CellKey(cell_index)]; };
+		/** remove the cells which are not pinned and have been empty for more than the eviction age */
+		void evictEmptyCells();
+	public:
+		SparseMeshCellLinkedList(SPHBody* body, Vecd lower_bound, Vecd upper_bound,
+			Real cell_spacing, size_t buffer_width = 2);
+		virtual ~SparseMeshCellLinkedList() {};
+
+		/** set the number of rebuilds after which an empty cell is evicted */
+		void setEvictionAge(size_t eviction_age) { eviction_age_ = SMAX(eviction_age, size_t(1)); };
+
+		/** access protected members, the cell is created if it is not stored and pinned */
+		virtual CellList* CellListFromIndex(Vecu cell_index) override;
+		/** find a stored cell list, NULL if the cell is not stored */
+		virtual CellList* findCellList(const Vecu& cell_index) override;
+		/** there is no mesh data array for the sparse cell linked list */
+		virtual matrix_cell CellLinkedLists() override { return NULL; };
+		/** number of cells stored in the hash map */
+		size_t NumberOfStoredCells() { return cell_lists_.size(); };
+
+		/** no mesh data matrix is allocated */
+		virtual void allocateMeshDataMatrix() override {};
+		virtual void deleteMeshDataMatrix() override { cell_lists_.clear(); };
+
+		/** update the cell lists */
+		virtual void UpdateCellLists() override;
+		virtual void accountMemory(MemoryFootprint& footprint) override;
+
+		/** output mesh data for visualization */
+		virtual void writeMeshToVtuFile(ofstream& output_file) override {};
+		virtual void writeMeshToPltFile(ofstream& output_file) override {};
+
+		/** Insert a cell-linked_list entry. */
+		void InsertACellLinkedParticleIndex(size_t particle_index, Vecd particle_position) override;
+		void InsertACellLinkedListDataEntry(size_t particle_index, Vecd particle_position) override;
+
+		/** find the nearest list data entry */
+		virtual ListData findNearestListDataEntry(Vecd& position) override;
+		/** computing the sequence which indicate the order of sorted particle data */
+		virtual void computingSequence(StdLargeVec<size_t>& sequence) override;
+	};
+
 	/**
 	  * @class MultilevelMeshCellLinkedList
 	  * @brief Defining a multimesh cell linked list for a body
@@ -406,6 +438,7 @@ namespace SPH {
 
 		/** update the cell lists */
 		virtual void UpdateCellLists() override;
+		virtual void accountMemory(MemoryFootprint& footprint) override;
 
 		/** Insert a cell-linked_list entry to the projected particle list. */
 		void InsertACellLinkedParticleIndex(size_t particle_index, Vecd particle_position) override;
@@ -38,6 +38,7 @@
 
 #include "base_mesh.h"
 #include "my_memory_pool.h"
+#include "memory_footprint.h"
 
 #include <fstream>
 #include <algorithm>
@@ -59,7 +60,7 @@ namespace SPH
 	using PackageFunctor = std::function<ReturnType(DataPackageType*, Real)>;
 	/** Iterator on a collection of mesh data packages. sequential computing. */
 	template <class DataPackageType>
-	void PackageIterator(ConcurrentVector<DataPackageType*> data_pkgs,
+	void PackageIterator(ConcurrentVector<DataPackageType*>& data_pkgs,
 		PackageFunctor<void, DataPackageType>& pkg_functor, Real dt = 0.0)
 	{
 		for (size_t i = 0; i != data_pkgs.size(); ++i)
@@ -68,7 +69,7 @@ namespace SPH
 	};
 	/** Iterator on a collection of mesh data packages. parallel computing. */
 	template <class DataPackageType>
-	void PackageIterator_parallel(ConcurrentVector<DataPackageType*> data_pkgs,
+	void PackageIterator_parallel(ConcurrentVector<DataPackageType*>& data_pkgs,
 		PackageFunctor<void, DataPackageType>& pkg_functor, Real dt = 0.0)
 	{
 		parallel_for(blocked_range<size_t>(0, data_pkgs.size()),
@@ -78,26 +79,57 @@ namespace SPH
 				}
 			}, ap);
 	};
+	/** Iterator on a collection of mesh data packages 
+	  * with the partitioner and grain size owned by the mesh. parallel computing. */
+	template <class DataPackageType>
+	void PackageIterator_parallel(ConcurrentVector<DataPackageType*>& data_pkgs,
+		PackageFunctor<void, DataPackageType>& pkg_functor, LoopPartitioner& loop_partitioner, Real dt = 0.0)
+	{
+		loop_partitioner.parallel_for(data_pkgs.size(),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					pkg_functor(data_pkgs[i], dt);
+				}
+			});
+	};
 	/** Package iterator for reducing. sequential computing. */
 	template <class ReturnType, typename ReduceOperation, class DataPackageType>
-	ReturnType ReducePackageIterator(ConcurrentVector<DataPackageType*> data_pkgs, ReturnType temp,
+	ReturnType ReducePackageIterator(ConcurrentVector<DataPackageType*>& data_pkgs, ReturnType temp,
 		PackageFunctor<ReturnType, DataPackageType>& reduce_pkg_functor, ReduceOperation& reduce_operation, Real dt = 0.0)
 	{
 		for (size_t i = 0; i < data_pkgs.size(); ++i)
 		{
-			temp = reduce_operation(temp, reduce_functor(data_pkgs[i], dt));
+			temp = reduce_operation(temp, reduce_pkg_functor(data_pkgs[i], dt));
 		}
 		return temp;
 	};
 	/** Package iterator for reducing. parallel computing. */
 	template <class ReturnType, typename ReduceOperation, class DataPackageType>
-	ReturnType ReducePackageIterator_parallel(ConcurrentVector<DataPackageType*> data_pkgs, ReturnType temp,
+	ReturnType ReducePackageIterator_parallel(ConcurrentVector<DataPackageType*>& data_pkgs, ReturnType temp,
 		PackageFunctor<ReturnType, DataPackageType>& reduce_pkg_functor, ReduceOperation& reduce_operation, Real dt = 0.0) {
 		return parallel_reduce(blocked_range<size_t>(0, data_pkgs.size()),
 			temp, [&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType
 			{
 				for (size_t i = r.begin(); i != r.end(); ++i) {
-					temp0 = reduce_operation(temp, reduce_functor(data_pkgs[i], dt));
+					temp0 = reduce_operation(temp0, reduce_pkg_functor(data_pkgs[i], dt));
+				}
+				return temp0;
+			},
+			[&](ReturnType x, ReturnType y)->ReturnType {
+				return reduce_operation(x, y);
+			}
+			);
+	};
+	/** Package iterator for reducing with the partitioner and grain size owned by the mesh. parallel computing. */
+	template <class ReturnType, typename ReduceOperation, class DataPackageType>
+	ReturnType ReducePackageIterator_parallel(ConcurrentVector<DataPackageType*>& data_pkgs, ReturnType temp,
+		PackageFunctor<ReturnType, DataPackageType>& reduce_pkg_functor, ReduceOperation& reduce_operation, 
+		LoopPartitioner& loop_partitioner, Real dt = 0.0) {
+		return loop_partitioner.parallel_reduce(data_pkgs.size(),
+			temp, [&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType
+			{
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					temp0 = reduce_operation(temp0, reduce_pkg_functor(data_pkgs[i], dt));
 				}
 				return temp0;
 			},
@@ -234,6 +266,8 @@ namespace SPH
 		 *@brief This function initialize the data packages with external information
 		 */
 		virtual void initializeDataPackages() = 0;
+		/** add the memory records of the data packages and their addresses */
+		virtual void accountMemory(MemoryFootprint& footprint) = 0;
 	};
 
 	/**
@@ -247,6 +281,7 @@ namespace SPH
 		MyMemoryPool<DataPackageType> data_pkg_pool_; 			 /**< memory pool for all packages in the mesh. */
 		MeshDataMatrix<DataPackageType*> data_pkg_addrs_; 	 /**< Address of data packages. */
 		ConcurrentVector<DataPackageType*> inner_data_pkgs_; /**< Inner data packages which is able to carry out spatial operations. */
+		LoopPartitioner inner_pkgs_partitioner_;	/**< Partitioner and grain size for the loops on the inner data packages. */
 
 		virtual void allocateMeshDataMatrix() override;	/**< allocate memories for addresses of data packages. */
 		virtual void deleteMeshDataMatrix() override; 	/**< delete memories for addresses of data packages. */
@@ -290,6 +325,19 @@ namespace SPH
 		 */
 		template<class DataType, typename PackageDataAddressType, PackageDataAddressType DataPackageType:: * MemPtr>
 		DataType probeMesh(Vecd& position);
+		/** the used packages are those allocated from the pool and not freed */
+		virtual void accountMemory(MemoryFootprint& footprint) override
+		{
+			size_t allocated_pkgs = data_pkg_pool_.capicity();
+			size_t used_pkgs = allocated_pkgs - data_pkg_pool_.available_node();
+			footprint.addRecord("level set", "data packages", used_pkgs * sizeof(DataPackageType),
+				allocated_pkgs * sizeof(DataPackageType));
+			size_t number_of_cells = 1;
+			for (size_t k = 0; k != this->number_of_cells_.size(); ++k) number_of_cells *= this->number_of_cells_[k];
+			footprint.addRecord("level set", "package addresses", number_of_cells * sizeof(DataPackageType*),
+				number_of_cells * sizeof(DataPackageType*));
+			footprint.addVector("level set", "inner packages", inner_data_pkgs_);
+		};
 	protected:
 		/** spacing of data in the data packages*/
 		Real data_spacing_;
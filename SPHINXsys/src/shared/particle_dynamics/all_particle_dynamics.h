@@ -1,4 +1,5 @@
 #pragma once
 
 #include "particle_dynamics_algorithms.h"
-#include "particle_dynamics_bodypart.h"
\ No newline at end of file
+#include "particle_dynamics_bodypart.h"
+#include "particle_dynamics_graph.h"
\ No newline at end of file
@@ -5,6 +5,8 @@
  */
 #include "base_particle_dynamics.h"
 #include "base_particle_dynamics.hpp"
+
+#include <unordered_map>
 //=============================================================================================//
 namespace SPH
 {
@@ -25,6 +27,17 @@ namespace SPH
 			}
 		}, ap);
 	}
+	//=============================================================================================//
+	void ParticleIterator_parallel(size_t number_of_particles, ParticleFunctor& particle_functor,
+		LoopPartitioner& loop_partitioner, Real dt)
+	{
+		loop_partitioner.parallel_for(number_of_particles,
+			[&](const blocked_range<size_t>& r) {
+			for (size_t i = r.begin(); i < r.end(); ++i) {
+				particle_functor(i, dt);
+			}
+		});
+	}
 	//=================================================================================================//
 	void ParticleIteratorSplittingSweep(SplitCellLists& split_cell_lists,
 		ParticleFunctor& particle_functor, Real dt)
@@ -95,6 +108,171 @@ namespace SPH
 			}, ap);
 		}
 	}
+	//=================================================================================================//
+	void ParticleIteratorSplitCellLists(SplitCellLists& split_cell_lists,
+		ParticleFunctor& particle_functor, Real dt)
+	{
+		for (size_t k = 0; k != split_cell_lists.size(); ++k) {
+			ConcurrentCellLists& cell_lists = split_cell_lists[k];
+			for (size_t l = 0; l != cell_lists.size(); ++l)
+			{
+				IndexVector& particle_indexes
+					= cell_lists[l]->real_particle_indexes_;
+				for (size_t i = 0; i != particle_indexes.size(); ++i)
+				{
+					particle_functor(particle_indexes[i], dt);
+				}
+			}
+		}
+	}
+	//=================================================================================================//
+	void ParticleIteratorSplitCellLists_parallel(SplitCellLists& split_cell_lists,
+		ParticleFunctor& particle_functor, Real dt)
+	{
+		for (size_t k = 0; k != split_cell_lists.size(); ++k) {
+			ConcurrentCellLists& cell_lists = split_cell_lists[k];
+			parallel_for(blocked_range<size_t>(0, cell_lists.size()),
+				[&](const blocked_range<size_t>& r) {
+					for (size_t l = r.begin(); l < r.end(); ++l) {
+						IndexVector& particle_indexes
+							= cell_lists[l]->real_particle_indexes_;
+						for (size_t i = 0; i < particle_indexes.size(); ++i)
+						{
+							particle_functor(particle_indexes[i], dt);
+						}
+					}
+				}, ap);
+		}
+	}
+	//=============================================================================================//
+	void SplittingSweepWavefront::buildDependence(BaseMeshCellLinkedList* mesh_cell_linked_list,
+		SplitCellLists& split_cell_lists)
+	{
+		mesh_cell_linked_list_ = mesh_cell_linked_list;
+		split_cell_lists_version_ = mesh_cell_linked_list->SplitCellListsVersion();
+
+		cells_.clear();
+		cell_colors_.clear();
+		for (size_t k = 0; k != split_cell_lists.size(); ++k)
+			for (size_t l = 0; l != split_cell_lists[k].size(); ++l)
+			{
+				cells_.push_back(split_cell_lists[k][l]);
+				cell_colors_.push_back(k);
+			}
+		size_t number_of_cells = cells_.size();
+		Vecu mesh_size = mesh_cell_linked_list->NumberOfCells();
+		std::unordered_map<size_t, size_t> cell_numbers;
+		for (size_t i = 0; i != number_of_cells; ++i)
+			cell_numbers[mesh_cell_linked_list->transferMeshIndexTo1D(mesh_size, cells_[i]->cell_index_)] = i;
+
+		successors_.resize(2 * number_of_cells);
+		predecessor_counts_.resize(2 * number_of_cells);
+		size_t dimension = mesh_size.size();
+		size_t number_of_offsets = 1;
+		for (size_t d = 0; d != dimension; ++d) number_of_offsets *= 5;
+		parallel_for(blocked_range<size_t>(0, number_of_cells),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+				{
+					StdVec<size_t>& forward_successors = successors_[i];
+					StdVec<size_t>& backward_successors = successors_[i + number_of_cells];
+					forward_successors.clear();
+					backward_successors.clear();
+					size_t forward_predecessors = 0;
+					size_t backward_predecessors = 0;
+					size_t color = cell_colors_[i];
+					/** the cells within two cells, including the cell itself */
+					for (size_t m = 0; m != number_of_offsets; ++m)
+					{
+						Vecu neighbor_index = cells_[i]->cell_index_;
+						bool is_inside = true;
+						for (size_t d = 0, offsets = m; d != dimension; ++d, offsets /= 5)
+						{
+							int index = (int)neighbor_index[d] + (int)(offsets % 5) - 2;
+							is_inside = is_inside && index >= 0 && index < (int)mesh_size[d];
+							neighbor_index[d] = is_inside ? index : 0;
+						}
+						if (!is_inside) continue;
+						auto neighbor = cell_numbers.find(mesh_cell_linked_list->transferMeshIndexTo1D(mesh_size, neighbor_index));
+						if (neighbor == cell_numbers.end()) continue;
+
+						size_t n = neighbor->second;
+						size_t neighbor_color = cell_colors_[n];
+						if (neighbor_color < color) forward_predecessors++;
+						if (neighbor_color > color) forward_successors.push_back(n);
+						if (neighbor_color >= color) forward_successors.push_back(n + number_of_cells);
+						if (neighbor_color < color) backward_successors.push_back(n + number_of_cells);
+						backward_predecessors++;
+					}
+					predecessor_counts_[i] = forward_predecessors;
+					predecessor_counts_[i + number_of_cells] = backward_predecessors;
+				}
+			}, ap);
+
+		starting_tasks_.clear();
+		for (size_t i = 0; i != number_of_cells; ++i)
+			if (predecessor_counts_[i] == 0) starting_tasks_.push_back(i);
+		StdVec<std::atomic<size_t>> remaining_predecessors(2 * number_of_cells);
+		remaining_predecessors_.swap(remaining_predecessors);
+	}
+	//=============================================================================================//
+	void SplittingSweepWavefront::runTask(size_t task, ParticleFunctor& particle_functor, Real dt, task_group& tasks)
+	{
+		size_t number_of_cells = cells_.size();
+		Real dt2 = dt * 0.5;
+		/** the task continues with one of its ready successors and spawns the others */
+		while (true)
+		{
+			IndexVector& particle_indexes = cells_[task % number_of_cells]->real_particle_indexes_;
+			if (task < number_of_cells)
+			{
+				for (size_t i = 0; i != particle_indexes.size(); ++i)
+					particle_functor(particle_indexes[i], dt2);
+			}
+			else
+			{
+				for (size_t i = particle_indexes.size(); i != 0; --i)
+					particle_functor(particle_indexes[i - 1], dt2);
+			}
+
+			size_t next_task = 2 * number_of_cells;
+			StdVec<size_t>& successors = successors_[task];
+			for (size_t s = 0; s != successors.size(); ++s)
+			{
+				size_t successor = successors[s];
+				if (remaining_predecessors_[successor].fetch_sub(1) == 1)
+				{
+					if (next_task == 2 * number_of_cells) next_task = successor;
+					else tasks.run([this, successor, &particle_functor, dt, &tasks]() 
+						{ runTask(successor, particle_functor, dt, tasks); });
+				}
+			}
+			if (next_task == 2 * number_of_cells) break;
+			task = next_task;
+		}
+	}
+	//=============================================================================================//
+	void SplittingSweepWavefront::parallel_exec(BaseMeshCellLinkedList* mesh_cell_linked_list,
+		SplitCellLists& split_cell_lists, ParticleFunctor& particle_functor, Real dt)
+	{
+		if (mesh_cell_linked_list != mesh_cell_linked_list_ 
+			|| mesh_cell_linked_list->SplitCellListsVersion() != split_cell_lists_version_)
+			buildDependence(mesh_cell_linked_list, split_cell_lists);
+
+		parallel_for(blocked_range<size_t>(0, predecessor_counts_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i)
+					remaining_predecessors_[i] = predecessor_counts_[i];
+			}, ap);
+
+		task_group tasks;
+		for (size_t i = 0; i != starting_tasks_.size(); ++i)
+		{
+			size_t task = starting_tasks_[i];
+			tasks.run([this, task, &particle_functor, dt, &tasks]() { runTask(task, particle_functor, dt, tasks); });
+		}
+		tasks.wait();
+	}
 	//=============================================================================================//
 }
 //=============================================================================================//
\ No newline at end of file
@@ -37,6 +37,7 @@
 #include "mesh_cell_linked_list.h"
 #include "external_force.h"
 #include "body_relation.h"
+#include "sph_profiler.h"
 #include <functional>
 
 using namespace std::placeholders;
@@ -53,6 +54,9 @@ namespace SPH
 	void ParticleIterator(size_t number_of_particles, ParticleFunctor &particle_functor, Real dt = 0.0);
 	/** Iterators for particle functors. parallel computing. */
 	void ParticleIterator_parallel(size_t number_of_particles, ParticleFunctor &particle_functor, Real dt = 0.0);
+	/** Iterators for particle functors with the partitioner and grain size of the caller. parallel computing. */
+	void ParticleIterator_parallel(size_t number_of_particles, ParticleFunctor& particle_functor,
+		LoopPartitioner& loop_partitioner, Real dt = 0.0);
 
 	/** Iterators for reduce functors. sequential computing. */
 	template <class ReturnType, typename ReduceOperation>
@@ -62,6 +66,46 @@ namespace SPH
 	template <class ReturnType, typename ReduceOperation>
 	ReturnType ReduceIterator_parallel(size_t number_of_particles, ReturnType temp,
 		ReduceFunctor<ReturnType> &reduce_functor, ReduceOperation &reduce_operation, Real dt = 0.0);
+	/** Iterators for reduce functors with the partitioner and grain size of the caller. parallel computing. */
+	template <class ReturnType, typename ReduceOperation>
+	ReturnType ReduceIterator_parallel(size_t number_of_particles, ReturnType temp,
+		ReduceFunctor<ReturnType>& reduce_functor, ReduceOperation& reduce_operation, 
+		LoopPartitioner& loop_partitioner, Real dt = 0.0);
+
+	/** Loops for particle functions known at compile time, which are inlined into the loop body.
+	  * The local function is called as local_function(index_i, dt). sequential computing. */
+	template <class LocalFunction>
+	void ParticleLoop(size_t number_of_particles, const LocalFunction& local_function, Real dt = 0.0);
+	/** Loops for particle functions known at compile time. parallel computing. */
+	template <class LocalFunction>
+	void ParticleLoop_parallel(size_t number_of_particles, const LocalFunction& local_function, Real dt = 0.0);
+	/** Loops for particle functions known at compile time with the partitioner and grain size of the caller. 
+	  * parallel computing. */
+	template <class LocalFunction>
+	void ParticleLoop_parallel(size_t number_of_particles, const LocalFunction& local_function,
+		LoopPartitioner& loop_partitioner, Real dt = 0.0);
+
+	/** Loops for reduce functions known at compile time. sequential computing. */
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation, Real dt = 0.0);
+	/** Loops for reduce functions known at compile time. parallel computing. */
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop_parallel(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation, Real dt = 0.0);
+	/** Loops for reduce functions known at compile time with the partitioner and grain size of the caller. 
+	  * parallel computing. */
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop_parallel(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation, 
+		LoopPartitioner& loop_partitioner, Real dt = 0.0);
+	/** Loops for reduce functions with the result independent of the number of threads and the scheduling.
+	  * The particles are reduced in fixed-size blocks and the block results in a fixed tree order. 
+	  * The local function can also be a reduce functor. parallel computing. */
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop_deterministic(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation, Real dt = 0.0, 
+		size_t block_size = 4096);
 
 	/** Iterators for particle functors with splitting. sequential computing. */
 	void ParticleIteratorSplittingSweep(SplitCellLists& split_cell_lists,
@@ -69,6 +113,49 @@ namespace SPH
 	/** Iterators for particle functors with splitting. parallel computing. */
 	void ParticleIteratorSplittingSweep_parallel(SplitCellLists& split_cell_lists,
 		ParticleFunctor& particle_functor, Real dt = 0.0);
+	/** Iterators for particle functors by split cell lists, each particle is visited once. sequential computing. */
+	void ParticleIteratorSplitCellLists(SplitCellLists& split_cell_lists,
+		ParticleFunctor& particle_functor, Real dt = 0.0);
+	/** Iterators for particle functors by split cell lists, each particle is visited once. 
+	  * Cells of the same split list are computed concurrently. parallel computing. */
+	void ParticleIteratorSplitCellLists_parallel(SplitCellLists& split_cell_lists,
+		ParticleFunctor& particle_functor, Real dt = 0.0);
+
+	/**
+	 * @class SplittingSweepWavefront
+	 * @brief Parallel splitting sweep without the barriers between the split cell lists.
+	 * The forward and backward sweeps of a cell are two tasks. A task depends on 
+	 * the latest earlier tasks of the cells within two cells from it, i.e. the cells whose 
+	 * particles may share neighbors with its particles, according to the order of the sweep. 
+	 * A task runs as soon as the tasks it depends on are done, 
+	 * and the result is the same as that of the sweep with barriers.
+	 * The dependence is rebuilt when the split cell lists are updated.
+	 */
+	class SplittingSweepWavefront
+	{
+	public:
+		SplittingSweepWavefront() : mesh_cell_linked_list_(NULL), split_cell_lists_version_(0) {};
+		virtual ~SplittingSweepWavefront() {};
+
+		void parallel_exec(BaseMeshCellLinkedList* mesh_cell_linked_list, SplitCellLists& split_cell_lists,
+			ParticleFunctor& particle_functor, Real dt = 0.0);
+	protected:
+		/** the mesh and the version of the split cell lists with which the dependence is built */
+		BaseMeshCellLinkedList* mesh_cell_linked_list_;
+		size_t split_cell_lists_version_;
+
+		/** the cells and their split cell list index, task i is the forward sweep 
+		  * and task i + number of cells is the backward sweep of the cell i */
+		StdVec<CellList*> cells_;
+		StdVec<size_t> cell_colors_;
+		StdVec<StdVec<size_t>> successors_;
+		StdVec<size_t> predecessor_counts_;
+		StdVec<std::atomic<size_t>> remaining_predecessors_;
+		StdVec<size_t> starting_tasks_;
+
+		void buildDependence(BaseMeshCellLinkedList* mesh_cell_linked_list, SplitCellLists& split_cell_lists);
+		void runTask(size_t task, ParticleFunctor& particle_functor, Real dt, task_group& tasks);
+	};
 
 
 	/** A Functor for Summation */
@@ -132,10 +219,22 @@ namespace SPH
 		  * One is for sequential execution, the other is for parallel. */
 		virtual ReturnType exec(Real dt = 0.0) = 0;
 		virtual ReturnType parallel_exec(Real dt = 0.0) = 0;
+
+		/** set a fixed grain size for the parallel particle loops */
+		void setGrainSize(size_t grain_size) { loop_partitioner_.setGrainSize(grain_size); };
+		/** tune the grain size of the parallel particle loops during the first executions */
+		void setGrainSizeTuning(StdVec<size_t> candidate_grain_sizes = { 1, 64, 256, 1024, 4096 },
+			size_t samples_per_candidate = 6)
+		{
+			loop_partitioner_.setGrainSizeTuning(candidate_grain_sizes, samples_per_candidate);
+		};
+		size_t GrainSize() { return loop_partitioner_.GrainSize(); };
 	protected:
 		SPHBody* sph_body_;
 		SplitCellLists& split_cell_lists_;
 		BaseMeshCellLinkedList* mesh_cell_linked_list_;
+		/** partitioner and grain size owned by the dynamics for its parallel particle loops */
+		LoopPartitioner loop_partitioner_;
 
 		void setBodyUpdated() { sph_body_->setNewlyUpdated(); };
 		/** the function for set global parameters for the particle dynamics */
@@ -199,7 +298,9 @@ namespace SPH
 			material_(dynamic_cast<MaterialType*>(body_->base_particles_->base_material_)),
 			sorted_id_(body_->base_particles_->sorted_id_),
 			unsorted_id_(body_->base_particles_->unsorted_id_),
-			inner_configuration_(body_inner_relation->inner_configuration_) {};
+			inner_configuration_(body_inner_relation->inner_configuration_),
+			use_compressed_configuration_(body_inner_relation->use_compressed_configuration_),
+			compressed_inner_configuration_(body_inner_relation->compressed_inner_configuration_) {};
 		virtual ~DataDelegateInner() {};
 	protected:
 		BodyType* body_;
@@ -210,6 +311,15 @@ namespace SPH
 
 		/** inner configuration of the designated body */
 		ParticleConfiguration& inner_configuration_;
+		bool use_compressed_configuration_;
+		CompressedParticleConfiguration& compressed_inner_configuration_;
+
+		/** the inner neighborhood of particle i from the configuration in use */
+		NeighborhoodView InnerNeighborhood(size_t index_i)
+		{
+			return use_compressed_configuration_ ? compressed_inner_configuration_[index_i]
+				: NeighborhoodView(inner_configuration_[index_i]);
+		};
 	};
 
 	/**
@@ -234,6 +344,15 @@ namespace SPH
 		StdVec<ContactMaterialType*>  contact_material_;
 		/** Configurations for particle interaction between bodies. */
 		ContatcParticleConfiguration& contact_configuration_;
+		bool use_compressed_configuration_;
+		CompressedContactParticleConfiguration& compressed_contact_configuration_;
+
+		/** the neighborhood of particle i in the contact body k from the configuration in use */
+		NeighborhoodView ContactNeighborhood(size_t k, size_t index_i)
+		{
+			return use_compressed_configuration_ ? compressed_contact_configuration_[k][index_i]
+				: NeighborhoodView(contact_configuration_[k][index_i]);
+		};
 	};
 
 	/**
@@ -266,5 +385,22 @@ namespace SPH
 		StdVec<ContactMaterialType*>  contact_material_;
 		/** Configurations for particle interaction between bodies. */
 		ContatcParticleConfiguration& contact_configuration_;
+
+		bool use_compressed_configuration_;
+		CompressedParticleConfiguration& compressed_inner_configuration_;
+		CompressedContactParticleConfiguration& compressed_contact_configuration_;
+
+		/** the inner neighborhood of particle i from the configuration in use */
+		NeighborhoodView InnerNeighborhood(size_t index_i)
+		{
+			return use_compressed_configuration_ ? compressed_inner_configuration_[index_i]
+				: NeighborhoodView(inner_configuration_[index_i]);
+		};
+		/** the neighborhood of particle i in the contact body k from the configuration in use */
+		NeighborhoodView ContactNeighborhood(size_t k, size_t index_i)
+		{
+			return use_compressed_configuration_ ? compressed_contact_configuration_[k][index_i]
+				: NeighborhoodView(contact_configuration_[k][index_i]);
+		};
 	};
 }
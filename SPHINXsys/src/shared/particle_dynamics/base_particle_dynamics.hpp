@@ -20,7 +20,9 @@ namespace SPH {
 	DataDelegateContact<BodyType, ParticlesType, MaterialType, ContactBodyType, ContactParticlesType, ContactMaterialType, BaseDataDelegateType>
 		::DataDelegateContact(SPHBodyContactRelation* body_contact_relation) :
 		BaseDataDelegateType(body_contact_relation->sph_body_),
-		contact_configuration_(body_contact_relation->contact_configuration_)
+		contact_configuration_(body_contact_relation->contact_configuration_),
+		use_compressed_configuration_(body_contact_relation->use_compressed_configuration_),
+		compressed_contact_configuration_(body_contact_relation->compressed_contact_configuration_)
 	{
 		SPHBodyVector contact_sph_bodies = body_contact_relation->contact_sph_bodies_;
 		for (size_t i = 0; i != contact_sph_bodies.size(); ++i) {
@@ -44,7 +46,10 @@ namespace SPH {
 		inner_configuration_(body_complex_relation->inner_configuration_),
 		sorted_id_(body_->base_particles_->sorted_id_),
 		unsorted_id_(body_->base_particles_->unsorted_id_),
-		contact_configuration_(body_complex_relation->contact_configuration_)
+		contact_configuration_(body_complex_relation->contact_configuration_),
+		use_compressed_configuration_(body_complex_relation->use_compressed_configuration_),
+		compressed_inner_configuration_(body_complex_relation->compressed_inner_configuration_),
+		compressed_contact_configuration_(body_complex_relation->compressed_contact_configuration_)
 	{
 		SPHBodyVector contact_sph_bodies = body_complex_relation->contact_sph_bodies_;
 		for (size_t i = 0; i != contact_sph_bodies.size(); ++i) {
@@ -82,5 +87,125 @@ namespace SPH {
 			);
 	}
 	//=================================================================================================//
+	template <class ReturnType, typename ReduceOperation>
+	ReturnType ReduceIterator_parallel(size_t number_of_particles, ReturnType temp,
+		ReduceFunctor<ReturnType>& reduce_functor, ReduceOperation& reduce_operation,
+		LoopPartitioner& loop_partitioner, Real dt)
+	{
+		return loop_partitioner.parallel_reduce(number_of_particles,
+			temp, [&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					temp0 = reduce_operation(temp0, reduce_functor(i, dt));
+				}
+				return temp0;
+			},
+			[&](ReturnType x, ReturnType y)->ReturnType {
+				return reduce_operation(x, y);
+			}
+			);
+	}
+	//=================================================================================================//
+	template <class LocalFunction>
+	void ParticleLoop(size_t number_of_particles, const LocalFunction& local_function, Real dt)
+	{
+		for (size_t i = 0; i < number_of_particles; ++i)
+			local_function(i, dt);
+	}
+	//=================================================================================================//
+	template <class LocalFunction>
+	void ParticleLoop_parallel(size_t number_of_particles, const LocalFunction& local_function, Real dt)
+	{
+		parallel_for(blocked_range<size_t>(0, number_of_particles),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i < r.end(); ++i) {
+					local_function(i, dt);
+				}
+			}, ap);
+	}
+	//=================================================================================================//
+	template <class LocalFunction>
+	void ParticleLoop_parallel(size_t number_of_particles, const LocalFunction& local_function,
+		LoopPartitioner& loop_partitioner, Real dt)
+	{
+		loop_partitioner.parallel_for(number_of_particles,
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i < r.end(); ++i) {
+					local_function(i, dt);
+				}
+			});
+	}
+	//=================================================================================================//
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation, Real dt)
+	{
+		for (size_t i = 0; i < number_of_particles; ++i)
+		{
+			temp = reduce_operation(temp, local_function(i, dt));
+		}
+		return temp;
+	}
+	//=================================================================================================//
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop_parallel(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation, Real dt)
+	{
+		return parallel_reduce(blocked_range<size_t>(0, number_of_particles),
+			temp, [&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					temp0 = reduce_operation(temp0, local_function(i, dt));
+				}
+				return temp0;
+			},
+			[&](ReturnType x, ReturnType y)->ReturnType {
+				return reduce_operation(x, y);
+			}
+			);
+	}
+	//=================================================================================================//
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop_parallel(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation,
+		LoopPartitioner& loop_partitioner, Real dt)
+	{
+		return loop_partitioner.parallel_reduce(number_of_particles,
+			temp, [&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					temp0 = reduce_operation(temp0, local_function(i, dt));
+				}
+				return temp0;
+			},
+			[&](ReturnType x, ReturnType y)->ReturnType {
+				return reduce_operation(x, y);
+			}
+			);
+	}
+	//=================================================================================================//
+	template <class ReturnType, class LocalFunction, typename ReduceOperation>
+	ReturnType ReduceLoop_deterministic(size_t number_of_particles, ReturnType temp,
+		const LocalFunction& local_function, ReduceOperation& reduce_operation, Real dt, size_t block_size)
+	{
+		size_t number_of_blocks = (number_of_particles + block_size - 1) / block_size;
+		if (number_of_blocks == 0) return temp;
+
+		StdVec<ReturnType> block_results(number_of_blocks);
+		parallel_for(blocked_range<size_t>(0, number_of_blocks),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t b = r.begin(); b != r.end(); ++b) {
+					size_t begin = b * block_size;
+					size_t end = SMIN(begin + block_size, number_of_particles);
+					ReturnType block_result = local_function(begin, dt);
+					for (size_t i = begin + 1; i != end; ++i)
+						block_result = reduce_operation(block_result, local_function(i, dt));
+					block_results[b] = block_result;
+				}
+			}, ap);
+
+		for (size_t stride = 1; stride < number_of_blocks; stride *= 2)
+			for (size_t b = 0; b + stride < number_of_blocks; b += 2 * stride)
+				block_results[b] = reduce_operation(block_results[b], block_results[b + stride]);
+		return reduce_operation(temp, block_results[0]);
+	}
+	//=================================================================================================//
 }
 //=================================================================================================//
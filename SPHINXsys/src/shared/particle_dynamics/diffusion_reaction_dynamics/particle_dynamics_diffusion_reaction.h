@@ -172,7 +172,7 @@ namespace SPH
 		virtual void Interaction(size_t index_i, Real dt = 0.0) override
 		{
 			DiffusionReactionParticles<BaseParticlesType, BaseMaterialType>* particles = this->particles_;
-			Neighborhood& inner_neighborhood = this->inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = this->InnerNeighborhood(index_i);
 
 			initializeDiffusionChangeRate(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
@@ -247,7 +247,7 @@ namespace SPH
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdVec<StdLargeVec<Real>>& species_n_k = *(contact_species_n_[k]);
 
-				Neighborhood& contact_neighborhood = this->contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = this->ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -38,7 +38,7 @@ namespace SPH
 		{
 			/** Inner interaction. */
 			Real pos_div = 0.0;
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 				pos_div -= inner_neighborhood.dW_ij_[n] 
 					* inner_neighborhood.r_ij_[n] * Vol_[inner_neighborhood.j_[n]];
@@ -47,7 +47,7 @@ namespace SPH
 			{
 				StdLargeVec<Real>& contact_mass_k = *(contact_mass_[k]);
 				Real contact_inv_rho_0_k = contact_inv_rho_0_[k];
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					pos_div -= contact_neighborhood.dW_ij_[n] * contact_neighborhood.r_ij_[n]
@@ -77,7 +77,7 @@ namespace SPH
 			Real inv_Vol_0_i = rho_0_ / mass_[index_i];
 			/** Inner interaction. */
 			Real sigma = W0_;
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 				sigma += inner_neighborhood.W_ij_[n];
 
@@ -86,7 +86,7 @@ namespace SPH
 			{
 				StdLargeVec<Real>& contact_mass_k = *(contact_mass_[k]);
 				Real contact_inv_rho_0_k = contact_inv_rho_0_[k];
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					sigma += contact_neighborhood.W_ij_[n] * inv_Vol_0_i
@@ -122,7 +122,7 @@ namespace SPH
 			/** Inner interaction. */
 			Vecd acceleration(0);
 			Vecd vel_derivative(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -140,7 +140,7 @@ namespace SPH
 			{
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -163,7 +163,7 @@ namespace SPH
 
 			/** Inner interaction. */
 			Vecd acceleration(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -183,7 +183,7 @@ namespace SPH
 			{
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -205,6 +205,68 @@ namespace SPH
 			dvel_dt_others_[index_i] += acceleration;
 		}
 		//=================================================================================================//
+		ViscousAccelerationPairwise::ViscousAccelerationPairwise(SPHBodyComplexRelation* body_complex_relation) :
+			PairwiseInteractionDynamics(body_complex_relation),
+			FluidDataDelegateComplex(body_complex_relation),
+			Vol_(particles_->Vol_), rho_n_(particles_->rho_n_),
+			vel_n_(particles_->vel_n_), dvel_dt_others_(particles_->dvel_dt_others_)
+		{
+			if (!body_complex_relation->InnerRelation()->isHalfConfiguration())
+			{
+				std::cout << "\n Error: ViscousAccelerationPairwise requires a half inner relation!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			for (size_t k = 0; k != contact_particles_.size(); ++k)
+			{
+				contact_Vol_.push_back(&(contact_particles_[k]->Vol_));
+				contact_vel_ave_.push_back(&(contact_particles_[k]->vel_ave_));
+			}
+			mu_ = material_->ReferenceViscosity();
+			smoothing_length_ = body_->kernel_->GetSmoothingLength();
+		}
+		//=================================================================================================//
+		void ViscousAccelerationPairwise::Interaction(size_t index_i, Real dt)
+		{
+			Real rho_i = rho_n_[index_i];
+			Real Vol_i = Vol_[index_i];
+			Vecd& vel_i = vel_n_[index_i];
+
+			/** Inner interaction, equal and opposite viscous forces to particle pair. */
+			Vecd acceleration(0);
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+
+				Vecd vel_derivative = (vel_i - vel_n_[index_j])
+					/ (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
+				Vecd pair_force = 2.0 * mu_ * vel_derivative * inner_neighborhood.dW_ij_[n];
+				acceleration += pair_force * Vol_[index_j] / rho_i;
+				dvel_dt_others_[index_j] -= pair_force * Vol_i / rho_n_[index_j];
+			}
+
+			/** Contact interaction. */
+			for (size_t k = 0; k < contact_configuration_.size(); ++k)
+			{
+				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
+				StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
+				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+				{
+					size_t index_j = contact_neighborhood.j_[n];
+					Real r_ij = contact_neighborhood.r_ij_[n];
+
+					Vecd vel_derivative = 2.0 * (vel_i - vel_ave_k[index_j]) / (r_ij + 0.01 * smoothing_length_);
+					acceleration += 2.0 * mu_ * vel_derivative
+						* contact_neighborhood.dW_ij_[n] * Vol_k[index_j] / rho_i;
+				}
+			}
+
+			/** Particle summation. */
+			dvel_dt_others_[index_i] += acceleration;
+		}
+		//=================================================================================================//
 		TransportVelocityCorrection
 			::TransportVelocityCorrection(SPHBodyComplexRelation* body_complex_relation, 
 				StdLargeVec<Vecd>& dvel_dt_trans) : 
@@ -232,7 +294,7 @@ namespace SPH
 
 			/** Inner interaction. */
 			Vecd acceleration_trans(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -246,7 +308,7 @@ namespace SPH
 			for (size_t k = 0; k < contact_configuration_.size(); ++k)
 			{
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -277,7 +339,7 @@ namespace SPH
 
 			/** Inner interaction. */
 			Vecd acceleration(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -293,7 +355,7 @@ namespace SPH
 			for (size_t k = 0; k < contact_configuration_.size(); ++k)
 			{
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -395,7 +457,7 @@ namespace SPH
 			Vecd& vel_i = vel_n_[index_i];
 
 			Vecd vorticity(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -441,7 +503,7 @@ namespace SPH
 			Vecd& vel_i = vel_n_[index_i];
 
 			Vecd acceleration = dvel_dt_others_[index_i];
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -463,7 +525,7 @@ namespace SPH
 				StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
 				StdLargeVec<Vecd>& dvel_dt_ave_k = *(contact_dvel_dt_ave_[k]);
 				StdLargeVec<Vecd>& n_k = *(contact_n_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -519,7 +581,7 @@ namespace SPH
 
 			Real density_change_rate = 0.0;
 			Vecd vel_star(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -541,7 +603,7 @@ namespace SPH
 				StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
 				StdLargeVec<Vecd>& dvel_dt_ave_k = *(contact_dvel_dt_ave_[k]);
 				StdLargeVec<Vecd>& n_k = *(contact_n_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -609,7 +671,7 @@ namespace SPH
 			Matd tau_i = tau_[index_i];
 
 			Vecd acceleration(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -623,7 +685,7 @@ namespace SPH
 			for (size_t k = 0; k < contact_configuration_.size(); ++k)
 			{
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -656,7 +718,7 @@ namespace SPH
 			Matd tau_i = tau_[index_i];
 
 			Matd stress_rate(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -672,7 +734,7 @@ namespace SPH
 			{
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -830,7 +892,7 @@ namespace SPH
 			// computing the  outer region values for near wall particles
 			if (contact_configuration_.size() != 0)
 			{
-				Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+				NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 				for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 				{
 					Vecd nablaW_ij = inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n];
@@ -846,7 +908,7 @@ namespace SPH
 				{
 					StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 					StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
-					Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+					NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 					{
 						Vecd nablaW_ij = contact_neighborhood.dW_ij_[n] * contact_neighborhood.e_ij_[n];
@@ -863,7 +925,7 @@ namespace SPH
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdLargeVec<Vecd>& vel_ave_k = *(contact_vel_ave_[k]);
 				StdLargeVec<Vecd>& n_k = *(contact_n_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				// solving inner region momentum balance equation in the tangential direction
 				// using outer region values as upper boundary conditions
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
@@ -895,6 +957,8 @@ namespace SPH
 		}
 		//=================================================================================================//
 	}		
+	//=================================================================================================//
+	template class InlinedParticleDynamicsReduce<fluid_dynamics::TotalMechanicalEnergy>;
 //=================================================================================================//
 }
 //=================================================================================================//
\ No newline at end of file
@@ -153,6 +153,30 @@ namespace SPH
 			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		 * @class ViscousAccelerationPairwise
+		 * @brief  the viscosity force induced acceleration computed pairwise,
+		 * the viscous force of a particle pair is evaluated only once.
+		 * The complex relation should be built with a SPHBodyHalfInnerRelation.
+		 */
+		class ViscousAccelerationPairwise
+			: public PairwiseInteractionDynamics, public FluidDataDelegateComplex
+		{
+		public:
+			ViscousAccelerationPairwise(SPHBodyComplexRelation* body_complex_relation);
+			virtual ~ViscousAccelerationPairwise() {};
+		protected:
+			//viscosity
+			Real mu_;
+			Real smoothing_length_;
+			StdLargeVec<Real> &Vol_, &rho_n_;
+			StdLargeVec<Vecd> &vel_n_, &dvel_dt_others_;
+			StdVec<StdLargeVec<Real>*> contact_Vol_;
+			StdVec<StdLargeVec<Vecd>*> contact_vel_ave_;
+
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		 * @class TransportVelocityCorrection
 		 * @brief  transport velocity correction
@@ -553,4 +577,6 @@ namespace SPH
 			virtual Real ReduceFunction(size_t index_i, Real dt = 0.0) override { return pos_n_[index_i][1]; };
 		};
 	}
+	/** The reduction is instantiated in the library, where its particle function is inlined. */
+	extern template class InlinedParticleDynamicsReduce<fluid_dynamics::TotalMechanicalEnergy>;
 }
@@ -45,7 +45,6 @@ namespace SPH {
 	BoundingBodyDomain::BoundingBodyDomain(SPHBody* body)
 		: ParticleDynamics<void>(body), DataDelegateSimple<SPHBody, BaseParticles>(body),
 		pos_n_(particles_->pos_n_),
-		cell_linked_lists_(mesh_cell_linked_list_->CellLinkedLists()),
 		number_of_cells_(mesh_cell_linked_list_->NumberOfCells()),
 		cell_spacing_(mesh_cell_linked_list_->CellSpacing()),
 		mesh_lower_bound_(mesh_cell_linked_list_->MeshLowerBound())
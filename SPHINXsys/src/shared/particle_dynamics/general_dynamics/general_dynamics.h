@@ -85,7 +85,6 @@ namespace SPH
 		virtual ~BoundingBodyDomain() {};
 	protected:
 		StdLargeVec<Vecd>& pos_n_;
-		matrix_cell cell_linked_lists_;
 		Vecu number_of_cells_;
 		Real cell_spacing_;
 		Vecd mesh_lower_bound_;
@@ -196,6 +195,8 @@ namespace SPH
 	 *	The first step is carried out before update cell linked list and
 	 *	the second after the updating.
 	 *	If the exec or parallel_exec is called directly, error message will be given.
+	 *	The periodic images are listed with the indices of the real particles,
+	 *	therefore, the body relations of the body can not have Verlet skin distance.
 	 */
 	class PeriodicConditionInAxisDirectionUsingCellLinkedList : 
 		public PeriodicConditionInAxisDirection
@@ -220,7 +221,10 @@ namespace SPH
 		PeriodicConditionInAxisDirectionUsingCellLinkedList(SPHBody* body, int axis_direction) :
 			PeriodicConditionInAxisDirection(body, axis_direction),
 			bounding_(this->periodic_translation_, this->bound_cells_, body, axis_direction),
-			update_cell_linked_list_(this->periodic_translation_, this->bound_cells_, body, axis_direction) {};
+			update_cell_linked_list_(this->periodic_translation_, this->bound_cells_, body, axis_direction)
+		{
+			body->setPeriodicImagesInCellLinkedList();
+		};
 		virtual ~PeriodicConditionInAxisDirectionUsingCellLinkedList() {};
 
 		PeriodicBounding bounding_;
@@ -485,7 +489,7 @@ namespace SPH
 	public:
 		DampingBySplittingAlgorithm(SPHBodyInnerRelation* body_inner_relation,
 			StdLargeVec<VariableType>& variable, Real eta) :
-			InteractionDynamicsSplitting(body_inner_relation->sph_body_),
+			InteractionDynamicsSplitting(body_inner_relation),
 			DataDelegateInner<SPHBody, BaseParticles, BaseMaterial>(body_inner_relation),
 			Vol_(particles_->Vol_), mass_(particles_->mass_), variable_(variable), eta_(eta) {};
 		virtual ~DampingBySplittingAlgorithm() {};
@@ -502,7 +506,7 @@ namespace SPH
 			VariableType error(0);
 			Real parameter_a(0);
 			Real parameter_c(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -554,7 +558,7 @@ namespace SPH
 	public:
 		DampingBySplittingPairwise(SPHBodyInnerRelation* body_inner_relation,
 			StdLargeVec<VariableType>& variable, Real eta) :
-			InteractionDynamicsSplitting(body_inner_relation->sph_body_),
+			InteractionDynamicsSplitting(body_inner_relation),
 			DataDelegateInner<SPHBody, BaseParticles, BaseMaterial>(body_inner_relation),
 			Vol_(particles_->Vol_), mass_(particles_->mass_), variable_(variable), eta_(eta) {};
 		virtual ~DampingBySplittingPairwise() {};
@@ -570,7 +574,7 @@ namespace SPH
 			VariableType& variable_i = variable_[index_i];
 
 			StdVec<Real> parameter_b(MaximumNeighborhoodSize);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			//forward sweep
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
@@ -70,8 +70,7 @@ namespace SPH
 				{
 					StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 					StdLargeVec<DataType>& data_k = *(contact_data_[k]);
-					Neighborhood& contact_neighborhood
-						= this->contact_configuration_[k][index_i];
+					NeighborhoodView contact_neighborhood = this->ContactNeighborhood(k, index_i);
 					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 					{
 						size_t index_j = contact_neighborhood.j_[n];
@@ -123,8 +122,7 @@ namespace SPH
 				{
 					StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 					StdLargeVec<Real>& data_k = *(contact_data_[k]);
-					Neighborhood& contact_neighborhood
-						= this->contact_configuration_[k][index_i];
+					NeighborhoodView contact_neighborhood = this->ContactNeighborhood(k, index_i);
 					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 					{
 						size_t index_j = contact_neighborhood.j_[n];
@@ -180,7 +178,7 @@ namespace SPH
 				{
 					StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 					StdLargeVec<DataType>& data_k = *(contact_data_[k]);
-					Neighborhood& contact_neighborhood = this->contact_configuration_[k][index_i];
+					NeighborhoodView contact_neighborhood = this->ContactNeighborhood(k, index_i);
 					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 					{
 						size_t index_j = contact_neighborhood.j_[n];
@@ -236,7 +234,7 @@ namespace SPH
 				{
 					StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 					StdLargeVec<Real>& data_k = *(contact_data_[k]);
-					Neighborhood& contact_neighborhood = this->contact_configuration_[k][index_i];
+					NeighborhoodView contact_neighborhood = this->ContactNeighborhood(k, index_i);
 					for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 					{
 						size_t index_j = contact_neighborhood.j_[n];
@@ -12,6 +12,7 @@ namespace SPH {
 	//=================================================================================================//
 	void ParticleDynamicsSimple::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
@@ -20,93 +21,192 @@ namespace SPH {
 	//=================================================================================================//
 	void ParticleDynamicsSimple::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
-		ParticleIterator_parallel(number_of_particles, functor_update_, dt);
+		ParticleIterator_parallel(number_of_particles, functor_update_, loop_partitioner_, dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamics::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->exec(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
-		ParticleIterator(number_of_particles, functor_interaction_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIterator(number_of_particles, functor_interaction_, dt);
+		}
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->exec(dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamics::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->parallel_exec(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
-		ParticleIterator_parallel(number_of_particles, functor_interaction_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIterator_parallel(number_of_particles, functor_interaction_, loop_partitioner_, dt);
+		}
+		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->parallel_exec(dt);
+	}
+	//=================================================================================================//
+	void PairwiseInteractionDynamics::exec(Real dt)
+	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
+		setBodyUpdated();
+		setupDynamics(dt);
+		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->exec(dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIteratorSplitCellLists(split_cell_lists_, functor_interaction_, dt);
+		}
+		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->exec(dt);
+	}
+	//=================================================================================================//
+	void PairwiseInteractionDynamics::parallel_exec(Real dt)
+	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
+		setBodyUpdated();
+		setupDynamics(dt);
+		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->parallel_exec(dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIteratorSplitCellLists_parallel(split_cell_lists_, functor_interaction_, dt);
+		}
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->parallel_exec(dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamicsWithUpdate::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->exec(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
-		ParticleIterator(number_of_particles, functor_interaction_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIterator(number_of_particles, functor_interaction_, dt);
+		}
 		ParticleIterator(number_of_particles, functor_update_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->exec(dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamicsWithUpdate::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->parallel_exec(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
-		ParticleIterator_parallel(number_of_particles, functor_interaction_, dt);
-		ParticleIterator_parallel(number_of_particles, functor_update_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIterator_parallel(number_of_particles, functor_interaction_, loop_partitioner_, dt);
+		}
+		ParticleIterator_parallel(number_of_particles, functor_update_, loop_partitioner_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->parallel_exec(dt);
 	}
 	//=================================================================================================//
 	void ParticleDynamics1Level::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
 		ParticleIterator(number_of_particles, functor_initialization_, dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->exec(dt);
-		ParticleIterator(number_of_particles, functor_interaction_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIterator(number_of_particles, functor_interaction_, dt);
+		}
 		ParticleIterator(number_of_particles, functor_update_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->exec(dt);
 	}
 	//=================================================================================================//
 	void ParticleDynamics1Level::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
+		setBodyUpdated();
+		setupDynamics(dt);
+		size_t number_of_particles = sph_body_->number_of_particles_;
+		ParticleIterator_parallel(number_of_particles, functor_initialization_, loop_partitioner_, dt);
+		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->parallel_exec(dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIterator_parallel(number_of_particles, functor_interaction_, loop_partitioner_, dt);
+		}
+		ParticleIterator_parallel(number_of_particles, functor_update_, loop_partitioner_, dt);
+		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->parallel_exec(dt);
+	}
+	//=================================================================================================//
+	void PairwiseParticleDynamics1Level::exec(Real dt)
+	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
+		setBodyUpdated();
+		setupDynamics(dt);
+		size_t number_of_particles = sph_body_->number_of_particles_;
+		ParticleIterator(number_of_particles, functor_initialization_, dt);
+		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->exec(dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIteratorSplitCellLists(split_cell_lists_, functor_interaction_, dt);
+		}
+		ParticleIterator(number_of_particles, functor_update_, dt);
+		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->exec(dt);
+	}
+	//=================================================================================================//
+	void PairwiseParticleDynamics1Level::parallel_exec(Real dt)
+	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		size_t number_of_particles = sph_body_->number_of_particles_;
-		ParticleIterator_parallel(number_of_particles, functor_initialization_, dt);
+		ParticleIterator_parallel(number_of_particles, functor_initialization_, loop_partitioner_, dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->parallel_exec(dt);
-		ParticleIterator_parallel(number_of_particles, functor_interaction_, dt);
-		ParticleIterator_parallel(number_of_particles, functor_update_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIteratorSplitCellLists_parallel(split_cell_lists_, functor_interaction_, dt);
+		}
+		ParticleIterator_parallel(number_of_particles, functor_update_, loop_partitioner_, dt);
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->parallel_exec(dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamicsSplitting::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->exec(dt);
-		ParticleIteratorSplittingSweep(split_cell_lists_, functor_interaction_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			ParticleIteratorSplittingSweep(split_cell_lists_, functor_interaction_, dt);
+		}
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->exec(dt);
 	}
 	//=================================================================================================//
 	void InteractionDynamicsSplitting::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t k = 0; k < pre_processes_.size(); ++k) pre_processes_[k]->parallel_exec(dt);
-		ParticleIteratorSplittingSweep_parallel(split_cell_lists_, functor_interaction_, dt);
+		{
+			InteractionLoopTimer interaction_loop_timer(typeid(*this), sph_body_);
+			if (use_wavefront_)
+			{
+				splitting_sweep_wavefront_.parallel_exec(sph_body_->mesh_cell_linked_list_,
+					split_cell_lists_, functor_interaction_, dt);
+			}
+			else
+			{
+				ParticleIteratorSplittingSweep_parallel(split_cell_lists_, functor_interaction_, dt);
+			}
+		}
 		for (size_t k = 0; k < post_processes_.size(); ++k) post_processes_[k]->parallel_exec(dt);
 	}
 	//=============================================================================================//
@@ -38,8 +38,14 @@
 #include "base_particle_dynamics.h"
 #include "base_particle_dynamics.hpp"
 
+#include <type_traits>
+#include <utility>
+
 namespace SPH 
 {
+	template <class ReturnType, typename ReduceOperation>
+	class FusedParticleDynamics1Level;
+
 	/**
 	* @class ParticleDynamicsSimple
 	* @brief Simple particle dynamics without considering particle interaction
@@ -66,14 +72,20 @@ namespace SPH
 	template <class ReturnType, typename ReduceOperation>
 		class ParticleDynamicsReduce : public ParticleDynamics<ReturnType>
 	{
+		template <class FusedReturnType, typename FusedReduceOperation>
+		friend class FusedParticleDynamics1Level;
 	public:
 		explicit ParticleDynamicsReduce(SPHBody* sph_body) :
 			ParticleDynamics<ReturnType>(sph_body), initial_reference_(),
-			functor_reduce_function_(std::bind(&ParticleDynamicsReduce::ReduceFunction, this, _1, _2)) {};
+			functor_reduce_function_(std::bind(&ParticleDynamicsReduce::ReduceFunction, this, _1, _2)),
+			deterministic_reduction_(false) {};
 		virtual ~ParticleDynamicsReduce() {};
 
+		typedef ReturnType ReduceReturnType;
+
 		virtual ReturnType exec(Real dt = 0.0) override
 		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
 			size_t number_of_particles = this->sph_body_->number_of_particles_;
 			this->setBodyUpdated();
 			SetupReduce();
@@ -83,13 +95,23 @@ namespace SPH
 		};
 		virtual ReturnType parallel_exec(Real dt = 0.0) override
 		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
 			size_t number_of_particles = this->sph_body_->number_of_particles_;
 			this->setBodyUpdated();
 			SetupReduce();
-			ReturnType temp = ReduceIterator_parallel(number_of_particles,
-				initial_reference_, functor_reduce_function_, reduce_operation_, dt);
+			ReturnType temp = deterministic_reduction_ 
+				? ReduceLoop_deterministic(number_of_particles, 
+					initial_reference_, functor_reduce_function_, reduce_operation_, dt)
+				: ReduceIterator_parallel(number_of_particles, initial_reference_, 
+					functor_reduce_function_, reduce_operation_, this->loop_partitioner_, dt);
 			return this->OutputResult(temp);
 		};
+
+		/** choose the parallel reduction with the result independent of the number of threads */
+		void setDeterministicReduction(bool deterministic_reduction) 
+		{ 
+			deterministic_reduction_ = deterministic_reduction; 
+		};
 	protected:
 		ReduceOperation reduce_operation_;
 
@@ -99,6 +121,7 @@ namespace SPH
 		virtual ReturnType ReduceFunction(size_t index_i, Real dt = 0.0) = 0;
 		virtual ReturnType OutputResult(ReturnType reduced_value) { return reduced_value; };
 		ReduceFunctor<ReturnType> functor_reduce_function_;
+		bool deterministic_reduction_;
 		};
 
 	/**
@@ -126,6 +149,30 @@ namespace SPH
 		ParticleFunctor functor_interaction_;
 	};
 
+	/**
+	* @class PairwiseInteractionDynamics
+	* @brief This is the class for particle interaction on a half inner configuration,
+	* in which each particle pair is listed only once (j > i). 
+	* The interaction applies equal and opposite contributions to both particles of a pair.
+	* The write races are avoided by computing the split cell lists one after another, 
+	* so that the concurrently computed cells do not share neighbor particles.
+	* Note that this requires the neighbors being in the adjacent cells, 
+	* so that the Verlet skin is refused for the relation.
+	*/
+	class PairwiseInteractionDynamics : public InteractionDynamics
+	{
+	public:
+		explicit PairwiseInteractionDynamics(SPHBodyBaseRelation* body_relation)
+			: InteractionDynamics(body_relation->sph_body_)
+		{
+			body_relation->setUsedBySplitCellDynamics();
+		};
+		virtual ~PairwiseInteractionDynamics() {};
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override;
+	};
+
 	/**
 	* @class InteractionDynamicsWithUpdate
 	* @brief This class includes an interaction and a update steps
@@ -152,6 +199,8 @@ namespace SPH
 	*/
 	class ParticleDynamics1Level : public InteractionDynamicsWithUpdate
 	{
+		template <class ReturnType, typename ReduceOperation>
+		friend class FusedParticleDynamics1Level;
 	public:
 		ParticleDynamics1Level(SPHBody* sph_body)
 			: InteractionDynamicsWithUpdate(sph_body),
@@ -166,18 +215,429 @@ namespace SPH
 		ParticleFunctor functor_initialization_;
 	};
 
+	/**
+	* @class PairwiseParticleDynamics1Level
+	* @brief This class includes an initialization, an interaction on a half inner configuration
+	* and a update steps. The interaction is computed on the split cell lists 
+	* as in PairwiseInteractionDynamics, the other steps as in ParticleDynamics1Level.
+	*/
+	class PairwiseParticleDynamics1Level : public ParticleDynamics1Level
+	{
+	public:
+		explicit PairwiseParticleDynamics1Level(SPHBodyBaseRelation* body_relation)
+			: ParticleDynamics1Level(body_relation->sph_body_)
+		{
+			body_relation->setUsedBySplitCellDynamics();
+		};
+		virtual ~PairwiseParticleDynamics1Level() {};
+
+		virtual void exec(Real dt = 0.0) override;
+		virtual void parallel_exec(Real dt = 0.0) override;
+	};
+
+	/**
+	* @class FusedParticleDynamics1Level
+	* @brief Fused execution of two 1-level dynamics, such as the first and second halves 
+	* of pressure or stress relaxation, and a following reduce dynamics, such as the time step size.
+	* The particles are blocked into cache-sized tiles of consecutive indexes, 
+	* which are compact in space as the particles are sorted in cell order.
+	* The steps only using the data of the particle itself are fused into the same tile sweep, 
+	* i.e. the update of the first dynamics with the initialization of the second,
+	* and the update of the second with the reduce function, 
+	* so that there are five instead of seven passes over the particle data.
+	* The results are the same as executing the three dynamics one after another.
+	* All the dynamics should be on the same body. If any of the 1-level dynamics has 
+	* pre or post processes or is pairwise, the dynamics are executed one after another without fusing.
+	*/
+	template <class ReturnType, typename ReduceOperation>
+	class FusedParticleDynamics1Level : public ParticleDynamics<ReturnType>
+	{
+	public:
+		FusedParticleDynamics1Level(ParticleDynamics1Level* first_dynamics, ParticleDynamics1Level* second_dynamics,
+			ParticleDynamicsReduce<ReturnType, ReduceOperation>* reduce_dynamics, size_t tile_size = 1024) :
+			ParticleDynamics<ReturnType>(first_dynamics->sph_body_), first_dynamics_(first_dynamics),
+			second_dynamics_(second_dynamics), reduce_dynamics_(reduce_dynamics), tile_size_(tile_size) {};
+		virtual ~FusedParticleDynamics1Level() {};
+
+		/** execute both dynamics with the time step size dt and return the reduced result */
+		virtual ReturnType exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			if (!isFusible())
+			{
+				first_dynamics_->exec(dt);
+				second_dynamics_->exec(dt);
+				return reduce_dynamics_->exec();
+			}
+
+			size_t number_of_particles = this->sph_body_->number_of_particles_;
+			first_dynamics_->setBodyUpdated();
+			first_dynamics_->setupDynamics(dt);
+			for (size_t i = 0; i != number_of_particles; ++i)
+				first_dynamics_->Initialization(i, dt);
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*first_dynamics_), this->sph_body_);
+				for (size_t i = 0; i != number_of_particles; ++i)
+					first_dynamics_->Interaction(i, dt);
+			}
+
+			second_dynamics_->setBodyUpdated();
+			second_dynamics_->setupDynamics(dt);
+			for (size_t i = 0; i != number_of_particles; ++i)
+			{
+				first_dynamics_->Update(i, dt);
+				second_dynamics_->Initialization(i, dt);
+			}
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*second_dynamics_), this->sph_body_);
+				for (size_t i = 0; i != number_of_particles; ++i)
+					second_dynamics_->Interaction(i, dt);
+			}
+
+			reduce_dynamics_->setBodyUpdated();
+			reduce_dynamics_->SetupReduce();
+			ReturnType temp = reduce_dynamics_->initial_reference_;
+			for (size_t i = 0; i != number_of_particles; ++i)
+			{
+				second_dynamics_->Update(i, dt);
+				temp = reduce_dynamics_->reduce_operation_(temp, reduce_dynamics_->ReduceFunction(i));
+			}
+			return reduce_dynamics_->OutputResult(temp);
+		};
+
+		virtual ReturnType parallel_exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			if (!isFusible())
+			{
+				first_dynamics_->parallel_exec(dt);
+				second_dynamics_->parallel_exec(dt);
+				return reduce_dynamics_->parallel_exec();
+			}
+
+			blocked_range<size_t> tiles(0, this->sph_body_->number_of_particles_, tile_size_);
+			first_dynamics_->setBodyUpdated();
+			first_dynamics_->setupDynamics(dt);
+			parallel_for(tiles, [&](const blocked_range<size_t>& r) {
+					for (size_t i = r.begin(); i != r.end(); ++i)
+						first_dynamics_->Initialization(i, dt);
+				}, simple_partitioner());
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*first_dynamics_), this->sph_body_);
+				parallel_for(tiles, [&](const blocked_range<size_t>& r) {
+						for (size_t i = r.begin(); i != r.end(); ++i)
+							first_dynamics_->Interaction(i, dt);
+					}, simple_partitioner());
+			}
+
+			second_dynamics_->setBodyUpdated();
+			second_dynamics_->setupDynamics(dt);
+			parallel_for(tiles, [&](const blocked_range<size_t>& r) {
+					for (size_t i = r.begin(); i != r.end(); ++i) 
+					{
+						first_dynamics_->Update(i, dt);
+						second_dynamics_->Initialization(i, dt);
+					}
+				}, simple_partitioner());
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*second_dynamics_), this->sph_body_);
+				parallel_for(tiles, [&](const blocked_range<size_t>& r) {
+						for (size_t i = r.begin(); i != r.end(); ++i)
+							second_dynamics_->Interaction(i, dt);
+					}, simple_partitioner());
+			}
+
+			reduce_dynamics_->setBodyUpdated();
+			reduce_dynamics_->SetupReduce();
+			ReduceOperation& reduce_operation = reduce_dynamics_->reduce_operation_;
+			if (reduce_dynamics_->deterministic_reduction_)
+			{
+				ReturnType temp = ReduceLoop_deterministic(this->sph_body_->number_of_particles_,
+					reduce_dynamics_->initial_reference_, [&](size_t index_i, Real dt)->ReturnType {
+						second_dynamics_->Update(index_i, dt);
+						return reduce_dynamics_->ReduceFunction(index_i);
+					}, reduce_operation, dt, tile_size_);
+				return reduce_dynamics_->OutputResult(temp);
+			}
+			ReturnType temp = parallel_reduce(tiles, reduce_dynamics_->initial_reference_,
+				[&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType {
+					for (size_t i = r.begin(); i != r.end(); ++i)
+					{
+						second_dynamics_->Update(i, dt);
+						temp0 = reduce_operation(temp0, reduce_dynamics_->ReduceFunction(i));
+					}
+					return temp0;
+				},
+				[&](ReturnType x, ReturnType y)->ReturnType { return reduce_operation(x, y); },
+				simple_partitioner());
+			return reduce_dynamics_->OutputResult(temp);
+		};
+	protected:
+		ParticleDynamics1Level* first_dynamics_;
+		ParticleDynamics1Level* second_dynamics_;
+		ParticleDynamicsReduce<ReturnType, ReduceOperation>* reduce_dynamics_;
+		/** number of particles in a tile */
+		size_t tile_size_;
+
+		bool isFusible()
+		{
+			return first_dynamics_->pre_processes_.empty() && first_dynamics_->post_processes_.empty()
+				&& second_dynamics_->pre_processes_.empty() && second_dynamics_->post_processes_.empty()
+				&& dynamic_cast<PairwiseParticleDynamics1Level*>(first_dynamics_) == NULL
+				&& dynamic_cast<PairwiseParticleDynamics1Level*>(second_dynamics_) == NULL;
+		};
+	};
+
 	/**
 	 * @class InteractionDynamicsSplitting
 	 * @brief This is for the splitting algorithm
+	 * The parallel sweep is carried out either with a barrier after each split cell list (default)
+	 * or with the wavefront scheduling, in which a cell only waits for its neighbor cells.
+	 * Both require the neighbors within the adjacent cells, so that the skin is refused for the relation.
 	 */
 	class InteractionDynamicsSplitting : public InteractionDynamics
 	{
 	public:
-		explicit InteractionDynamicsSplitting(SPHBody* sph_body)
-			: InteractionDynamics(sph_body) {};
+		explicit InteractionDynamicsSplitting(SPHBodyBaseRelation* body_relation)
+			: InteractionDynamics(body_relation->sph_body_), use_wavefront_(false)
+		{
+			body_relation->setUsedBySplitCellDynamics();
+		};
 		virtual ~InteractionDynamicsSplitting() {};
 
+		/** choose the wavefront scheduling for the parallel sweep */
+		void setWavefrontScheduling(bool use_wavefront) { use_wavefront_ = use_wavefront; };
+
 		virtual void exec(Real dt = 0.0) override;
 		virtual void parallel_exec(Real dt = 0.0) override;
+	protected:
+		bool use_wavefront_;
+		SplittingSweepWavefront splitting_sweep_wavefront_;
+	};
+
+	/**
+	* @class InlinedParticleDynamicsSimple
+	* @brief Simple particle dynamics with the update step of the given dynamics class
+	* known at compile time. The update step is called with its qualified name, 
+	* i.e. without the functor and virtual function dispatch,
+	* so that it can be inlined into the particle loop and vectorized. 
+	* The virtual interface of the given dynamics class is kept unchanged.
+	* Usage: InlinedParticleDynamicsSimple<SomeSimpleDynamics> some_dynamics(constructor arguments).
+	*/
+	template <class DynamicsType>
+	class InlinedParticleDynamicsSimple : public DynamicsType
+	{
+	public:
+		template <typename... ConstructorArgs>
+		explicit InlinedParticleDynamicsSimple(ConstructorArgs&&... args) : DynamicsType(std::forward<ConstructorArgs>(args)...) {};
+		virtual ~InlinedParticleDynamicsSimple() {};
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			ParticleLoop(this->sph_body_->number_of_particles_,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Update(index_i, dt); }, dt);
+		};
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			ParticleLoop_parallel(this->sph_body_->number_of_particles_,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Update(index_i, dt); }, this->loop_partitioner_, dt);
+		};
+	};
+
+	/**
+	* @class InlinedParticleDynamicsReduce
+	* @brief Reduce dynamics with the reduce function of the given dynamics class
+	* known at compile time.
+	*/
+	template <class DynamicsType>
+	class InlinedParticleDynamicsReduce : public DynamicsType
+	{
+		typedef typename DynamicsType::ReduceReturnType ReturnType;
+	public:
+		template <typename... ConstructorArgs>
+		explicit InlinedParticleDynamicsReduce(ConstructorArgs&&... args) : DynamicsType(std::forward<ConstructorArgs>(args)...) {};
+		virtual ~InlinedParticleDynamicsReduce() {};
+
+		virtual ReturnType exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->SetupReduce();
+			ReturnType temp = ReduceLoop(this->sph_body_->number_of_particles_, this->initial_reference_,
+				[&](size_t index_i, Real dt)->ReturnType { return this->DynamicsType::ReduceFunction(index_i, dt); },
+				this->reduce_operation_, dt);
+			return this->OutputResult(temp);
+		};
+		virtual ReturnType parallel_exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->SetupReduce();
+			auto reduce_function = [&](size_t index_i, Real dt)->ReturnType 
+				{ return this->DynamicsType::ReduceFunction(index_i, dt); };
+			ReturnType temp = this->deterministic_reduction_
+				? ReduceLoop_deterministic(this->sph_body_->number_of_particles_, this->initial_reference_,
+					reduce_function, this->reduce_operation_, dt)
+				: ReduceLoop_parallel(this->sph_body_->number_of_particles_, this->initial_reference_,
+					reduce_function, this->reduce_operation_, this->loop_partitioner_, dt);
+			return this->OutputResult(temp);
+		};
+	};
+
+	/**
+	* @class InlinedInteractionDynamics
+	* @brief Interaction dynamics with the interaction step of the given dynamics class
+	* known at compile time.
+	*/
+	template <class DynamicsType>
+	class InlinedInteractionDynamics : public DynamicsType
+	{
+		static_assert(!std::is_base_of<PairwiseInteractionDynamics, DynamicsType>::value
+			&& !std::is_base_of<PairwiseParticleDynamics1Level, DynamicsType>::value
+			&& !std::is_base_of<InteractionDynamicsSplitting, DynamicsType>::value,
+			"The split cell dynamics are not inlined, as the inlined loops do not follow the split cell lists.");
+	public:
+		template <typename... ConstructorArgs>
+		explicit InlinedInteractionDynamics(ConstructorArgs&&... args) : DynamicsType(std::forward<ConstructorArgs>(args)...) {};
+		virtual ~InlinedInteractionDynamics() {};
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k) this->pre_processes_[k]->exec(dt);
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*this), this->sph_body_);
+				ParticleLoop(this->sph_body_->number_of_particles_,
+					[&](size_t index_i, Real dt) { this->DynamicsType::Interaction(index_i, dt); }, dt);
+			}
+			for (size_t k = 0; k < this->post_processes_.size(); ++k) this->post_processes_[k]->exec(dt);
+		};
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k) this->pre_processes_[k]->parallel_exec(dt);
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*this), this->sph_body_);
+				ParticleLoop_parallel(this->sph_body_->number_of_particles_,
+					[&](size_t index_i, Real dt) { this->DynamicsType::Interaction(index_i, dt); }, this->loop_partitioner_, dt);
+			}
+			for (size_t k = 0; k < this->post_processes_.size(); ++k) this->post_processes_[k]->parallel_exec(dt);
+		};
+	};
+
+	/**
+	* @class InlinedInteractionDynamicsWithUpdate
+	* @brief Interaction dynamics with the interaction and update steps of the given dynamics class
+	* known at compile time.
+	*/
+	template <class DynamicsType>
+	class InlinedInteractionDynamicsWithUpdate : public DynamicsType
+	{
+		static_assert(!std::is_base_of<PairwiseInteractionDynamics, DynamicsType>::value
+			&& !std::is_base_of<PairwiseParticleDynamics1Level, DynamicsType>::value
+			&& !std::is_base_of<InteractionDynamicsSplitting, DynamicsType>::value,
+			"The split cell dynamics are not inlined, as the inlined loops do not follow the split cell lists.");
+	public:
+		template <typename... ConstructorArgs>
+		explicit InlinedInteractionDynamicsWithUpdate(ConstructorArgs&&... args) : DynamicsType(std::forward<ConstructorArgs>(args)...) {};
+		virtual ~InlinedInteractionDynamicsWithUpdate() {};
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k) this->pre_processes_[k]->exec(dt);
+			size_t number_of_particles = this->sph_body_->number_of_particles_;
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*this), this->sph_body_);
+				ParticleLoop(number_of_particles,
+					[&](size_t index_i, Real dt) { this->DynamicsType::Interaction(index_i, dt); }, dt);
+			}
+			ParticleLoop(number_of_particles,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Update(index_i, dt); }, dt);
+			for (size_t k = 0; k < this->post_processes_.size(); ++k) this->post_processes_[k]->exec(dt);
+		};
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k) this->pre_processes_[k]->parallel_exec(dt);
+			size_t number_of_particles = this->sph_body_->number_of_particles_;
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*this), this->sph_body_);
+				ParticleLoop_parallel(number_of_particles,
+					[&](size_t index_i, Real dt) { this->DynamicsType::Interaction(index_i, dt); }, this->loop_partitioner_, dt);
+			}
+			ParticleLoop_parallel(number_of_particles,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Update(index_i, dt); }, this->loop_partitioner_, dt);
+			for (size_t k = 0; k < this->post_processes_.size(); ++k) this->post_processes_[k]->parallel_exec(dt);
+		};
+	};
+
+	/**
+	* @class InlinedParticleDynamics1Level
+	* @brief One level dynamics with the initialization, interaction and update steps 
+	* of the given dynamics class known at compile time.
+	*/
+	template <class DynamicsType>
+	class InlinedParticleDynamics1Level : public DynamicsType
+	{
+		static_assert(!std::is_base_of<PairwiseInteractionDynamics, DynamicsType>::value
+			&& !std::is_base_of<PairwiseParticleDynamics1Level, DynamicsType>::value
+			&& !std::is_base_of<InteractionDynamicsSplitting, DynamicsType>::value,
+			"The split cell dynamics are not inlined, as the inlined loops do not follow the split cell lists.");
+	public:
+		template <typename... ConstructorArgs>
+		explicit InlinedParticleDynamics1Level(ConstructorArgs&&... args) : DynamicsType(std::forward<ConstructorArgs>(args)...) {};
+		virtual ~InlinedParticleDynamics1Level() {};
+
+		virtual void exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			size_t number_of_particles = this->sph_body_->number_of_particles_;
+			ParticleLoop(number_of_particles,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Initialization(index_i, dt); }, dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k) this->pre_processes_[k]->exec(dt);
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*this), this->sph_body_);
+				ParticleLoop(number_of_particles,
+					[&](size_t index_i, Real dt) { this->DynamicsType::Interaction(index_i, dt); }, dt);
+			}
+			ParticleLoop(number_of_particles,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Update(index_i, dt); }, dt);
+			for (size_t k = 0; k < this->post_processes_.size(); ++k) this->post_processes_[k]->exec(dt);
+		};
+		virtual void parallel_exec(Real dt = 0.0) override
+		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
+			this->setBodyUpdated();
+			this->setupDynamics(dt);
+			size_t number_of_particles = this->sph_body_->number_of_particles_;
+			ParticleLoop_parallel(number_of_particles,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Initialization(index_i, dt); }, this->loop_partitioner_, dt);
+			for (size_t k = 0; k < this->pre_processes_.size(); ++k) this->pre_processes_[k]->parallel_exec(dt);
+			{
+				InteractionLoopTimer interaction_loop_timer(typeid(*this), this->sph_body_);
+				ParticleLoop_parallel(number_of_particles,
+					[&](size_t index_i, Real dt) { this->DynamicsType::Interaction(index_i, dt); }, this->loop_partitioner_, dt);
+			}
+			ParticleLoop_parallel(number_of_particles,
+				[&](size_t index_i, Real dt) { this->DynamicsType::Update(index_i, dt); }, this->loop_partitioner_, dt);
+			for (size_t k = 0; k < this->post_processes_.size(); ++k) this->post_processes_[k]->parallel_exec(dt);
+		};
 	};
 }
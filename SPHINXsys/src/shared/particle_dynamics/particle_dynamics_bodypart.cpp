@@ -11,6 +11,7 @@ namespace SPH {
 	//=================================================================================================//
 	void PartDynamicsByParticle::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t i = 0; i < constrained_particles_.size(); ++i)
@@ -21,6 +22,7 @@ namespace SPH {
 	//=================================================================================================//
 	void PartDynamicsByParticle::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		parallel_for(blocked_range<size_t>(0, constrained_particles_.size()),
@@ -33,6 +35,7 @@ namespace SPH {
 	//=================================================================================================//
 	void PartInteractionDynamicsByParticle::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t i = 0; i < body_part_particles_.size(); ++i)
@@ -43,6 +46,7 @@ namespace SPH {
 	//=================================================================================================//
 	void PartInteractionDynamicsByParticle::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		parallel_for(blocked_range<size_t>(0, body_part_particles_.size()),
@@ -55,6 +59,7 @@ namespace SPH {
 	//=================================================================================================//
 	void PartDynamicsByCell::exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		for (size_t i = 0; i != constrained_cells_.size(); ++i) {
@@ -65,6 +70,7 @@ namespace SPH {
 	//=================================================================================================//
 	void PartDynamicsByCell::parallel_exec(Real dt)
 	{
+		ProfilerSpan profiler_span(typeid(*this), sph_body_);
 		setBodyUpdated();
 		setupDynamics(dt);
 		parallel_for(blocked_range<size_t>(0, constrained_cells_.size()),
@@ -107,11 +107,13 @@ namespace SPH {
 	{
 	public:
 		PartDynamicsByCellReduce(SPHBody* sph_body, BodyPartByCell* body_part)
-			: ParticleDynamics<ReturnType>(sph_body), constrained_cells_(body_part->body_part_cells_) {};
+			: ParticleDynamics<ReturnType>(sph_body), constrained_cells_(body_part->body_part_cells_),
+			deterministic_reduction_(false) {};
 		virtual ~PartDynamicsByCellReduce() {};
 
 		virtual ReturnType exec(Real dt = 0.0) override
 		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
 			ReturnType temp = initial_reference_;
 			this->SetupReduce();
 			/** note that base member need to referred by pointer due to the template class has not been instantiated yet. */
@@ -128,9 +130,26 @@ namespace SPH {
 
 		virtual ReturnType parallel_exec(Real dt = 0.0) override
 		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
 			ReturnType temp = initial_reference_;
 			this->SetupReduce();
 			/** note that base member need to referred by pointer due to the template class has not been instantiated yet. */
+			if (deterministic_reduction_)
+			{
+				/** the cells are reduced in fixed blocks, each cell starting from the reference value */
+				temp = ReduceLoop_deterministic(constrained_cells_.size(), temp,
+					[&](size_t i, Real time_step)->ReturnType
+					{
+						ReturnType cell_result = initial_reference_;
+						CellListDataVector& list_data = constrained_cells_[i]->cell_list_data_;
+						for (size_t num = 0; num < list_data.size(); ++num)
+						{
+							cell_result = reduce_operation_(cell_result, ReduceFunction(list_data[num].first, time_step));
+						}
+						return cell_result;
+					}, reduce_operation_, dt, 256);
+				return OutputResult(temp);
+			}
 			temp = parallel_reduce(blocked_range<size_t>(0, constrained_cells_.size()),
 				temp,
 				[&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType
@@ -149,10 +168,17 @@ namespace SPH {
 
 			return OutputResult(temp);
 		};
+
+		/** choose the parallel reduction with the result independent of the number of threads */
+		void setDeterministicReduction(bool deterministic_reduction)
+		{
+			deterministic_reduction_ = deterministic_reduction;
+		};
 	protected:
 		ReduceOperation reduce_operation_;
 		CellLists& constrained_cells_;
 		ReturnType initial_reference_;
+		bool deterministic_reduction_;
 		virtual void SetupReduce() {};
 		virtual ReturnType ReduceFunction(size_t index_i, Real dt = 0.0) = 0;
 		virtual ReturnType OutputResult(ReturnType reduced_value) { return reduced_value; };
@@ -167,11 +193,12 @@ namespace SPH {
 	public:
 		PartDynamicsByParticleReduce(SPHBody* sph_body, BodyPartByParticle *body_part)
 			: ParticleDynamics<ReturnType>(sph_body),
-			constrained_particles_(body_part->body_part_particles_) {};
+			constrained_particles_(body_part->body_part_particles_), deterministic_reduction_(false) {};
 		virtual ~PartDynamicsByParticleReduce() {};
 
 		virtual ReturnType exec(Real dt = 0.0) override
 		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
 			ReturnType temp = initial_reference_;
 			this->SetupReduce();
 			//note that base member need to referred by pointer
@@ -184,10 +211,19 @@ namespace SPH {
 		};
 		virtual ReturnType parallel_exec(Real dt = 0.0) override
 		{
+			ProfilerSpan profiler_span(typeid(*this), this->sph_body_);
 			ReturnType temp = initial_reference_;
 			this->SetupReduce();
 			//note that base member need to referred by pointer
 			//due to the template class has not been instantiated yet
+			if (deterministic_reduction_)
+			{
+				temp = ReduceLoop_deterministic(constrained_particles_.size(), temp,
+					[&](size_t n, Real time_step)->ReturnType {
+						return ReduceFunction(constrained_particles_[n], time_step);
+					}, reduce_operation_, dt);
+				return OutputResult(temp);
+			}
 			temp = parallel_reduce(blocked_range<size_t>(0, constrained_particles_.size()),
 				temp,
 				[&](const blocked_range<size_t>& r, ReturnType temp0)->ReturnType {
@@ -203,10 +239,17 @@ namespace SPH {
 
 			return OutputResult(temp);
 		};
+
+		/** choose the parallel reduction with the result independent of the number of threads */
+		void setDeterministicReduction(bool deterministic_reduction)
+		{
+			deterministic_reduction_ = deterministic_reduction;
+		};
 	protected:
 		ReduceOperation reduce_operation_;
 
 		IndexVector& constrained_particles_;
+		bool deterministic_reduction_;
 
 		//inital or reference value
 		ReturnType initial_reference_;
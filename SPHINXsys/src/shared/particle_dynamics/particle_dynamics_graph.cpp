@@ -0,0 +1,87 @@
+/**
+* @file 	particle_dynamics_graph.cpp
+* @brief 	This is the implementation of the class for executing particle dynamics as a graph
+* @author	Chi ZHang and Xiangyu Hu
+* @version	0.1
+*/
+
+#include "particle_dynamics_graph.h"
+
+#include <set>
+
+namespace SPH {
+	//=================================================================================================//
+	ParticleDynamicsGraph::~ParticleDynamicsGraph()
+	{
+		graph_.wait_for_all();
+		for (size_t i = 0; i != task_nodes_.size(); ++i) delete task_nodes_[i];
+	}
+	//=================================================================================================//
+	void ParticleDynamicsGraph::addTask(std::function<void()> task, TaskData reads, TaskData writes)
+	{
+		size_t task_index = tasks_.size();
+		tasks_.push_back(task);
+		task_nodes_.push_back(new flow::continue_node<flow::continue_msg>(graph_,
+			[task](const flow::continue_msg&) { task(); }));
+
+		/** read after write, write after write and write after read. */
+		std::set<size_t> predecessors;
+		for (size_t i = 0; i != reads.size(); ++i)
+		{
+			DataAccess& data_access = data_accesses_[reads[i]];
+			if (data_access.writer_ >= 0) predecessors.insert(data_access.writer_);
+		}
+		for (size_t i = 0; i != writes.size(); ++i)
+		{
+			DataAccess& data_access = data_accesses_[writes[i]];
+			if (data_access.writer_ >= 0) predecessors.insert(data_access.writer_);
+			predecessors.insert(data_access.readers_.begin(), data_access.readers_.end());
+		}
+		predecessors.erase(task_index);
+
+		for (size_t i = 0; i != reads.size(); ++i)
+			data_accesses_[reads[i]].readers_.push_back(task_index);
+		for (size_t i = 0; i != writes.size(); ++i)
+		{
+			DataAccess& data_access = data_accesses_[writes[i]];
+			data_access.writer_ = (int)task_index;
+			data_access.readers_.clear();
+		}
+
+		if (predecessors.empty()) starting_tasks_.push_back(task_index);
+		for (std::set<size_t>::iterator it = predecessors.begin(); it != predecessors.end(); ++it)
+			flow::make_edge(*task_nodes_[*it], *task_nodes_[task_index]);
+	}
+	//=================================================================================================//
+	void ParticleDynamicsGraph::addDynamics(ParticleDynamics<void>* particle_dynamics,
+		TaskData reads, TaskData writes, Real* dt)
+	{
+		addTask([particle_dynamics, dt]() { particle_dynamics->parallel_exec(dt == NULL ? 0.0 : *dt); },
+			reads, writes);
+	}
+	//=================================================================================================//
+	void ParticleDynamicsGraph::addCellLinkedListUpdate(SPHBody* body)
+	{
+		addTask([body]() { body->updateCellLinkedList(); },
+			TaskData(), { body, body->mesh_cell_linked_list_ });
+	}
+	//=================================================================================================//
+	void ParticleDynamicsGraph::addConfigurationUpdate(SPHBodyBaseRelation* body_relation, TaskData reads)
+	{
+		addTask([body_relation]() { body_relation->updateConfiguration(); },
+			reads, { body_relation });
+	}
+	//=================================================================================================//
+	void ParticleDynamicsGraph::exec()
+	{
+		for (size_t i = 0; i != tasks_.size(); ++i) tasks_[i]();
+	}
+	//=================================================================================================//
+	void ParticleDynamicsGraph::parallel_exec()
+	{
+		for (size_t i = 0; i != starting_tasks_.size(); ++i)
+			task_nodes_[starting_tasks_[i]]->try_put(flow::continue_msg());
+		graph_.wait_for_all();
+	}
+	//=================================================================================================//
+}
@@ -0,0 +1,90 @@
+/* -------------------------------------------------------------------------*
+*								SPHinXsys									*
+* --------------------------------------------------------------------------*
+* SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle	*
+* Hydrodynamics for industrial compleX systems. It provides C++ APIs for	*
+* physical accurate simulation and aims to model coupled industrial dynamic *
+* systems including fluid, solid, multi-body dynamics and beyond with SPH	*
+* (smoothed particle hydrodynamics), a meshless computational method using	*
+* particle discretization.													*
+*																			*
+* SPHinXsys is partially funded by German Research Foundation				*
+* (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1				*
+* and HU1527/12-1.															*
+*                                                                           *
+* Portions copyright (c) 2017-2020 Technical University of Munich and		*
+* the authors' affiliations.												*
+*                                                                           *
+* Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+* not use this file except in compliance with the License. You may obtain a *
+* copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+*                                                                           *
+* --------------------------------------------------------------------------*/
+/**
+ * @file 	particle_dynamics_graph.h
+ * @brief 	This is the class for executing particle dynamics and other tasks as a graph.
+ * Each task declares the data it reads and writes. A task depends on an earlier added task
+ * if one of them writes data which the other reads or writes. 
+ * Tasks without such dependence are executed concurrently by a TBB flow graph,
+ * and the results are the same as executing all tasks in the order they are added.
+ * @author	Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+#pragma once
+
+#include "base_particle_dynamics.h"
+
+#include "tbb/flow_graph.h"
+
+#include <map>
+
+namespace SPH {
+
+	/** The data read or written by a task, identified by addresses, 
+	  * e.g. of a particle variable, a body for all its particle data, 
+	  * a mesh cell linked list or a body relation for its configuration. */
+	typedef StdVec<const void*> TaskData;
+
+	/**
+	 * @class ParticleDynamicsGraph
+	 * @brief Executing tasks, such as particle dynamics, cell linked list 
+	 * and configuration updates, as a dependency graph.
+	 */
+	class ParticleDynamicsGraph
+	{
+	public:
+		ParticleDynamicsGraph() {};
+		virtual ~ParticleDynamicsGraph();
+
+		/** add a task with the data it reads and writes */
+		void addTask(std::function<void()> task, TaskData reads, TaskData writes);
+		/** add a particle dynamics, executed with the time step size given by the address dt */
+		void addDynamics(ParticleDynamics<void>* particle_dynamics, 
+			TaskData reads, TaskData writes, Real* dt = NULL);
+		/** add a cell linked list update, which writes the body, as particles may be sorted, 
+		  * and its cell linked list */
+		void addCellLinkedListUpdate(SPHBody* body);
+		/** add a configuration update, which reads the given data and writes the relation */
+		void addConfigurationUpdate(SPHBodyBaseRelation* body_relation, TaskData reads);
+
+		/** execute the tasks one after another in the order they are added */
+		void exec();
+		/** execute the tasks concurrently according to the dependence */
+		void parallel_exec();
+	protected:
+		/** the latest writing task and the reading tasks after it of a data */
+		struct DataAccess
+		{
+			int writer_;
+			StdVec<size_t> readers_;
+			DataAccess() : writer_(-1) {};
+		};
+
+		StdVec<std::function<void()>> tasks_;
+		std::map<const void*, DataAccess> data_accesses_;
+		flow::graph graph_;
+		StdVec<flow::continue_node<flow::continue_msg>*> task_nodes_;
+		/** the tasks without depending on other tasks */
+		StdVec<size_t> starting_tasks_;
+	};
+}
@@ -41,7 +41,7 @@ namespace SPH
 		void RelaxationAccelerationInner::Interaction(size_t index_i, Real dt)
 		{
 			Vecd acceleration(0);// = -2.0 * complex_shape_->computeKernelIntegral(pos_n_[index_i], kernel_);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -74,7 +74,7 @@ namespace SPH
 		void RelaxationAccelerationComplex::Interaction(size_t index_i, Real dt)
 		{
 			Vecd acceleration(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -85,7 +85,7 @@ namespace SPH
 			for (size_t k = 0; k < contact_configuration_.size(); ++k)
 			{
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -33,7 +33,7 @@ namespace SPH
 			for (size_t k = 0; k < contact_configuration_.size(); ++k)
 			{
 				StdLargeVec<Real>& contact_mass_k = *(contact_mass_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					sigma += contact_neighborhood.W_ij_[n] * contact_mass_k[contact_neighborhood.j_[n]];
@@ -70,7 +70,7 @@ namespace SPH
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				Solid* solid_k = contact_material_[k];
 
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -87,7 +87,7 @@ namespace SPH
 		//=================================================================================================//
 		ContactForceFromFriction::ContactForceFromFriction(SPHBodyContactRelation* body_contact_relation,
 			StdLargeVec<Vecd>& vel_n, Real eta) :
-			InteractionDynamicsSplitting(body_contact_relation->sph_body_),
+			InteractionDynamicsSplitting(body_contact_relation),
 			ContactDynamicsDataDelegate(body_contact_relation),
 			Vol_(particles_->Vol_), mass_(particles_->mass_),
 			contact_force_(particles_->contact_force_), vel_n_(vel_n), eta_(eta)
@@ -116,7 +116,7 @@ namespace SPH
 				StdLargeVec<Real>& mass_k = *(contact_mass_[k]);
 				StdLargeVec<Vecd>& vel_n_k = *(contact_vel_n_[k]);
 				StdLargeVec<Vecd>& contact_force_k = *(contact_contact_force_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				//forward sweep
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
@@ -143,7 +143,7 @@ namespace SPH
 				StdLargeVec<Real>& mass_k = *(contact_mass_[k - 1]);
 				StdLargeVec<Vecd>& vel_n_k = *(contact_vel_n_[k - 1]);
 				StdLargeVec<Vecd>& contact_force_k = *(contact_contact_force_[k - 1]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k - 1][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k - 1, index_i);
 				//backward sweep
 				for (size_t n = contact_neighborhood.current_size_; n != 0; --n)
 				{
@@ -194,7 +194,7 @@ namespace SPH
 				Real smoothing_length_k = smoothing_length_[k];
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdLargeVec<Vecd>& vel_n_k = *(contact_vel_n_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -226,7 +226,7 @@ namespace SPH
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdLargeVec<Real>& rho_n_k = *(contact_rho_n_[k]);
 				StdLargeVec<Vecd>& vel_n_k = *(contact_vel_n_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -278,7 +278,7 @@ namespace SPH
 				StdLargeVec<Vecd>& vel_n_k = *(contact_vel_n_[k]);
 				StdLargeVec<Vecd>& dvel_dt_others_k = *(contact_dvel_dt_others_[k]);
 				Fluid* fluid_k = contact_material_[k];
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -358,7 +358,7 @@ namespace SPH
 		{
 			/** a small number added to diagonal to avoid divide zero */
 			Matd local_configuration(Eps);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -477,7 +477,7 @@ namespace SPH
 				StdLargeVec<Real>& Vol_k = *(contact_Vol_[k]);
 				StdLargeVec<Real>& rho_n_k = *(contact_rho_n_[k]);
 				StdLargeVec<Vecd>& vel_n_k = *(contact_vel_n_[k]);
-				Neighborhood& contact_neighborhood = contact_configuration_[k][index_i];
+				NeighborhoodView contact_neighborhood = ContactNeighborhood(k, index_i);
 				for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
 				{
 					size_t index_j = contact_neighborhood.j_[n];
@@ -530,7 +530,7 @@ namespace SPH
 			Vecd& pos_n_i = pos_n_[index_i];
 
 			Matd deformation(0.0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -578,7 +578,7 @@ namespace SPH
 			//including gravity and force from fluid
 			Vecd acceleration = dvel_dt_others_[index_i]
 				+ force_from_fluid_[index_i] / mass_[index_i];
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -595,6 +595,64 @@ namespace SPH
 			vel_n_[index_i] += dvel_dt_[index_i] * dt;
 		}
 		//=================================================================================================//
+		StressRelaxationFirstHalfPairwise::
+			StressRelaxationFirstHalfPairwise(SPHBodyInnerRelation* body_half_inner_relation) :
+			PairwiseParticleDynamics1Level(body_half_inner_relation),
+			ElasticSolidDataDelegateInner(body_half_inner_relation), Vol_(particles_->Vol_),
+			rho_n_(particles_->rho_n_), mass_(particles_->mass_),
+			pos_n_(particles_->pos_n_), vel_n_(particles_->vel_n_), dvel_dt_(particles_->dvel_dt_),
+			dvel_dt_others_(particles_->dvel_dt_others_), force_from_fluid_(particles_->force_from_fluid_),
+			B_(particles_->B_), F_(particles_->F_), dF_dt_(particles_->dF_dt_),
+			stress_(particles_->stress_)
+		{
+			if (!body_half_inner_relation->isHalfConfiguration())
+			{
+				std::cout << "\n Error: StressRelaxationFirstHalfPairwise requires a half inner relation!" << std::endl;
+				std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+				exit(1);
+			}
+			rho_0_ = material_->ReferenceDensity();
+			inv_rho_0_ = 1.0 / rho_0_;
+			numerical_viscosity_
+				= material_->getNumericalViscosity(body_->kernel_->GetSmoothingLength());
+		}
+		//=================================================================================================//
+		void StressRelaxationFirstHalfPairwise::Initialization(size_t index_i, Real dt)
+		{
+			F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+			rho_n_[index_i] = rho_0_ / det(F_[index_i]);
+			stress_[index_i] = F_[index_i] * (material_->ConstitutiveRelation(F_[index_i], index_i)
+				+ material_->NumericalDampingStress(F_[index_i], dF_dt_[index_i], numerical_viscosity_, index_i));
+			pos_n_[index_i] += vel_n_[index_i] * dt * 0.5;
+			/** the pair accelerations are accumulated onto gravity and force from fluid */
+			dvel_dt_[index_i] = dvel_dt_others_[index_i] + force_from_fluid_[index_i] / mass_[index_i];
+		}
+		//=================================================================================================//
+		void StressRelaxationFirstHalfPairwise::Interaction(size_t index_i, Real dt)
+		{
+			Matd stress_B_i = stress_[index_i] * B_[index_i];
+			Real Vol_i = Vol_[index_i];
+
+			Vecd acceleration(0);
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
+			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+			{
+				size_t index_j = inner_neighborhood.j_[n];
+
+				Vecd pair_acceleration = (stress_B_i + stress_[index_j] * B_[index_j])
+					* inner_neighborhood.dW_ij_[n] * inner_neighborhood.e_ij_[n] * inv_rho_0_;
+				acceleration += pair_acceleration * Vol_[index_j];
+				dvel_dt_[index_j] -= pair_acceleration * Vol_i;
+			}
+
+			dvel_dt_[index_i] += acceleration;
+		}
+		//=================================================================================================//
+		void StressRelaxationFirstHalfPairwise::Update(size_t index_i, Real dt)
+		{
+			vel_n_[index_i] += dvel_dt_[index_i] * dt;
+		}
+		//=================================================================================================//
 		void StressRelaxationSecondHalf::Initialization(size_t index_i, Real dt)
 		{
 			pos_n_[index_i] += vel_n_[index_i] * dt * 0.5;
@@ -605,7 +663,7 @@ namespace SPH
 			Vecd& vel_n_i = vel_n_[index_i];
 
 			Matd deformation_gradient_change_rate(0);
-			Neighborhood& inner_neighborhood = inner_configuration_[index_i];
+			NeighborhoodView inner_neighborhood = InnerNeighborhood(index_i);
 			for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
 			{
 				size_t index_j = inner_neighborhood.j_[n];
@@ -655,4 +713,8 @@ namespace SPH
 		}
 		//=================================================================================================//
 	}
+	//=================================================================================================//
+	template class InlinedParticleDynamics1Level<solid_dynamics::StressRelaxationFirstHalf>;
+	template class InlinedParticleDynamics1Level<solid_dynamics::StressRelaxationSecondHalf>;
+	//=================================================================================================//
 }
@@ -431,6 +431,31 @@ namespace SPH
 			virtual void Update(size_t index_i, Real dt = 0.0) override;
 		};
 
+		/**
+		* @class StressRelaxationFirstHalfPairwise
+		* @brief The first step of the stress relaxation on a half inner relation, 
+		* in which the pair acceleration is computed once and applied to both particles of the pair.
+		* The results are the same as StressRelaxationFirstHalf, 
+		* while the second step is still computed by StressRelaxationSecondHalf on the full inner relation.
+		*/
+		class StressRelaxationFirstHalfPairwise
+			: public PairwiseParticleDynamics1Level, public ElasticSolidDataDelegateInner
+		{
+		public:
+			StressRelaxationFirstHalfPairwise(SPHBodyInnerRelation* body_half_inner_relation);
+			virtual ~StressRelaxationFirstHalfPairwise() {};
+		protected:
+			Real rho_0_, inv_rho_0_;
+			StdLargeVec<Real>& Vol_, & rho_n_, & mass_;
+			StdLargeVec<Vecd>& pos_n_, & vel_n_, & dvel_dt_, & dvel_dt_others_, & force_from_fluid_;
+			StdLargeVec<Matd>& B_, & F_, & dF_dt_, & stress_;
+			Real numerical_viscosity_;
+
+			virtual void Initialization(size_t index_i, Real dt = 0.0) override;
+			virtual void Interaction(size_t index_i, Real dt = 0.0) override;
+			virtual void Update(size_t index_i, Real dt = 0.0) override;
+		};
+
 		/**
 		* @class StressRelaxationSecondHalf
 		* @brief computing stress relaxation process by verlet time stepping
@@ -497,4 +522,7 @@ namespace SPH
 			StdLargeVec<Vecd> pos_temp_;
 		};
 	}
+	/** The stress relaxation is instantiated in the library, where its particle functions are inlined. */
+	extern template class InlinedParticleDynamics1Level<solid_dynamics::StressRelaxationFirstHalf>;
+	extern template class InlinedParticleDynamics1Level<solid_dynamics::StressRelaxationSecondHalf>;
 }
@@ -14,13 +14,62 @@
 #include "base_material.h"
 #include "base_body.h"
 #include "all_particle_generators.h"
+#include "memory_footprint.h"
+#include "vtu_file_writer.h"
+#include "binary_restart_file.h"
+
+#include <functional>
 
 namespace SPH
 {
+	namespace
+	{
+		template<typename VariableType>
+		void accountVariablesMemory(MemoryFootprint& footprint, map<string, size_t>& name_map,
+			StdVec<StdLargeVec<VariableType>*>& registered_variables,
+			StdVec<StdLargeVec<VariableType>*>& sortable_variables)
+		{
+			for (auto& name_index : name_map)
+			{
+				StdLargeVec<VariableType>* variable = registered_variables[name_index.second];
+				bool is_sortable = std::find(sortable_variables.begin(), 
+					sortable_variables.end(), variable) != sortable_variables.end();
+				footprint.addVector(is_sortable ? "sortable particle variables" : "particle variables", 
+					name_index.first, *variable);
+			}
+		}
+
+		typedef std::function<void(const std::string&, char*, size_t, size_t)> RestartArrayFunction;
+		/** the arrays are named by their type and name, or index if they have no name */
+		template<typename VariableType>
+		void forEachRegisteredArray(const std::string& type_name, map<string, size_t>& name_map,
+			StdVec<StdLargeVec<VariableType>*>& registered_variables, const RestartArrayFunction& array_function)
+		{
+			StdVec<string> names(registered_variables.size());
+			for (auto& name_index : name_map) names[name_index.second] = name_index.first;
+			for (size_t i = 0; i != registered_variables.size(); ++i)
+			{
+				StdLargeVec<VariableType>& variable = *registered_variables[i];
+				array_function(type_name + ":" + (names[i].empty() ? std::to_string(i) : names[i]),
+					reinterpret_cast<char*>(variable.data()), sizeof(VariableType), variable.size());
+			}
+		}
+
+		void forEachRestartArray(BaseParticles& particles, const RestartArrayFunction& array_function)
+		{
+			forEachRegisteredArray("Matrix", particles.matrices_map_, particles.registered_matrices_, array_function);
+			forEachRegisteredArray("Vector", particles.vectors_map_, particles.registered_vectors_, array_function);
+			forEachRegisteredArray("Scalar", particles.scalars_map_, particles.registered_scalars_, array_function);
+			array_function("SortedID", reinterpret_cast<char*>(particles.sorted_id_.data()),
+				sizeof(size_t), particles.sorted_id_.size());
+			array_function("UnsortedID", reinterpret_cast<char*>(particles.unsorted_id_.data()),
+				sizeof(size_t), particles.unsorted_id_.size());
+		}
+	}
 	//=================================================================================================//
 	BaseParticles::BaseParticles(SPHBody* body, BaseMaterial* base_material) : 
 		base_material_(base_material), speed_max_(0.0), signal_speed_max_(0.0),
-		real_particles_bound_(0), number_of_ghost_particles_(0),
+		real_particles_bound_(0), number_of_ghost_particles_(0), sorting_count_(0),
 		body_(body), body_name_(body->GetBodyName())
 	{
 		body->assignBaseParticle(this);
@@ -122,71 +171,57 @@ namespace SPH
 		return expected_particle_index;
 	}
 	//=================================================================================================//
-	void BaseParticles::writeParticlesToVtuFile(ofstream& output_file)
+	void BaseParticles::writeParticlesToVtuFile(VtuFileWriter& vtu_file)
 	{
 		size_t number_of_particles = body_->number_of_particles_;
 
-		//write particle positions first
-		output_file << "   <Points>\n";
-		output_file << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
-		output_file << "    ";
-		for (size_t i = 0; i != number_of_particles; ++i) {
-			Vec3d particle_position = upgradeToVector3D(pos_n_[i]);
-			output_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
-		}
-		output_file << std::endl;
-		output_file << "    </DataArray>\n";
-		output_file << "   </Points>\n";
-
-		//write header of particles data
-		output_file << "   <PointData  Vectors=\"vector\">\n";
-
-		//write sorted particles ID
-		output_file << "    <DataArray Name=\"SortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
-		output_file << "    ";
-		for (size_t i = 0; i != number_of_particles; ++i) {
-			output_file << i << " ";
-		}
-		output_file << std::endl;
-		output_file << "    </DataArray>\n";
-
-		//write unsorted particles ID
-		output_file << "    <DataArray Name=\"UnsortedParticle_ID\" type=\"Int32\" Format=\"ascii\">\n";
-		output_file << "    ";
-		for (size_t i = 0; i != number_of_particles; ++i) {
-			output_file << unsorted_id_[i] << " ";
-		}
-		output_file << std::endl;
-		output_file << "    </DataArray>\n";
+		vtu_file.addPoints(pos_n_, number_of_particles);
+		vtu_file.addIndexPointData("SortedParticle_ID", number_of_particles, [](size_t i) { return i; });
+		vtu_file.addPointData("UnsortedParticle_ID", unsorted_id_, number_of_particles);
 
-		//write vectors
 		for (size_t l = 0; l != vectors_to_write_.size(); ++l) {
 			string variable_name = vectors_to_write_[l];
 			size_t variable_index_ = vectors_map_[variable_name];
-			StdLargeVec<Vecd>& variable = *(registered_vectors_[variable_index_]);
-			output_file << "    <DataArray Name=\"" << variable_name << "\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
-			output_file << "    ";
-			for (size_t i = 0; i != number_of_particles; ++i) {
-				Vec3d vector_value = upgradeToVector3D(variable[i]);
-				output_file << fixed << setprecision(9) << vector_value[0] << " " << vector_value[1] << " " << vector_value[2] << " ";
-			}
-			output_file << std::endl;
-			output_file << "    </DataArray>\n";
+			vtu_file.addPointData(variable_name, *(registered_vectors_[variable_index_]), number_of_particles);
 		}
-		
-		//write scalars
+
 		for (size_t l = 0; l != scalars_to_write_.size(); ++l) {
 			string variable_name = scalars_to_write_[l];
 			size_t variable_index_ = scalars_map_[variable_name];
-			StdLargeVec<Real>& variable = *(registered_scalars_[variable_index_]);
-			output_file << "    <DataArray Name=\"" << variable_name << "\" type=\"Float32\" Format=\"ascii\">\n";
-			output_file << "    ";
-			for (size_t i = 0; i != number_of_particles; ++i) {
-				output_file << fixed << setprecision(9) << variable[i] << " ";
-			}
-			output_file << std::endl;
-			output_file << "    </DataArray>\n";
+			vtu_file.addPointData(variable_name, *(registered_scalars_[variable_index_]), number_of_particles);
+		}
+	}
+	//=================================================================================================//
+	void BaseParticles::writeParticlesToBinaryForRestart(std::string& filefullpath, Real physical_time)
+	{
+		BinaryRestartWriter restart_file;
+		forEachRestartArray(*this, [&](const std::string& name, char* data, size_t element_size, size_t size) {
+			restart_file.addArray(name, data, element_size);
+			});
+		restart_file.writeToFile(filefullpath, body_name_, body_->number_of_particles_, physical_time);
+	}
+	//=================================================================================================//
+	void BaseParticles::readParticlesFromBinaryForRestart(std::string& filefullpath)
+	{
+		BinaryRestartReader restart_file(filefullpath);
+		if (restart_file.body_name_ != body_name_)
+		{
+			std::cout << "\n Error: the restart file " << filefullpath << " is for the body "
+				<< restart_file.body_name_ << " instead of " << body_name_ << std::endl;
+			exit(1);
+		}
+
+		size_t array_index = 0;
+		forEachRestartArray(*this, [&](const std::string& name, char* data, size_t element_size, size_t size) {
+			restart_file.copyArray(array_index++, name, data, element_size, size);
+			});
+		if (array_index != restart_file.arrays_.size())
+		{
+			std::cout << "\n Error: the restart file " << filefullpath << " has "
+				<< restart_file.arrays_.size() << " arrays instead of " << array_index << std::endl;
+			exit(1);
 		}
+		body_->number_of_particles_ = restart_file.number_of_particles_;
 	}
 	//=================================================================================================//
 	void BaseParticles::writeToXmlForReloadParticle(std::string &filefullpath)
@@ -227,9 +262,47 @@ namespace SPH
 		}
 	}
 	//=================================================================================================//
+	void BaseParticles::writeToBinaryForReloadParticle(std::string& filefullpath, const std::string& key)
+	{
+		BinaryRestartWriter reload_file;
+		reload_file.addArray("Vector:Position", reinterpret_cast<char*>(pos_n_.data()), sizeof(Vecd));
+		reload_file.addArray("Scalar:Volume", reinterpret_cast<char*>(Vol_.data()), sizeof(Real));
+		reload_file.writeToFile(filefullpath, body_name_, body_->number_of_particles_, 0.0, key);
+	}
+	//=================================================================================================//
+	void BaseParticles::readFromBinaryForReloadParticle(std::string& filefullpath, const std::string& key)
+	{
+		BinaryRestartReader reload_file(filefullpath);
+		if (reload_file.key_ != key)
+		{
+			std::cout << "\n Error: the reload file " << filefullpath << " was generated for another resolution or shape,"
+				<< " the particle relaxation should be run again." << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		if (reload_file.number_of_particles_ != pos_n_.size())
+		{
+			std::cout << "\n Error: reload particle number does not matrch" << std::endl;
+			std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+			exit(1);
+		}
+		reload_file.copyArray(0, "Vector:Position", reinterpret_cast<char*>(pos_n_.data()), sizeof(Vecd), pos_n_.size());
+		reload_file.copyArray(1, "Scalar:Volume", reinterpret_cast<char*>(Vol_.data()), sizeof(Real), Vol_.size());
+	}
+	//=================================================================================================//
 	BaseParticles* BaseParticles::pointToThisObject()
 	{
 		return this;
 	}
 	//=================================================================================================//
+	void BaseParticles::accountMemory(MemoryFootprint& footprint)
+	{
+		accountVariablesMemory(footprint, matrices_map_, registered_matrices_, sortable_matrices_);
+		accountVariablesMemory(footprint, vectors_map_, registered_vectors_, sortable_vectors_);
+		accountVariablesMemory(footprint, scalars_map_, registered_scalars_, sortable_scalars_);
+		footprint.addVector("particle sorting", "sequence", sequence_);
+		footprint.addVector("particle sorting", "sorted id", sorted_id_);
+		footprint.addVector("particle sorting", "unsorted id", unsorted_id_);
+	}
+	//=================================================================================================//
 }
@@ -117,6 +117,8 @@ namespace SPH {
 		StdLargeVec<size_t> sequence_;
 		StdLargeVec<size_t> sorted_id_;
 		StdLargeVec<size_t> unsorted_id_;
+		/** the number of times the particles have been sorted, i.e. their indexes have been changed */
+		size_t sorting_count_;
 		StdVec<StdLargeVec<Matd>*> sortable_matrices_;
 		StdVec<StdLargeVec<Vecd>*> sortable_vectors_;
 		StdVec<StdLargeVec<Real>*> sortable_scalars_;
@@ -135,7 +137,7 @@ namespace SPH {
 		size_t insertAGhostParticle(size_t index_i);
 
 		/** Write particle data in VTU format for Paraview. */
-		virtual void writeParticlesToVtuFile(ofstream &output_file);
+		virtual void writeParticlesToVtuFile(VtuFileWriter& vtu_file);
 		/** Write particle data in PLT format for Tecplot. */
 		virtual void writeParticlesToPltFile(ofstream& output_file) {};
 
@@ -143,14 +145,24 @@ namespace SPH {
 		virtual void writeParticlesToXmlForRestart(std::string& filefullpath) {};
 		/** Initialize particle data from restart xml file. */
 		virtual void readParticleFromXmlForRestart(std::string& filefullpath) {};
+		/** Write all registered particle data and the sorting ids in the binary format for restart. */
+		virtual void writeParticlesToBinaryForRestart(std::string& filefullpath, Real physical_time);
+		/** Initialize all registered particle data and the sorting ids from the binary restart file. */
+		virtual void readParticlesFromBinaryForRestart(std::string& filefullpath);
 
 		/** Output particle position and volume in XML file for reloading particles. */
 		virtual void writeToXmlForReloadParticle(std::string &filefullpath);
 		/** Reload particle position and volume from XML files. */
 		virtual void readFromXmlForReloadParticle(std::string &filefullpath);
+		/** Output particle position and volume in binary file with the key of the resolution and shape. */
+		virtual void writeToBinaryForReloadParticle(std::string& filefullpath, const std::string& key);
+		/** Reload particle position and volume from the binary file if its key matches. */
+		virtual void readFromBinaryForReloadParticle(std::string& filefullpath, const std::string& key);
 
 		/** Pointer to this object. */
 		virtual BaseParticles* pointToThisObject();
+		/** Add the memory records of the registered variables and the sorting data. */
+		virtual void accountMemory(MemoryFootprint& footprint);
 
 		/** Normalize the kernel gradient. */
 		virtual Vecd normalizeKernelGradient(size_t particle_index_i, Vecd& kernel_gradient) { return kernel_gradient; };
@@ -37,6 +37,7 @@
 #include "diffusion_reaction.h"
 #include "solid_particles.h"
 #include "xml_engine.h"
+#include "vtu_file_writer.h"
 #include <fstream>
 
 using namespace std;
@@ -96,20 +97,13 @@ namespace SPH {
 		map<string, size_t> SpeciesIndexMap() { return  species_indexes_map_; };
 
 		/** Write particle data in VTU format for Paraview. */
-		virtual void writeParticlesToVtuFile(ofstream& output_file) override {
-			BaseParticlesType::writeParticlesToVtuFile(output_file);
+		virtual void writeParticlesToVtuFile(VtuFileWriter& vtu_file) override {
+			BaseParticlesType::writeParticlesToVtuFile(vtu_file);
 
 			map<string, size_t>::iterator itr;
 			size_t number_of_particles = this->body_->number_of_particles_;
 			for (itr = species_indexes_map_.begin(); itr != species_indexes_map_.end(); ++itr) {
-				output_file << "    <DataArray Name=\" "<< itr->first <<" \" type=\"Float32\" Format=\"ascii\">\n";
-				output_file << "    ";
-				size_t k = itr->second;
-				for (size_t i = 0; i != number_of_particles; ++i) {
-					output_file << species_n_[k][i] << " ";
-				}
-				output_file << std::endl;
-				output_file << "    </DataArray>\n";
+				vtu_file.addPointData(" " + itr->first + " ", species_n_[itr->second], number_of_particles);
 			}
 		};
 		/** Write particle data in PLT format for Tecplot. */
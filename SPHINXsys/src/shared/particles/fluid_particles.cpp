@@ -36,9 +36,9 @@ namespace SPH
 		return this;
 	}
 	//=================================================================================================//
-	void ViscoelasticFluidParticles::writeParticlesToVtuFile(ofstream& output_file)
+	void ViscoelasticFluidParticles::writeParticlesToVtuFile(VtuFileWriter& vtu_file)
 	{
-		FluidParticles::writeParticlesToVtuFile(output_file);
+		FluidParticles::writeParticlesToVtuFile(vtu_file);
 	}
 	//=================================================================================================//
 	void FluidParticles::writeParticlesToXmlForRestart(std::string &filefullpath)
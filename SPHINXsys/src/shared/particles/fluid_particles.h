@@ -83,7 +83,7 @@ namespace SPH {
 		StdLargeVec<Matd> dtau_dt_;	/**<  change rate of elastic stress */
 
 		/** Write particle data in VTU format for Paraview. */
-		virtual void writeParticlesToVtuFile(ofstream &output_file) override;
+		virtual void writeParticlesToVtuFile(VtuFileWriter& vtu_file) override;
 		/** Write particle data in PLT format for Tecplot. */
 		virtual void writeParticlesToPltFile(ofstream &output_file) override;
 
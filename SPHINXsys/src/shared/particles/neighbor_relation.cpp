@@ -5,6 +5,7 @@
  */
 
 #include "neighbor_relation.h"
+#include "memory_footprint.h"
 
  //=================================================================================================//
 namespace SPH
@@ -20,5 +21,78 @@ namespace SPH
 		e_ij_.push_back(vec_r_ij / (r_ij + TinyReal));
 	}
 	//=================================================================================================//
+	void CompressedParticleConfiguration::resetNeighborCounts(size_t number_of_particles)
+	{
+		offset_.resize(number_of_particles + 1);
+		parallel_for(blocked_range<size_t>(0, offset_.size()),
+			[&](const blocked_range<size_t>& r) {
+				for (size_t i = r.begin(); i != r.end(); ++i) offset_[i] = 0;
+			}, ap);
+	}
+	//=================================================================================================//
+	void CompressedParticleConfiguration::accumulateNeighborCounts()
+	{
+		parallel_scan(blocked_range<size_t>(1, offset_.size()), size_t(0),
+			[&](const blocked_range<size_t>& r, size_t sum, bool is_final_scan)->size_t {
+				for (size_t i = r.begin(); i != r.end(); ++i) {
+					sum += offset_[i];
+					if (is_final_scan) offset_[i] = sum;
+				}
+				return sum;
+			},
+			[](size_t x, size_t y)->size_t { return x + y; });
+
+		/** The memory is only increased so that no reallocation is required for most updates. */
+		size_t number_of_entries = NumberOfEntries();
+		if (number_of_entries > j_.size())
+		{
+			j_.resize(number_of_entries);
+			W_ij_.resize(number_of_entries);
+			dW_ij_.resize(number_of_entries);
+			r_ij_.resize(number_of_entries);
+			e_ij_.resize(number_of_entries);
+		}
+	}
+	//=================================================================================================//
+	void CompressedParticleConfiguration::setANeighbor(Kernel& kernel, Vecd& vec_r_ij, size_t entry, size_t j_index)
+	{
+		j_[entry] = j_index;
+		W_ij_[entry] = kernel.W(vec_r_ij);
+		dW_ij_[entry] = kernel.dW(vec_r_ij);
+		Real r_ij = vec_r_ij.norm();
+		r_ij_[entry] = r_ij;
+		e_ij_[entry] = vec_r_ij / (r_ij + TinyReal);
+	}
+	//=================================================================================================//
+	void accountConfigurationMemory(MemoryFootprint& footprint, const std::string& name,
+		ParticleConfiguration& configuration)
+	{
+		size_t entry_bytes = sizeof(size_t) + 3 * sizeof(Real) + sizeof(Vecd);
+		size_t used_bytes = configuration.size() * sizeof(Neighborhood);
+		size_t allocated_bytes = configuration.capacity() * sizeof(Neighborhood);
+		for (size_t i = 0; i != configuration.size(); ++i)
+		{
+			Neighborhood& neighborhood = configuration[i];
+			used_bytes += neighborhood.current_size_ * entry_bytes;
+			allocated_bytes += neighborhood.j_.capacity() * sizeof(size_t) + neighborhood.W_ij_.capacity() * sizeof(Real)
+				+ neighborhood.dW_ij_.capacity() * sizeof(Real) + neighborhood.r_ij_.capacity() * sizeof(Real)
+				+ neighborhood.e_ij_.capacity() * sizeof(Vecd);
+		}
+		footprint.addRecord("configuration", name, used_bytes, allocated_bytes);
+	}
+	//=================================================================================================//
+	void accountConfigurationMemory(MemoryFootprint& footprint, const std::string& name,
+		CompressedParticleConfiguration& configuration)
+	{
+		size_t entry_bytes = sizeof(size_t) + 3 * sizeof(Real) + sizeof(Vecd);
+		size_t used_bytes = configuration.offset_.size() * sizeof(size_t) 
+			+ configuration.NumberOfEntries() * entry_bytes;
+		size_t allocated_bytes = configuration.offset_.capacity() * sizeof(size_t)
+			+ configuration.j_.capacity() * sizeof(size_t) + configuration.W_ij_.capacity() * sizeof(Real)
+			+ configuration.dW_ij_.capacity() * sizeof(Real) + configuration.r_ij_.capacity() * sizeof(Real)
+			+ configuration.e_ij_.capacity() * sizeof(Vecd);
+		footprint.addRecord("configuration", name + " (compressed)", used_bytes, allocated_bytes);
+	}
+	//=================================================================================================//
 }
 //=================================================================================================//
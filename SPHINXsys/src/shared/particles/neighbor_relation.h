@@ -65,4 +65,82 @@ namespace SPH {
 	using ParticleConfiguration = StdLargeVec<Neighborhood>;
 	/** All contact neighborhoods for all particles in a body. */
 	using ContatcParticleConfiguration = StdVec<ParticleConfiguration>;
+
+	/**
+	 * @class NeighborhoodView
+	 * @brief A light-weight range view of the neighbors of particle i.
+	 * It has the same member names as Neighborhood so that the interaction loops 
+	 * are identical for the neighborhood of a particle configuration 
+	 * and that of a compressed particle configuration.
+	 */
+	class NeighborhoodView
+	{
+	public:
+		size_t current_size_;	/**< the number of neighbors in the view */
+		size_t* j_;				/**< index of the neighbor particle. */
+		Real* W_ij_;			/**< kernel value */
+		Real* dW_ij_;			/**< derivative of kernel function */
+		Real* r_ij_;			/**< distance between j and i. */
+		Vecd* e_ij_;			/**< unit vector pointing from j to i */
+
+		NeighborhoodView(Neighborhood& neighborhood)
+			: current_size_(neighborhood.current_size_), j_(neighborhood.j_.data()),
+			W_ij_(neighborhood.W_ij_.data()), dW_ij_(neighborhood.dW_ij_.data()),
+			r_ij_(neighborhood.r_ij_.data()), e_ij_(neighborhood.e_ij_.data()) {};
+		NeighborhoodView(size_t current_size, size_t* j, Real* W_ij, Real* dW_ij, Real* r_ij, Vecd* e_ij)
+			: current_size_(current_size), j_(j), W_ij_(W_ij), dW_ij_(dW_ij), r_ij_(r_ij), e_ij_(e_ij) {};
+	};
+
+	/**
+	 * @class CompressedParticleConfiguration
+	 * @brief The neighborhoods of all particles in a body saved 
+	 * in compressed sparse row (CSR) layout. 
+	 * The neighbor data of all particles are stored contiguously,
+	 * and those of particle i are in the entry range [offset_[i], offset_[i + 1]).
+	 * It is built by counting the neighbors of each particle first,
+	 * then computing the offsets by prefix sum and at last filling the neighbor data.
+	 */
+	class CompressedParticleConfiguration
+	{
+	public:
+		/** the offsets of neighbor entries, size is number of particles plus one */
+		StdLargeVec<size_t> offset_;
+
+		StdLargeVec<size_t> j_;		/**< index of the neighbor particle. */
+		StdLargeVec<Real> W_ij_;	/**< kernel value */
+		StdLargeVec<Real> dW_ij_;	/**< derivative of kernel function */
+		StdLargeVec<Real> r_ij_;	/**< distance between j and i. */
+		StdLargeVec<Vecd> e_ij_;	/**< unit vector pointing from j to i */
+
+		CompressedParticleConfiguration() {};
+		~CompressedParticleConfiguration() {};
+
+		/** number of particles in the configuration */
+		size_t size() { return offset_.empty() ? 0 : offset_.size() - 1; };
+		/** total number of neighbor entries */
+		size_t NumberOfEntries() { return offset_.empty() ? 0 : offset_.back(); };
+		/** set zero neighbors for all particles, the neighbor count of particle i is saved in offset_[i + 1] */
+		void resetNeighborCounts(size_t number_of_particles);
+		/** transfer the neighbor counts into offsets by prefix sum and allocate memory for the entries */
+		void accumulateNeighborCounts();
+		/** set the neighbor data at a given entry */
+		void setANeighbor(Kernel& kernel, Vecd& vec_r_ij, size_t entry, size_t j_index);
+
+		NeighborhoodView operator[](size_t index_i)
+		{
+			size_t begin = offset_[index_i];
+			return NeighborhoodView(offset_[index_i + 1] - begin, j_.data() + begin, 
+				W_ij_.data() + begin, dW_ij_.data() + begin, r_ij_.data() + begin, e_ij_.data() + begin);
+		};
+	};
+	/** All compressed contact configurations for all particles in a body. */
+	using CompressedContactParticleConfiguration = StdVec<CompressedParticleConfiguration>;
+
+	class MemoryFootprint;
+	/** Add the memory record of a configuration, the slack includes the neighbor entries beyond the current sizes. */
+	void accountConfigurationMemory(MemoryFootprint& footprint, const std::string& name, 
+		ParticleConfiguration& configuration);
+	/** Add the memory record of a compressed configuration. */
+	void accountConfigurationMemory(MemoryFootprint& footprint, const std::string& name, 
+		CompressedParticleConfiguration& configuration);
 }
@@ -9,6 +9,7 @@
 #include "solid_particles.h"
 #include "base_body.h"
 #include "elastic_solid.h"
+#include "vtu_file_writer.h"
 //=============================================================================================//
 namespace SPH {
 	//=============================================================================================//
@@ -90,6 +91,12 @@ namespace SPH {
 		}
 	}
 	//=============================================================================================//
+	void SolidParticles::readFromBinaryForReloadParticle(std::string& filefullpath, const std::string& key)
+	{
+		BaseParticles::readFromBinaryForReloadParticle(filefullpath, key);
+		for (size_t i = 0; i != pos_n_.size(); ++i) pos_0_[i] = pos_n_[i];
+	}
+	//=============================================================================================//
 	SolidParticles* SolidParticles::pointToThisObject()
 	{
 		return this;
@@ -144,19 +151,12 @@ namespace SPH {
 		return this;
 	}
 	//=================================================================================================//
-	void ElasticSolidParticles::writeParticlesToVtuFile(ofstream& output_file)
+	void ElasticSolidParticles::writeParticlesToVtuFile(VtuFileWriter& vtu_file)
 	{
-		SolidParticles::writeParticlesToVtuFile(output_file);
+		SolidParticles::writeParticlesToVtuFile(vtu_file);
 
 		size_t number_of_particles = body_->number_of_particles_;
-
-		output_file << "    <DataArray Name=\"von Mises stress\" type=\"Float32\" Format=\"ascii\">\n";
-		output_file << "    ";
-		for (size_t i = 0; i != number_of_particles; ++i) {
-			output_file << fixed << setprecision(9) << von_Mises_stress(i) << " ";
-		}
-		output_file << std::endl;
-		output_file << "    </DataArray>\n";
+		vtu_file.addScalarPointData("von Mises stress", number_of_particles, [&](size_t i) { return von_Mises_stress(i); });
 	}
 	//=================================================================================================//
 	void ElasticSolidParticles::writeParticlesToXmlForRestart(std::string &filefullpath)
@@ -218,19 +218,12 @@ namespace SPH {
 		return this;
 	}
 	//=============================================================================================//
-	void ActiveMuscleParticles::writeParticlesToVtuFile(ofstream& output_file)
+	void ActiveMuscleParticles::writeParticlesToVtuFile(VtuFileWriter& vtu_file)
 	{
-		ElasticSolidParticles::writeParticlesToVtuFile(output_file);
+		ElasticSolidParticles::writeParticlesToVtuFile(vtu_file);
 
 		size_t number_of_particles = body_->number_of_particles_;
-
-		output_file << "    <DataArray Name=\"Active Stress\" type=\"Float32\" Format=\"ascii\">\n";
-		output_file << "    ";
-		for (size_t i = 0; i != number_of_particles; ++i) {
-			output_file << fixed << setprecision(9) << active_contraction_stress_[i] << " ";
-		}
-		output_file << std::endl;
-		output_file << "    </DataArray>\n";
+		vtu_file.addPointData("Active Stress", active_contraction_stress_, number_of_particles);
 	}
 	//=================================================================================================//
 	void ActiveMuscleParticles::writeParticlesToXmlForRestart(std::string& filefullpath)
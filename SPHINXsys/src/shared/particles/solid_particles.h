@@ -89,6 +89,8 @@ namespace SPH {
 		virtual void readParticleFromXmlForRestart(std::string &filefullpath) override ;
 		/** Reload particle position and volume from XML files */	
 		virtual void readFromXmlForReloadParticle(std::string &filefullpath) override;
+		/** Reload particle position and volume from the binary file, the initial position is set too */
+		virtual void readFromBinaryForReloadParticle(std::string& filefullpath, const std::string& key) override;
 
 		/** Pointer to this object. */
 		virtual SolidParticles* pointToThisObject() override;
@@ -125,7 +127,7 @@ namespace SPH {
 		StdLargeVec<Matd>	stress_;	/**<  stress tensor */
 
 		/** Write particle data in VTU format for Paraview */
-		virtual void writeParticlesToVtuFile(ofstream &output_file) override;
+		virtual void writeParticlesToVtuFile(VtuFileWriter& vtu_file) override;
 		/** Write particle data in PLT format for Tecplot */
 		virtual void writeParticlesToPltFile(ofstream &output_file) override;
 		/** Write particle data in XML format for restart */
@@ -154,7 +156,7 @@ namespace SPH {
 		virtual ~ActiveMuscleParticles() {};
 
 		/** Write particle data in VTU format for Paraview */
-		virtual void writeParticlesToVtuFile(ofstream& output_file) override;
+		virtual void writeParticlesToVtuFile(VtuFileWriter& vtu_file) override;
 		/** Write particle data in PLT format for Tecplot */
 		virtual void writeParticlesToPltFile(ofstream& output_file) override;
 		/** Write particle data in XML format for restart */
@@ -0,0 +1,86 @@
+/**
+ * @file 	memory_footprint.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "memory_footprint.h"
+
+#include <map>
+#include <iomanip>
+#include <algorithm>
+
+namespace SPH
+{
+	namespace
+	{
+		double toMegaBytes(size_t bytes)
+		{
+			return double(bytes) / 1048576.0;
+		}
+
+		void printMemoryLine(std::ostream& out, const std::string& name, size_t used_bytes, size_t allocated_bytes)
+		{
+			std::string line_name = name.size() > 63 ? name.substr(0, 60) + "..." : name;
+			out << std::left << std::setw(64) << line_name << std::right
+				<< std::setw(14) << toMegaBytes(used_bytes)
+				<< std::setw(14) << toMegaBytes(allocated_bytes)
+				<< std::setw(14) << toMegaBytes(allocated_bytes - used_bytes) << "\n";
+		}
+	}
+	//=================================================================================================//
+	void MemoryFootprint::addRecord(const std::string& category, const std::string& name,
+		size_t used_bytes, size_t allocated_bytes)
+	{
+		MemoryRecord record = { body_name_, category, name, used_bytes, std::max(used_bytes, allocated_bytes) };
+		records_.push_back(record);
+	}
+	//=================================================================================================//
+	size_t MemoryFootprint::UsedBytes()
+	{
+		size_t bytes = 0;
+		for (const MemoryRecord& record : records_) bytes += record.used_bytes_;
+		return bytes;
+	}
+	//=================================================================================================//
+	size_t MemoryFootprint::AllocatedBytes()
+	{
+		size_t bytes = 0;
+		for (const MemoryRecord& record : records_) bytes += record.allocated_bytes_;
+		return bytes;
+	}
+	//=================================================================================================//
+	void MemoryFootprint::printSummary(std::ostream& out)
+	{
+		out << "\n Memory footprint in MB.\n" << std::fixed << std::setprecision(3);
+		out << std::left << std::setw(64) << " Body / category / data" << std::right
+			<< std::setw(14) << "Used" << std::setw(14) << "Allocated" << std::setw(14) << "Slack" << "\n";
+
+		std::map<std::string, std::pair<size_t, size_t>> category_bytes;
+		for (size_t i = 0; i != records_.size(); ++i)
+		{
+			const MemoryRecord& record = records_[i];
+			bool is_new_body = i == 0 || records_[i - 1].body_name_ != record.body_name_;
+			if (is_new_body)
+			{
+				size_t body_used_bytes = 0, body_allocated_bytes = 0;
+				for (size_t j = i; j != records_.size() && records_[j].body_name_ == record.body_name_; ++j)
+				{
+					body_used_bytes += records_[j].used_bytes_;
+					body_allocated_bytes += records_[j].allocated_bytes_;
+				}
+				printMemoryLine(out, " " + record.body_name_, body_used_bytes, body_allocated_bytes);
+			}
+			printMemoryLine(out, "   " + record.category_ + ": " + record.name_,
+				record.used_bytes_, record.allocated_bytes_);
+			category_bytes[record.category_].first += record.used_bytes_;
+			category_bytes[record.category_].second += record.allocated_bytes_;
+		}
+
+		out << " Categories of all bodies\n";
+		for (auto& category : category_bytes)
+			printMemoryLine(out, "   " + category.first, category.second.first, category.second.second);
+		printMemoryLine(out, " Total", UsedBytes(), AllocatedBytes());
+	}
+	//=================================================================================================//
+}
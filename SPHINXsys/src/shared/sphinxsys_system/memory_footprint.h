@@ -0,0 +1,63 @@
+/**
+ * @file 	memory_footprint.h
+ * @brief 	The accounting of the memory used by the particle data, the particle configurations,
+ *			the cell linked lists and the level sets of the bodies.
+ * @details Each data structure adds a record with its used bytes, i.e. those of the current data,
+ *			and its allocated bytes, which include the slack of the reserved but unused capacity,
+ *			such as the neighbor entries beyond the current number of neighbors of a particle.
+ *			The records are aggregated by body and by category in the printed breakdown.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "large_data_containers.h"
+
+#include <string>
+#include <iostream>
+
+namespace SPH
+{
+	/**
+	 * @struct MemoryRecord
+	 * @brief The memory of a data structure of a body.
+	 */
+	struct MemoryRecord
+	{
+		std::string body_name_;
+		std::string category_;
+		std::string name_;
+		size_t used_bytes_;			/**< bytes of the current data */
+		size_t allocated_bytes_;	/**< bytes allocated, including the unused capacity */
+	};
+
+	/**
+	 * @class MemoryFootprint
+	 * @brief The memory records of the bodies in a system.
+	 * The records are added for the body set by setBodyName.
+	 */
+	class MemoryFootprint
+	{
+	public:
+		MemoryFootprint() {};
+		virtual ~MemoryFootprint() {};
+
+		StdVec<MemoryRecord> records_;
+
+		/** the body of the records added next */
+		void setBodyName(const std::string& body_name) { body_name_ = body_name; };
+		void addRecord(const std::string& category, const std::string& name, size_t used_bytes, size_t allocated_bytes);
+		/** add the record of a std or concurrent vector */
+		template<class VectorType>
+		void addVector(const std::string& category, const std::string& name, const VectorType& data_vector)
+		{
+			addRecord(category, name, data_vector.size() * sizeof(typename VectorType::value_type),
+				data_vector.capacity() * sizeof(typename VectorType::value_type));
+		};
+		size_t UsedBytes();
+		size_t AllocatedBytes();
+		/** print all records with the subtotals of the bodies and the totals of the categories */
+		void printSummary(std::ostream& out = std::cout);
+	protected:
+		std::string body_name_;
+	};
+}
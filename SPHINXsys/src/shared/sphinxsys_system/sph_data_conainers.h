@@ -18,6 +18,8 @@ namespace SPH {
 	class SPHBody;
 	class CellList;
 	class BaseParticles;
+	class MemoryFootprint;
+	class VtuFileWriter;
 
 	/**< Vector of Material. Note that vector of references are not allowed in c++.*/
 	using MaterialVector = StdVec<BaseMaterial*>;
@@ -0,0 +1,217 @@
+/**
+ * @file 	sph_profiler.cpp
+ * @author	Luhui Han, Chi ZHang and Xiangyu Hu
+ * @version	0.1
+ */
+
+#include "sph_profiler.h"
+#include "base_body.h"
+
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <typeindex>
+#include <cstdlib>
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
+
+namespace SPH
+{
+	/**
+	 * @brief The recorded spans, and the open spans of each thread for the hierarchy.
+	 */
+	namespace
+	{
+		struct ProfilerEvent
+		{
+			std::string name_;
+			std::string path_;
+			size_t depth_;
+			size_t thread_;
+			double start_;
+			double duration_;
+			double self_duration_;
+			size_t number_of_particles_;
+			double utilization_;
+		};
+
+		struct OpenSpan
+		{
+			std::string path_;
+			double children_duration_;
+		};
+
+		LargeVec<ProfilerEvent> profiler_events;
+		tick_count profiler_start_time;
+		bool profiler_started = false;
+		std::atomic<size_t> number_of_profiled_threads(0);
+		thread_local size_t profiled_thread_index = number_of_profiled_threads++;
+		thread_local StdVec<OpenSpan> open_spans;
+		std::mutex type_names_mutex;
+		std::map<std::type_index, std::string> type_names;
+
+		std::string escapeJsonString(const std::string& input)
+		{
+			std::string output;
+			for (char c : input)
+			{
+				if (c == '"' || c == '\\') output += '\\';
+				output += c;
+			}
+			return output;
+		}
+	}
+	//=================================================================================================//
+	bool SPHProfiler::enabled_ = false;
+	//=================================================================================================//
+	void SPHProfiler::setEnabled(bool enabled)
+	{
+		if (enabled && !profiler_started)
+		{
+			profiler_start_time = tick_count::now();
+			profiler_started = true;
+		}
+		enabled_ = enabled;
+	}
+	//=================================================================================================//
+	void SPHProfiler::clear()
+	{
+		profiler_events.clear();
+	}
+	//=================================================================================================//
+	void SPHProfiler::printSummary(std::ostream& out)
+	{
+		if (!profiler_started || profiler_events.empty()) return;
+
+		struct SpanSummary
+		{
+			std::string name_;
+			size_t depth_ = 0;
+			size_t calls_ = 0;
+			double duration_ = 0.0;
+			double self_duration_ = 0.0;
+			double particles_ = 0.0;
+			double busy_duration_ = 0.0;
+		};
+		/** aggregated by the path, so that a span is listed after its parent */
+		std::map<std::string, SpanSummary> summaries;
+		for (const ProfilerEvent& event : profiler_events)
+		{
+			SpanSummary& summary = summaries[event.path_];
+			summary.name_ = event.name_;
+			summary.depth_ = event.depth_;
+			summary.calls_ += 1;
+			summary.duration_ += event.duration_;
+			summary.self_duration_ += event.self_duration_;
+			summary.particles_ += Real(event.number_of_particles_);
+			summary.busy_duration_ += event.utilization_ * event.duration_;
+		}
+		double run_time = (tick_count::now() - profiler_start_time).seconds();
+
+		out << "\n Profiler summary, total time of the run " << std::fixed << std::setprecision(6) << run_time << " seconds.\n";
+		out << std::left << std::setw(72) << " Span" << std::right
+			<< std::setw(10) << "Calls" << std::setw(14) << "Total[s]" << std::setw(14) << "Self[s]"
+			<< std::setw(9) << "%Run" << std::setw(12) << "Particles" << std::setw(10) << "Util." << "\n";
+		for (auto& path_summary : summaries)
+		{
+			SpanSummary& summary = path_summary.second;
+			std::string name = " " + std::string(2 * summary.depth_, ' ') + summary.name_;
+			if (name.size() > 71) name = name.substr(0, 68) + "...";
+			out << std::left << std::setw(72) << name << std::right
+				<< std::setw(10) << summary.calls_
+				<< std::setw(14) << std::setprecision(6) << summary.duration_
+				<< std::setw(14) << summary.self_duration_
+				<< std::setw(9) << std::setprecision(2) << 100.0 * summary.duration_ / run_time
+				<< std::setw(12) << std::setprecision(0) << summary.particles_ / Real(summary.calls_)
+				<< std::setw(10) << std::setprecision(2)
+				<< (summary.duration_ > 0.0 ? summary.busy_duration_ / summary.duration_ : 0.0) << "\n";
+		}
+		out << " Util. is the mean of the process cpu time over the wall time times the number of threads,"
+			<< " it includes the spinning of idle threads.\n";
+	}
+	//=================================================================================================//
+	void SPHProfiler::writeChromeTrace(const std::string& file_path)
+	{
+		std::ofstream out_file(file_path.c_str(), std::ios::trunc);
+		out_file << "{\"traceEvents\":[\n";
+		bool is_first = true;
+		for (const ProfilerEvent& event : profiler_events)
+		{
+			if (!is_first) out_file << ",\n";
+			is_first = false;
+			out_file << "{\"name\":\"" << escapeJsonString(event.name_) << "\",\"cat\":\"SPHinXsys\",\"ph\":\"X\""
+				<< ",\"ts\":" << std::fixed << std::setprecision(3) << event.start_ * 1.0e6
+				<< ",\"dur\":" << event.duration_ * 1.0e6
+				<< ",\"pid\":0,\"tid\":" << event.thread_
+				<< ",\"args\":{\"particles\":" << event.number_of_particles_
+				<< ",\"utilization\":" << std::setprecision(3) << event.utilization_ << "}}";
+		}
+		out_file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+		out_file.close();
+	}
+	//=================================================================================================//
+	void ProfilerSpan::begin(const char* name, SPHBody* body, size_t number_of_particles)
+	{
+		name_ = name;
+		number_of_particles_ = number_of_particles;
+		if (body != NULL)
+		{
+			name_ += " (" + body->GetBodyName() + ")";
+			number_of_particles_ = body->number_of_particles_;
+		}
+		std::string parent_path = open_spans.empty() ? "" : open_spans.back().path_ + "/";
+		OpenSpan open_span = { parent_path + name_, 0.0 };
+		open_spans.push_back(open_span);
+		start_cpu_time_ = std::clock();
+		start_time_ = tick_count::now();
+	}
+	//=================================================================================================//
+	void ProfilerSpan::end()
+	{
+		tick_count end_time = tick_count::now();
+		std::clock_t end_cpu_time = std::clock();
+
+		ProfilerEvent event;
+		event.name_ = name_;
+		event.path_ = open_spans.back().path_;
+		event.depth_ = open_spans.size() - 1;
+		event.thread_ = profiled_thread_index;
+		event.start_ = (start_time_ - profiler_start_time).seconds();
+		event.duration_ = (end_time - start_time_).seconds();
+		event.self_duration_ = event.duration_ - open_spans.back().children_duration_;
+		event.number_of_particles_ = number_of_particles_;
+		double cpu_duration = double(end_cpu_time - start_cpu_time_) / double(CLOCKS_PER_SEC);
+		double available_duration = event.duration_ * double(this_task_arena::max_concurrency());
+		event.utilization_ = available_duration > 0.0 ? SMIN(cpu_duration / available_duration, 1.0) : 0.0;
+
+		open_spans.pop_back();
+		if (!open_spans.empty()) open_spans.back().children_duration_ += event.duration_;
+		profiler_events.push_back(event);
+	}
+	//=================================================================================================//
+	std::string ProfilerSpan::typeName(const std::type_info& type)
+	{
+		std::lock_guard<std::mutex> lock(type_names_mutex);
+		auto found = type_names.find(std::type_index(type));
+		if (found != type_names.end()) return found->second;
+
+		std::string name = type.name();
+#ifdef __GNUG__
+		int status = 0;
+		char* demangled_name = abi::__cxa_demangle(type.name(), NULL, NULL, &status);
+		if (status == 0) name = demangled_name;
+		free(demangled_name);
+#endif
+		for (const std::string prefix : { "class ", "struct ", "SPH::" })
+		{
+			for (size_t position = name.find(prefix); position != std::string::npos; position = name.find(prefix))
+				name.erase(position, prefix.size());
+		}
+		type_names[std::type_index(type)] = name;
+		return name;
+	}
+	//=================================================================================================//
+}
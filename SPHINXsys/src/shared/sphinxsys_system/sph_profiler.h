@@ -0,0 +1,75 @@
+/**
+ * @file 	sph_profiler.h
+ * @brief 	A hierarchical profiler which records named spans of the particle dynamics,
+ *			the cell linked list and configuration updates, the particle sorting and the output.
+ * @details A span is recorded with its particle count and thread utilization, and the spans started
+ *			within it are its children. At the end of the run, a summary table is printed and
+ *			all spans are written as a Chrome trace (chrome://tracing or https://ui.perfetto.dev).
+ *			When the profiler is disabled, a span only checks a static flag.
+ * @author  Xiangyu Hu, Luhui Han and Chi Zhang
+ */
+#pragma once
+
+#include "large_data_containers.h"
+
+#include <string>
+#include <typeinfo>
+#include <ctime>
+#include <iostream>
+
+namespace SPH
+{
+	/**
+	 * @class SPHProfiler
+	 * @brief The recorded spans and the output of the profiler.
+	 */
+	class SPHProfiler
+	{
+	public:
+		static bool isEnabled() { return enabled_; };
+		/** enable or disable recording, the time of the trace starts at the first enabling */
+		static void setEnabled(bool enabled);
+		/** print the summary table with the spans aggregated by their hierarchical names */
+		static void printSummary(std::ostream& out = std::cout);
+		/** write all spans in the Chrome trace event format */
+		static void writeChromeTrace(const std::string& file_path);
+		/** clear all recorded spans */
+		static void clear();
+	protected:
+		static bool enabled_;
+	};
+
+	class SPHBody;
+
+	/**
+	 * @class ProfilerSpan
+	 * @brief A named span from its construction to its destruction.
+	 * The name of a span of a class is its type name, which is demangled only if the profiler is enabled.
+	 * If a body is given, its name is appended to the span name and its particles are counted.
+	 */
+	class ProfilerSpan
+	{
+	public:
+		explicit ProfilerSpan(const char* name, SPHBody* body = NULL, size_t number_of_particles = 0)
+			: is_recording_(SPHProfiler::isEnabled())
+		{
+			if (is_recording_) begin(name, body, number_of_particles);
+		};
+		explicit ProfilerSpan(const std::type_info& type, SPHBody* body = NULL, size_t number_of_particles = 0)
+			: is_recording_(SPHProfiler::isEnabled())
+		{
+			if (is_recording_) begin(typeName(type).c_str(), body, number_of_particles);
+		};
+		~ProfilerSpan() { if (is_recording_) end(); };
+	protected:
+		bool is_recording_;
+		std::string name_;
+		size_t number_of_particles_;
+		tick_count start_time_;
+		std::clock_t start_cpu_time_;
+
+		void begin(const char* name, SPHBody* body, size_t number_of_particles);
+		void end();
+		static std::string typeName(const std::type_info& type);
+	};
+}
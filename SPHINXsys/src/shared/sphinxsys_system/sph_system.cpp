@@ -7,6 +7,8 @@
 #include "sph_system.h"
 #include "base_body.h"
 #include "particle_generator_lattice.h"
+#include "sph_profiler.h"
+#include "memory_footprint.h"
 
 namespace SPH
 {
@@ -16,7 +18,8 @@ namespace SPH
 		: lower_bound_(lower_bound), upper_bound_(upper_bound),
 		tbb_init_(number_of_threads), particle_spacing_ref_(particle_spacing_ref),
 		restart_step_(0), run_particle_relaxation_(false),
-		reload_particles_(false)
+		reload_particles_(false), number_of_time_steps_(0), state_output_(true),
+		memory_footprint_report_(false), skin_distance_ratio_(0.0), boundary_width_ratio_(0.0)
 	{
 		output_folder_ = "./output";
 		if (!fs::exists(output_folder_))
@@ -33,6 +36,15 @@ namespace SPH
 		reload_folder_ = "./reload";
 	}
 	//===============================================================//
+	SPHSystem::~SPHSystem()
+	{
+		if (SPHProfiler::isEnabled())
+		{
+			SPHProfiler::printSummary();
+			SPHProfiler::writeChromeTrace(output_folder_ + "/profiler_trace.json");
+		}
+	}
+	//===============================================================//
 	void SPHSystem::addABody(SPHBody* body)
 	{
 		bodies_.push_back(body);
@@ -66,6 +78,28 @@ namespace SPH
 			}
 
 		}
+		if (memory_footprint_report_) reportMemoryFootprint();
+	}
+	//===============================================================//
+	void SPHSystem::setNumberOfThreads(int number_of_threads)
+	{
+		if (tbb_init_.is_active()) tbb_init_.terminate();
+		tbb_init_.initialize(number_of_threads);
+	}
+	//===============================================================//
+	void SPHSystem::setProfiling(bool profiling)
+	{
+		SPHProfiler::setEnabled(profiling);
+	}
+	//===============================================================//
+	void SPHSystem::reportMemoryFootprint(std::ostream& out)
+	{
+		MemoryFootprint footprint;
+		for (auto& body : bodies_)
+		{
+			body->accountMemory(footprint);
+		}
+		footprint.printSummary(out);
 	}
 	//===============================================================//
 	void SPHSystem::handleCommandlineOptions(int ac, char* av[])
@@ -77,6 +111,13 @@ namespace SPH
 				("help", "produce help message")
 				("r", po::value<bool>(), "Particle relaxation.")
 				("i", po::value<bool>(), "Particle reload from input file.")
+				("p", po::value<bool>(), "Profiling of the particle dynamics, configuration updates and outputs.")
+				("dp", po::value<Real>(), "Reference particle spacing.")
+				("t", po::value<int>(), "Number of threads.")
+				("n", po::value<size_t>(), "Number of time steps.")
+				("o", po::value<bool>(), "Output of body states.")
+				("m", po::value<bool>(), "Memory footprint report after initializing the configurations.")
+				("s", po::value<Real>(), "Verlet skin distance of the body relations in reference particle spacing.")
 				;
 
 			po::variables_map vm;
@@ -104,6 +145,54 @@ namespace SPH
 			else {
 				cout << "Particle reload from input file was set to default (" << reload_particles_ << ").\n";
 			}
+			if (vm.count("p")) {
+				setProfiling(vm["p"].as<bool>());
+				cout << "Profiling was set to "
+					<< vm["p"].as<bool>() << ".\n";
+			}
+			if (vm.count("dp")) {
+				/** the meshes of the bodies are built from the spacing and the bounds */
+				if (!bodies_.empty())
+				{
+					std::cout << "\n Error: the reference particle spacing is given after the bodies are created!" << std::endl;
+					std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+					exit(1);
+				}
+				Real boundary_width_change = boundary_width_ratio_ * (vm["dp"].as<Real>() - particle_spacing_ref_);
+				for (size_t k = 0; k != lower_bound_.size(); ++k)
+				{
+					lower_bound_[k] -= boundary_width_change;
+					upper_bound_[k] += boundary_width_change;
+				}
+				particle_spacing_ref_ = vm["dp"].as<Real>();
+				cout << "Reference particle spacing was set to "
+					<< particle_spacing_ref_ << ".\n";
+			}
+			if (vm.count("t")) {
+				setNumberOfThreads(vm["t"].as<int>());
+				cout << "Number of threads was set to "
+					<< vm["t"].as<int>() << ".\n";
+			}
+			if (vm.count("n")) {
+				number_of_time_steps_ = vm["n"].as<size_t>();
+				cout << "Number of time steps was set to "
+					<< number_of_time_steps_ << ".\n";
+			}
+			if (vm.count("o")) {
+				state_output_ = vm["o"].as<bool>();
+				cout << "Output of body states was set to "
+					<< state_output_ << ".\n";
+			}
+			if (vm.count("m")) {
+				memory_footprint_report_ = vm["m"].as<bool>();
+				cout << "Memory footprint report was set to "
+					<< memory_footprint_report_ << ".\n";
+			}
+			if (vm.count("s")) {
+				skin_distance_ratio_ = vm["s"].as<Real>();
+				cout << "Verlet skin distance ratio was set to "
+					<< skin_distance_ratio_ << ".\n";
+			}
 		}
 		catch (std::exception & e) {
 			cerr << "error: " << e.what() << "\n";
@@ -52,7 +52,8 @@ namespace SPH
 		 */
  		SPHSystem(Vecd lower_bound, Vecd upper_bound, Real particle_spacing_ref, 
 			int number_of_threads = tbb::task_scheduler_init::automatic);
-		virtual ~SPHSystem() {};
+		/** Print the profiler summary and write the trace if the profiler is enabled. */
+		virtual ~SPHSystem();
 
 		Vecd lower_bound_, upper_bound_;	/**< Lower and Upper domain bound. */
 		task_scheduler_init tbb_init_;		/**< TBB library. */
@@ -63,6 +64,18 @@ namespace SPH
 		bool run_particle_relaxation_;
 		/** start the simulation with relaxed particles*/
 		bool reload_particles_;
+		/** number of time steps to run, 0 for running until the end time of the case */
+		size_t number_of_time_steps_;
+		/** whether the body states are written to files */
+		bool state_output_;
+		/** whether the memory footprint is reported after initializing the configurations */
+		bool memory_footprint_report_;
+		/** the Verlet skin distance of the body relations in the reference particle spacing,
+		  * which is used by the cases setting the skin distance */
+		Real skin_distance_ratio_;
+		/** the width between the domain bounds and the geometry in reference particle spacing,
+		  * with which the bounds are rescaled when the spacing is given from the command line */
+		Real boundary_width_ratio_;
 		std::string output_folder_;		/**< folder for saving output files. */
 		std::string restart_folder_;	/**< folder for saving restart files. */
 		std::string reload_folder_;		/**< folder for saving particle reload files. */
@@ -84,6 +97,12 @@ namespace SPH
 		/** Initialize particle interacting configurations. */
 		void initializeSystemConfigurations();
 
+		/** Reset the number of threads of the TBB library. */
+		void setNumberOfThreads(int number_of_threads);
+		/** Enable the profiler, whose summary and trace are output at the end of the run. */
+		void setProfiling(bool profiling);
+		/** Print the memory of the particle data, configurations, cell linked lists and level sets of all bodies. */
+		void reportMemoryFootprint(std::ostream& out = std::cout);
 		/** handle the commandline options*/
 		void handleCommandlineOptions(int ac, char* av[]);
 	};
@@ -0,0 +1,403 @@
+/**
+ * @file 	micro_benchmarks.cpp
+ * @brief 	2D micro-benchmarks of the kernels, cell linked lists, neighbor search,
+ *			particle sorting, level set and interaction loops.
+ * @details Square blocks of lattice particles with several resolutions are generated,
+ *			so that the particle sets are the same for every run.
+ *			The interaction loops are executed with zero time step size so that the particle states,
+ *			and hence the timings, do not drift between the repeated calls.
+ *			The results are printed and written as JSON into the output folder for tracking regressions.
+ *			The deterministic reductions of a body and of body parts by particles and by cells are checked
+ *			to give identical results with one and with all threads, otherwise the benchmark fails.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real LL = 1.0; 									/**< Block length. */
+StdVec<Real> particle_spacings = { 0.02, 0.01, 0.005 }; /**< Resolutions of the particle lattices. */
+/**
+ * @brief Material properties.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real c_f = 10.0;						/**< Reference sound speed. */
+Real rho0_s = 1.0e3;					/**< Reference density of solid. */
+Real Youngs_modulus = 2.0e6;			/**< Young's modulus of solid. */
+Real poisson = 0.3975;					/**< Poisson ratio of solid. */
+/**
+ * @brief Benchmark parameters.
+ */
+size_t number_of_kernel_evaluations = 1000000;	/**< Number of evaluations for timing the kernels. */
+size_t number_of_calls = 20;					/**< Number of timed calls for the other benchmarks. */
+/** create a block shape */
+std::vector<Point> CreatBlockShape()
+{
+	std::vector<Point> block_shape;
+	block_shape.push_back(Point(0.0, 0.0));
+	block_shape.push_back(Point(0.0, LL));
+	block_shape.push_back(Point(LL, LL));
+	block_shape.push_back(Point(LL, 0.0));
+	block_shape.push_back(Point(0.0, 0.0));
+	return block_shape;
+}
+/**
+*@brief 	Fluid body definition.
+*/
+class FluidBlock : public FluidBody
+{
+public:
+	FluidBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: FluidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> block_shape = CreatBlockShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(block_shape, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class FluidMaterial : public WeaklyCompressibleFluid
+{
+public:
+	FluidMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+*@brief 	Solid body definition.
+*/
+class SolidBlock : public SolidBody
+{
+public:
+	SolidBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: SolidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> block_shape = CreatBlockShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(block_shape, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief Define solid material.
+ */
+class SolidMaterial : public LinearElasticSolid
+{
+public:
+	SolidMaterial() : LinearElasticSolid()
+	{
+		rho_0_ = rho0_s;
+		E_0_ = Youngs_modulus;
+		nu_ = poisson;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	The whole block as a body part by particles.
+ */
+class BlockByParticle : public BodyPartByParticle
+{
+public:
+	BlockByParticle(SPHBody* body, string body_part_name)
+		: BodyPartByParticle(body, body_part_name)
+	{
+		std::vector<Point> block_shape = CreatBlockShape();
+		body_part_shape_ = new ComplexShape(body_part_name);
+		body_part_shape_->addAPolygon(block_shape, ShapeBooleanOps::add);
+		tagBodyPart();
+	}
+};
+/**
+ * @brief 	The whole block as a body part by cells.
+ */
+class BlockByCell : public BodyPartByCell
+{
+public:
+	BlockByCell(SPHBody* body, string body_part_name)
+		: BodyPartByCell(body, body_part_name)
+	{
+		std::vector<Point> block_shape = CreatBlockShape();
+		body_part_shape_ = new ComplexShape(body_part_name);
+		body_part_shape_->addAPolygon(block_shape, ShapeBooleanOps::add);
+		tagBodyPart();
+	}
+};
+/**
+ * @brief 	Sum of the particle heights in a body part by particles.
+ *			The sum depends on the order of the additions.
+ */
+class HeightSumByParticle : public PartDynamicsByParticleReduce<Real, ReduceSum<Real>>
+{
+public:
+	HeightSumByParticle(SPHBody* body, BodyPartByParticle* body_part)
+		: PartDynamicsByParticleReduce<Real, ReduceSum<Real>>(body, body_part),
+		pos_n_(body->base_particles_->pos_n_)
+	{
+		initial_reference_ = 0.0;
+	};
+protected:
+	StdLargeVec<Vecd>& pos_n_;
+	virtual Real ReduceFunction(size_t index_i, Real dt = 0.0) override { return pos_n_[index_i][1]; };
+};
+/**
+ * @brief 	Sum of the particle heights in a body part by cells.
+ */
+class HeightSumByCell : public PartDynamicsByCellReduce<Real, ReduceSum<Real>>
+{
+public:
+	HeightSumByCell(SPHBody* body, BodyPartByCell* body_part)
+		: PartDynamicsByCellReduce<Real, ReduceSum<Real>>(body, body_part),
+		pos_n_(body->base_particles_->pos_n_)
+	{
+		initial_reference_ = 0.0;
+	};
+protected:
+	StdLargeVec<Vecd>& pos_n_;
+	virtual Real ReduceFunction(size_t index_i, Real dt = 0.0) override { return pos_n_[index_i][1]; };
+};
+/**
+ * @brief A benchmark result.
+ */
+struct BenchmarkResult
+{
+	string name_;
+	size_t number_of_particles_;
+	size_t number_of_calls_;
+	Real seconds_per_call_;
+};
+/** time a function after one warm-up call */
+template <class Function>
+Real timePerCall(size_t calls, const Function& function)
+{
+	function();
+	tick_count time_instance = tick_count::now();
+	for (size_t i = 0; i != calls; ++i) function();
+	return (tick_count::now() - time_instance).seconds() / Real(calls);
+}
+/** time the kernel function and its derivative for deterministic distances within the cut-off radius */
+void benchmarkKernel(Kernel* kernel, StdVec<BenchmarkResult>& results)
+{
+	Real cutoff_radius = kernel->GetCutOffRadius();
+	Real sum = 0.0;
+	Real seconds = timePerCall(1, [&]() {
+		for (size_t i = 0; i != number_of_kernel_evaluations; ++i)
+		{
+			Real r = cutoff_radius * Real(i) / Real(number_of_kernel_evaluations);
+			sum += kernel->W(Vec2d(0.6 * r, 0.8 * r));
+		}
+		});
+	results.push_back({ kernel->GetKernelName() + "::W", 0, number_of_kernel_evaluations,
+		seconds / Real(number_of_kernel_evaluations) });
+	seconds = timePerCall(1, [&]() {
+		for (size_t i = 0; i != number_of_kernel_evaluations; ++i)
+		{
+			Real r = cutoff_radius * Real(i) / Real(number_of_kernel_evaluations);
+			sum += kernel->dW(Vec2d(0.6 * r, 0.8 * r));
+		}
+		});
+	results.push_back({ kernel->GetKernelName() + "::dW", 0, number_of_kernel_evaluations,
+		seconds / Real(number_of_kernel_evaluations) });
+	/** the sum is output so that the evaluations are not optimized away */
+	cout << kernel->GetKernelName() << " checksum " << sum << "\n";
+}
+/** check that a deterministic reduction gives the same bits with one thread and with all threads */
+template <class ReduceDynamics>
+bool checkDeterministicReduction(const string& name, ReduceDynamics& reduce_dynamics)
+{
+	reduce_dynamics.setDeterministicReduction(true);
+	Real single_thread_result = 0.0;
+	task_arena single_thread_arena(1);
+	single_thread_arena.execute([&]() { single_thread_result = reduce_dynamics.parallel_exec(); });
+	Real all_threads_result = reduce_dynamics.parallel_exec();
+	bool is_identical = single_thread_result == all_threads_result;
+	cout << name << (is_identical ? " deterministic " : " NOT deterministic ")
+		<< std::setprecision(17) << single_thread_result << " with 1 and "
+		<< all_threads_result << " with " << this_task_arena::max_concurrency() << " threads\n";
+	return is_identical;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	StdVec<BenchmarkResult> results;
+	string output_folder = "./output";
+	bool is_deterministic = true;
+
+	for (size_t n = 0; n != particle_spacings.size(); ++n)
+	{
+		Real particle_spacing_ref = particle_spacings[n];
+		Real BW = particle_spacing_ref * 4;
+		SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(LL + BW, LL + BW), particle_spacing_ref);
+		output_folder = sph_system.output_folder_;
+		GlobalStaticVariables::physical_time_ = 0.0;
+
+		FluidBlock* fluid_block = new FluidBlock(sph_system, "FluidBlock", 0);
+		FluidMaterial* fluid_material = new FluidMaterial();
+		FluidParticles 	fluid_particles(fluid_block, fluid_material);
+		/** the same particles in the cell linked list rebuilt by counting sort */
+		FluidBlock* flat_fluid_block = new FluidBlock(sph_system, "FlatFluidBlock", 0);
+		FluidParticles 	flat_fluid_particles(flat_fluid_block, new FluidMaterial());
+		flat_fluid_block->replaceMeshCellLinkedList(new FlatMeshCellLinkedList(flat_fluid_block,
+			sph_system.lower_bound_, sph_system.upper_bound_, flat_fluid_block->kernel_->GetCutOffRadius()));
+		/** the same particles in the cell linked list only storing the occupied cells */
+		FluidBlock* sparse_fluid_block = new FluidBlock(sph_system, "SparseFluidBlock", 0);
+		FluidParticles 	sparse_fluid_particles(sparse_fluid_block, new FluidMaterial());
+		SparseMeshCellLinkedList* sparse_cell_linked_list = new SparseMeshCellLinkedList(sparse_fluid_block,
+			sph_system.lower_bound_, sph_system.upper_bound_, sparse_fluid_block->kernel_->GetCutOffRadius());
+		sparse_fluid_block->replaceMeshCellLinkedList(sparse_cell_linked_list);
+
+		SolidBlock* solid_block = new SolidBlock(sph_system, "SolidBlock", 0);
+		SolidMaterial* solid_material = new SolidMaterial();
+		ElasticSolidParticles solid_particles(solid_block, solid_material);
+
+		SPHBodyInnerRelation* fluid_block_inner = new SPHBodyInnerRelation(fluid_block);
+		SPHBodyComplexRelation* fluid_block_complex = new SPHBodyComplexRelation(fluid_block_inner, {});
+		SPHBodyInnerRelation* solid_block_inner = new SPHBodyInnerRelation(solid_block);
+		/** the same fluid interactions with the compressed configuration */
+		SPHBodyInnerRelation* fluid_block_compressed_inner = new SPHBodyInnerRelation(fluid_block, true);
+		SPHBodyComplexRelation* fluid_block_compressed_complex
+			= new SPHBodyComplexRelation(fluid_block_compressed_inner, {});
+		SPHBodyInnerRelation* solid_block_compressed_inner = new SPHBodyInnerRelation(solid_block, true);
+		/** each particle pair is listed once for the pairwise interactions */
+		SPHBodyHalfInnerRelation* fluid_block_half_inner = new SPHBodyHalfInnerRelation(fluid_block);
+		SPHBodyComplexRelation* fluid_block_half_complex = new SPHBodyComplexRelation(fluid_block_half_inner, {});
+		SPHBodyHalfInnerRelation* solid_block_half_inner = new SPHBodyHalfInnerRelation(solid_block);
+		/** the configuration with Verlet skin is only refreshed as the particles do not move */
+		SPHBodyInnerRelation* fluid_block_skin_inner = new SPHBodyInnerRelation(fluid_block);
+		fluid_block_skin_inner->setSkinDistance(0.5 * particle_spacing_ref);
+
+		fluid_dynamics::DensityBySummation update_fluid_density(fluid_block_complex);
+		fluid_dynamics::PressureRelaxationFirstHalfRiemann pressure_relaxation_first_half(fluid_block_complex);
+		fluid_dynamics::DensityBySummation compressed_update_fluid_density(fluid_block_compressed_complex);
+		fluid_dynamics::PressureRelaxationFirstHalfRiemann 
+			compressed_pressure_relaxation_first_half(fluid_block_compressed_complex);
+		solid_dynamics::StressRelaxationFirstHalf compressed_stress_relaxation_first_half(solid_block_compressed_inner);
+		fluid_dynamics::ViscousAcceleration viscous_acceleration(fluid_block_complex);
+		fluid_dynamics::ViscousAccelerationPairwise pairwise_viscous_acceleration(fluid_block_half_complex);
+		solid_dynamics::StressRelaxationFirstHalfPairwise pairwise_stress_relaxation_first_half(solid_block_half_inner);
+		solid_dynamics::CorrectConfiguration solid_corrected_configuration(solid_block_inner);
+		solid_dynamics::StressRelaxationFirstHalf stress_relaxation_first_half(solid_block_inner);
+
+		sph_system.initializeSystemCellLinkedLists();
+		sph_system.initializeSystemConfigurations();
+		solid_corrected_configuration.parallel_exec();
+
+		size_t number_of_particles = fluid_block->number_of_particles_;
+		cout << "Benchmarks with " << number_of_particles << " particles.\n";
+		results.push_back({ "MeshCellLinkedList::UpdateCellLists", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block->mesh_cell_linked_list_->UpdateCellLists(); }) });
+		results.push_back({ "FlatMeshCellLinkedList::UpdateCellLists", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { flat_fluid_block->mesh_cell_linked_list_->UpdateCellLists(); }) });
+		results.push_back({ "SparseMeshCellLinkedList::UpdateCellLists", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { sparse_cell_linked_list->UpdateCellLists(); }) });
+		/** the cells left by the particles are evicted after they have been empty for the eviction age */
+		size_t stored_cells_before_shift = sparse_cell_linked_list->NumberOfStoredCells();
+		StdLargeVec<Vecd>& sparse_pos_n = sparse_fluid_particles.pos_n_;
+		Vecd cell_shift(sparse_cell_linked_list->CellSpacing(), 0.0);
+		for (size_t i = 0; i != number_of_particles; ++i) sparse_pos_n[i] += cell_shift;
+		results.push_back({ "SparseMeshCellLinkedList::UpdateCellLists(shifted)", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { sparse_cell_linked_list->UpdateCellLists(); }) });
+		cout << "SparseMeshCellLinkedList stored cells " << stored_cells_before_shift
+			<< " before and " << sparse_cell_linked_list->NumberOfStoredCells() << " after shifting one cell\n";
+		for (size_t i = 0; i != number_of_particles; ++i) sparse_pos_n[i] -= cell_shift;
+		results.push_back({ "SPHBodyInnerRelation::updateConfiguration", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block_inner->updateConfiguration(); }) });
+		results.push_back({ "SPHBodyInnerRelation::updateConfiguration(compressed)", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block_compressed_inner->updateConfiguration(); }) });
+		results.push_back({ "SPHBodyInnerRelation::updateConfiguration(skin)", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block_skin_inner->updateConfiguration(); }) });
+		results.push_back({ "sortingParticleData", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block->mesh_cell_linked_list_->sortingParticleData(); }) });
+		/** the cell lists and configuration are rebuilt after sorting */
+		fluid_block->mesh_cell_linked_list_->UpdateCellLists();
+		fluid_block_inner->updateConfiguration();
+		fluid_block_compressed_inner->updateConfiguration();
+		fluid_block_skin_inner->updateConfiguration();
+		fluid_block_half_inner->updateConfiguration();
+
+		LevelSet level_set(*fluid_block->body_shape_, Vec2d(-BW, -BW), Vec2d(LL + BW, LL + BW),
+			4.0 * fluid_block->particle_spacing_, 4);
+		StdLargeVec<Vecd>& pos_n = fluid_particles.pos_n_;
+		Real level_set_sum = 0.0;
+		results.push_back({ "LevelSet::probeLevelSet", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() {
+				for (size_t i = 0; i != number_of_particles; ++i) level_set_sum += level_set.probeLevelSet(pos_n[i]);
+				}) });
+		cout << "LevelSet checksum " << level_set_sum << "\n";
+
+		results.push_back({ "fluid_dynamics::DensityBySummation", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { update_fluid_density.parallel_exec(); }) });
+		results.push_back({ "fluid_dynamics::PressureRelaxationFirstHalfRiemann", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { pressure_relaxation_first_half.parallel_exec(0.0); }) });
+		results.push_back({ "fluid_dynamics::DensityBySummation(compressed)", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { compressed_update_fluid_density.parallel_exec(); }) });
+		results.push_back({ "fluid_dynamics::PressureRelaxationFirstHalfRiemann(compressed)", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { compressed_pressure_relaxation_first_half.parallel_exec(0.0); }) });
+		results.push_back({ "solid_dynamics::StressRelaxationFirstHalf", solid_block->number_of_particles_, number_of_calls,
+			timePerCall(number_of_calls, [&]() { stress_relaxation_first_half.parallel_exec(0.0); }) });
+		results.push_back({ "solid_dynamics::StressRelaxationFirstHalf(compressed)", solid_block->number_of_particles_, number_of_calls,
+			timePerCall(number_of_calls, [&]() { compressed_stress_relaxation_first_half.parallel_exec(0.0); }) });
+		results.push_back({ "fluid_dynamics::ViscousAcceleration", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { viscous_acceleration.parallel_exec(0.0); }) });
+		results.push_back({ "fluid_dynamics::ViscousAccelerationPairwise", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { pairwise_viscous_acceleration.parallel_exec(0.0); }) });
+		results.push_back({ "solid_dynamics::StressRelaxationFirstHalfPairwise", solid_block->number_of_particles_, number_of_calls,
+			timePerCall(number_of_calls, [&]() { pairwise_stress_relaxation_first_half.parallel_exec(0.0); }) });
+
+		/** the finest lattice gives several blocks for the deterministic reductions */
+		if (n + 1 == particle_spacings.size())
+		{
+			Gravity gravity(Vecd(0.0, -1.0));
+			fluid_dynamics::TotalMechanicalEnergy total_mechanical_energy(fluid_block, &gravity);
+			BlockByParticle block_by_particle(fluid_block, "BlockByParticle");
+			HeightSumByParticle height_sum_by_particle(fluid_block, &block_by_particle);
+			BlockByCell block_by_cell(fluid_block, "BlockByCell");
+			HeightSumByCell height_sum_by_cell(fluid_block, &block_by_cell);
+			is_deterministic = checkDeterministicReduction("fluid_dynamics::TotalMechanicalEnergy", total_mechanical_energy)
+				&& is_deterministic;
+			is_deterministic = checkDeterministicReduction("PartDynamicsByParticleReduce", height_sum_by_particle)
+				&& is_deterministic;
+			is_deterministic = checkDeterministicReduction("PartDynamicsByCellReduce", height_sum_by_cell)
+				&& is_deterministic;
+		}
+
+		if (n == 0)
+		{
+			Real smoothing_length = fluid_block->kernel_->GetSmoothingLength();
+			benchmarkKernel(new KernelWendlandC2(smoothing_length), results);
+			benchmarkKernel(new KernelHyperbolic(smoothing_length), results);
+			benchmarkKernel(new KernelTabulated<KernelWendlandC2>(smoothing_length, 20), results);
+		}
+	}
+
+	std::string filefullpath = output_folder + "/micro_benchmarks_2d.json";
+	std::ofstream out_file(filefullpath.c_str(), ios::trunc);
+	out_file << "{\n \"dimension\": 2,\n \"number_of_threads\": " << this_task_arena::max_concurrency()
+		<< ",\n \"deterministic_reductions\": " << (is_deterministic ? "true" : "false")
+		<< ",\n \"benchmarks\": [\n";
+	for (size_t i = 0; i != results.size(); ++i)
+	{
+		cout << std::left << std::setw(64) << results[i].name_ << std::right
+			<< std::setw(10) << results[i].number_of_particles_
+			<< std::setw(18) << std::scientific << std::setprecision(6) << results[i].seconds_per_call_ << " seconds per call.\n";
+		out_file << "  {\"name\": \"" << results[i].name_
+			<< "\", \"number_of_particles\": " << results[i].number_of_particles_
+			<< ", \"number_of_calls\": " << results[i].number_of_calls_
+			<< ", \"seconds_per_call\": " << std::scientific << std::setprecision(6) << results[i].seconds_per_call_
+			<< (i + 1 == results.size() ? "}\n" : "},\n");
+	}
+	out_file << " ]\n}\n";
+	out_file.close();
+
+	return is_deterministic ? 0 : 1;
+}
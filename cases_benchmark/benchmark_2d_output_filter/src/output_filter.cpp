@@ -0,0 +1,260 @@
+/**
+ * @file 	output_filter.cpp
+ * @brief 	2D benchmark of the body states files written with and without an output filter.
+ * @details The water block of the dambreak case collapses in the tank and its states are written
+ *			at the same output times by four writers: all particles in full precision and
+ *			every second particle with the velocity and density rounded to half precision,
+ *			each raw and compressed by zlib. Each writer has its own subfolder of the output folder.
+ *			The total size of the files and the wall time for writing them are reported for each writer.
+ *			The half precision values are written as Float32, so that they only reduce the compressed files.
+ *			The reference particle spacing (--dp), the number of threads (--t) and
+ *			the number of time steps (--n) are given from the command line, e.g.
+ *			./benchmark_2d_output_filter --dp 0.0125 --t 8 --n 1000.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 5.366; 						/**< Tank length. */
+Real DH = 5.366; 						/**< Tank height. */
+Real LL = 2.0; 							/**< Liquid colume length. */
+Real LH = 1.0; 							/**< Liquid colume height. */
+Real particle_spacing_ref = 0.025; 		/**< Default reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real gravity_g = 1.0;					/**< Gravity force of fluid. */
+Real U_max = 2.0*sqrt(gravity_g*LH);	/**< Characteristic velocity. */
+Real c_f = 10.0* U_max;					/**< Reference sound speed. */
+/**
+ * @brief Benchmark parameters.
+ */
+size_t default_number_of_time_steps = 1000;	/**< Number of time steps if not given from the command line. */
+size_t output_interval = 50;				/**< Time steps between two outputs of the body states. */
+/** create a water block shape */
+std::vector<Point> CreatWaterBlockShape()
+{
+	std::vector<Point> water_block_shape;
+	water_block_shape.push_back(Point(0.0, 0.0));
+	water_block_shape.push_back(Point(0.0, LH));
+	water_block_shape.push_back(Point(LL, LH));
+	water_block_shape.push_back(Point(LL, 0.0));
+	water_block_shape.push_back(Point(0.0, 0.0));
+	return water_block_shape;
+}
+/** create outer wall shape */
+std::vector<Point> CreatOuterWallShape()
+{
+	std::vector<Point> outer_wall_shape;
+	outer_wall_shape.push_back(Point(-BW, -BW));
+	outer_wall_shape.push_back(Point(-BW, DH + BW));
+	outer_wall_shape.push_back(Point(DL + BW, DH + BW));
+	outer_wall_shape.push_back(Point(DL + BW, -BW));
+	outer_wall_shape.push_back(Point(-BW, -BW));
+	return outer_wall_shape;
+}
+/** create inner wall shape */
+std::vector<Point> CreatInnerWallShape()
+{
+	std::vector<Point> inner_wall_shape;
+	inner_wall_shape.push_back(Point(0.0, 0.0));
+	inner_wall_shape.push_back(Point(0.0, DH));
+	inner_wall_shape.push_back(Point(DL, DH));
+	inner_wall_shape.push_back(Point(DL, 0.0));
+	inner_wall_shape.push_back(Point(0.0, 0.0));
+	return inner_wall_shape;
+}
+/**
+*@brief 	Fluid body definition.
+*/
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: FluidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> water_block_shape = CreatWaterBlockShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(water_block_shape, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name, int refinement_level)
+		: SolidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> outer_shape = CreatOuterWallShape();
+		std::vector<Point> inner_shape = CreatInnerWallShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(outer_shape, ShapeBooleanOps::add);
+		body_shape_->addAPolygon(inner_shape, ShapeBooleanOps::sub);
+	}
+};
+/**
+ * @brief 	A writer of the water block states into its own subfolder of the output folder.
+ */
+class BodyStatesWriter
+{
+public:
+	string name_;
+	In_Output in_output_;
+	WriteBodyStatesToVtu write_body_states_;
+	/** statistics for computing CPU time. */
+	tick_count::interval_t interval_writing_;
+
+	BodyStatesWriter(SPHSystem& sph_system, WaterBlock* water_block, const string& name,
+		bool compressed, OutputFilter* output_filter)
+		: name_(name), in_output_(sph_system),
+		write_body_states_(in_output_, { water_block }, VtuEncoding::raw, compressed)
+	{
+		write_body_states_.output_filter_ = output_filter;
+	};
+	/** the subfolders are created after all writers are constructed,
+	 *  as each in_output clears the output folder of a new run */
+	void createOutputFolder()
+	{
+		in_output_.output_folder_ += "/" + name_;
+		fs::create_directory(in_output_.output_folder_);
+	};
+
+	void write(WaterBlock* water_block, Real time)
+	{
+		tick_count time_instance = tick_count::now();
+		water_block->setNewlyUpdated();
+		write_body_states_.WriteToFile(time);
+		interval_writing_ += tick_count::now() - time_instance;
+	};
+	/** the size of the files, after the queued files are written */
+	void report()
+	{
+		tick_count time_instance = tick_count::now();
+		in_output_.output_pipeline_.flush();
+		interval_writing_ += tick_count::now() - time_instance;
+
+		size_t body_states_size = 0;
+		size_t number_of_files = 0;
+		for (fs::directory_iterator file(in_output_.output_folder_); file != fs::directory_iterator(); ++file)
+		{
+			if (file->path().extension() == ".vtu")
+			{
+				body_states_size += fs::file_size(file->path());
+				number_of_files++;
+			}
+		}
+		cout << fixed << setprecision(9) << name_
+			<< "	files = " << number_of_files
+			<< "	size = " << body_states_size << " bytes"
+			<< "	writing = " << interval_writing_.seconds() << " seconds.\n";
+	};
+};
+/**
+ * @brief 	Main program starts here.
+ */
+int main(int ac, char* av[])
+{
+	/**
+	 * @brief Build up -- a SPHSystem -- with the parameters from the command line.
+	 */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref);
+	/** The domain bounds are rescaled with the boundary width if the particle spacing is given. */
+	sph_system.boundary_width_ratio_ = BW / particle_spacing_ref;
+	sph_system.handleCommandlineOptions(ac, av);
+	particle_spacing_ref = sph_system.particle_spacing_ref_;
+	BW = sph_system.boundary_width_ratio_ * particle_spacing_ref;
+	size_t number_of_time_steps = sph_system.number_of_time_steps_ == 0
+		? default_number_of_time_steps : sph_system.number_of_time_steps_;
+	GlobalStaticVariables::physical_time_ = 0.0;
+
+	WaterBlock* water_block = new WaterBlock(sph_system, "WaterBody", 0);
+	FluidParticles 	fluid_particles(water_block, new WaterMaterial());
+	WallBoundary* wall_boundary = new WallBoundary(sph_system, "Wall", 0);
+	SolidParticles 		wall_particles(wall_boundary);
+
+	SPHBodyComplexRelation* water_block_complex_relation = new SPHBodyComplexRelation(water_block, { wall_boundary });
+
+	Gravity gravity(Vecd(0.0, -gravity_g));
+	InitializeATimeStep initialize_a_fluid_step(water_block, &gravity);
+	fluid_dynamics::DensityBySummationFreeSurface update_fluid_density(water_block_complex_relation);
+	fluid_dynamics::AdvectionTimeStepSize get_fluid_advection_time_step_size(water_block, U_max);
+	fluid_dynamics::AcousticTimeStepSize get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationFirstHalfRiemann pressure_relaxation_first_half(water_block_complex_relation);
+	fluid_dynamics::PressureRelaxationSecondHalfRiemann pressure_relaxation_second_half(water_block_complex_relation);
+	/**
+	 * @brief Output with and without the output filter.
+	 */
+	OutputFilter output_filter;
+	output_filter.setStride(2);
+	output_filter.setPrecision("Velocity", OutputPrecision::float16);
+	output_filter.setPrecision("Density", OutputPrecision::float16);
+	StdVec<BodyStatesWriter*> writers;
+	writers.push_back(new BodyStatesWriter(sph_system, water_block, "full", false, NULL));
+	writers.push_back(new BodyStatesWriter(sph_system, water_block, "filtered", false, &output_filter));
+	writers.push_back(new BodyStatesWriter(sph_system, water_block, "full_compressed", true, NULL));
+	writers.push_back(new BodyStatesWriter(sph_system, water_block, "filtered_compressed", true, &output_filter));
+	for (BodyStatesWriter* writer : writers) writer->createOutputFolder();
+
+	sph_system.initializeSystemCellLinkedLists();
+	sph_system.initializeSystemConfigurations();
+	wall_particles.initializeNormalDirectionFromGeometry();
+
+	for (BodyStatesWriter* writer : writers) writer->write(water_block, GlobalStaticVariables::physical_time_);
+
+	Real Dt = 0.0;			/**< Default advection time step sizes. */
+	Real dt = 0.0; 			/**< Default acoustic time step sizes. */
+	/**
+	 * @brief 	Main loop with the given number of advection steps.
+	 */
+	for (size_t number_of_iterations = 1; number_of_iterations <= number_of_time_steps; ++number_of_iterations)
+	{
+		initialize_a_fluid_step.parallel_exec();
+		Dt = get_fluid_advection_time_step_size.parallel_exec();
+		update_fluid_density.parallel_exec();
+
+		Real relaxation_time = 0.0;
+		while (relaxation_time < Dt)
+		{
+			pressure_relaxation_first_half.parallel_exec(dt);
+			pressure_relaxation_second_half.parallel_exec(dt);
+			dt = get_fluid_time_step_size.parallel_exec();
+			relaxation_time += dt;
+			GlobalStaticVariables::physical_time_ += dt;
+		}
+
+		water_block->updateCellLinkedList();
+		water_block_complex_relation->updateConfiguration();
+
+		if (number_of_iterations % output_interval == 0)
+		{
+			for (BodyStatesWriter* writer : writers) writer->write(water_block, GlobalStaticVariables::physical_time_);
+		}
+	}
+
+	cout << "Number of fluid particles: " << water_block->number_of_particles_ << "\n";
+	for (BodyStatesWriter* writer : writers) writer->report();
+
+	return 0;
+}
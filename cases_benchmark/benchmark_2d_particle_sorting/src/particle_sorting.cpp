@@ -0,0 +1,252 @@
+/**
+ * @file 	particle_sorting.cpp
+ * @brief 	2D benchmark of the adaptive particle sorting against the fixed sorting cadence.
+ * @details Two identical water blocks collapse in the same tank of the dambreak case.
+ *			The particle data of the first are sorted by AdaptiveParticleSorting,
+ *			the default policy of fluid bodies, and those of the second are sorted
+ *			every 100 cell linked list updates, the cadence used before the adaptive policy.
+ *			The water blocks do not interact with each other and are advanced with the same time step sizes,
+ *			so that they have the same particle positions and only differ in the ordering of the particle data.
+ *			For each policy, the number of sortings and the wall time of the neighbor loops
+ *			and of the configuration updates, which includes the sortings, are measured.
+ *			The reference particle spacing (--dp), the number of threads (--t) and
+ *			the number of time steps (--n) are given from the command line, e.g.
+ *			./benchmark_2d_particle_sorting --dp 0.0125 --t 8 --n 4000.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 5.366; 						/**< Tank length. */
+Real DH = 5.366; 						/**< Tank height. */
+Real LL = 2.0; 							/**< Liquid colume length. */
+Real LH = 1.0; 							/**< Liquid colume height. */
+Real particle_spacing_ref = 0.025; 		/**< Default reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real gravity_g = 1.0;					/**< Gravity force of fluid. */
+Real U_max = 2.0*sqrt(gravity_g*LH);	/**< Characteristic velocity. */
+Real c_f = 10.0* U_max;					/**< Reference sound speed. */
+/**
+ * @brief Benchmark parameters.
+ */
+size_t default_number_of_time_steps = 1000;	/**< Number of time steps if not given from the command line. */
+size_t fixed_sorting_interval = 100;		/**< Cell linked list updates between two sortings of the fixed cadence. */
+/** create a water block shape */
+std::vector<Point> CreatWaterBlockShape()
+{
+	std::vector<Point> water_block_shape;
+	water_block_shape.push_back(Point(0.0, 0.0));
+	water_block_shape.push_back(Point(0.0, LH));
+	water_block_shape.push_back(Point(LL, LH));
+	water_block_shape.push_back(Point(LL, 0.0));
+	water_block_shape.push_back(Point(0.0, 0.0));
+	return water_block_shape;
+}
+/** create outer wall shape */
+std::vector<Point> CreatOuterWallShape()
+{
+	std::vector<Point> outer_wall_shape;
+	outer_wall_shape.push_back(Point(-BW, -BW));
+	outer_wall_shape.push_back(Point(-BW, DH + BW));
+	outer_wall_shape.push_back(Point(DL + BW, DH + BW));
+	outer_wall_shape.push_back(Point(DL + BW, -BW));
+	outer_wall_shape.push_back(Point(-BW, -BW));
+	return outer_wall_shape;
+}
+/** create inner wall shape */
+std::vector<Point> CreatInnerWallShape()
+{
+	std::vector<Point> inner_wall_shape;
+	inner_wall_shape.push_back(Point(0.0, 0.0));
+	inner_wall_shape.push_back(Point(0.0, DH));
+	inner_wall_shape.push_back(Point(DL, DH));
+	inner_wall_shape.push_back(Point(DL, 0.0));
+	inner_wall_shape.push_back(Point(0.0, 0.0));
+	return inner_wall_shape;
+}
+/**
+*@brief 	Fluid body definition.
+*/
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: FluidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> water_block_shape = CreatWaterBlockShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(water_block_shape, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name, int refinement_level)
+		: SolidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> outer_shape = CreatOuterWallShape();
+		std::vector<Point> inner_shape = CreatInnerWallShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(outer_shape, ShapeBooleanOps::add);
+		body_shape_->addAPolygon(inner_shape, ShapeBooleanOps::sub);
+	}
+};
+/**
+ * @brief 	The water block with the methods used for time stepping, the same as in the dambreak case.
+ */
+class SortedWaterBlock
+{
+public:
+	WaterBlock* water_block_;
+	FluidParticles fluid_particles_;
+	SPHBodyComplexRelation* complex_relation_;
+	InitializeATimeStep initialize_a_fluid_step_;
+	fluid_dynamics::DensityBySummationFreeSurface update_fluid_density_;
+	fluid_dynamics::AdvectionTimeStepSize get_fluid_advection_time_step_size_;
+	fluid_dynamics::AcousticTimeStepSize get_fluid_time_step_size_;
+	fluid_dynamics::PressureRelaxationFirstHalfRiemann pressure_relaxation_first_half_;
+	fluid_dynamics::PressureRelaxationSecondHalfRiemann pressure_relaxation_second_half_;
+	/** statistics for computing CPU time. */
+	tick_count::interval_t interval_neighbor_loops_;
+	tick_count::interval_t interval_updating_configuration_;
+
+	SortedWaterBlock(WaterBlock* water_block, WaterMaterial* water_material,
+		WallBoundary* wall_boundary, Gravity* gravity)
+		: water_block_(water_block), fluid_particles_(water_block, water_material),
+		complex_relation_(new SPHBodyComplexRelation(water_block, { wall_boundary })),
+		initialize_a_fluid_step_(water_block, gravity),
+		update_fluid_density_(complex_relation_),
+		get_fluid_advection_time_step_size_(water_block, U_max),
+		get_fluid_time_step_size_(water_block),
+		pressure_relaxation_first_half_(complex_relation_),
+		pressure_relaxation_second_half_(complex_relation_) {};
+
+	void updateDensity()
+	{
+		initialize_a_fluid_step_.parallel_exec();
+		tick_count time_instance = tick_count::now();
+		update_fluid_density_.parallel_exec();
+		interval_neighbor_loops_ += tick_count::now() - time_instance;
+	};
+
+	void relaxPressure(Real dt)
+	{
+		tick_count time_instance = tick_count::now();
+		pressure_relaxation_first_half_.parallel_exec(dt);
+		pressure_relaxation_second_half_.parallel_exec(dt);
+		interval_neighbor_loops_ += tick_count::now() - time_instance;
+	};
+
+	void updateConfiguration()
+	{
+		tick_count time_instance = tick_count::now();
+		water_block_->updateCellLinkedList();
+		complex_relation_->updateConfiguration();
+		interval_updating_configuration_ += tick_count::now() - time_instance;
+	};
+
+	void report(const std::string& policy_name)
+	{
+		ParticleSortingPolicy* particle_sorting_policy = water_block_->particle_sorting_policy_;
+		cout << fixed << setprecision(9) << policy_name
+			<< "	sortings = " << particle_sorting_policy->TotalSortings()
+			<< "	cell linked list updates = " << particle_sorting_policy->TotalUpdates()
+			<< "	neighbor_loops = " << interval_neighbor_loops_.seconds()
+			<< "	updating_configuration = " << interval_updating_configuration_.seconds()
+			<< "	total = " << interval_neighbor_loops_.seconds() + interval_updating_configuration_.seconds()
+			<< " seconds.\n";
+	};
+};
+/**
+ * @brief 	Main program starts here.
+ */
+int main(int ac, char* av[])
+{
+	/**
+	 * @brief Build up -- a SPHSystem -- with the parameters from the command line.
+	 */
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref);
+	/** The domain bounds are rescaled with the boundary width if the particle spacing is given. */
+	sph_system.boundary_width_ratio_ = BW / particle_spacing_ref;
+	sph_system.handleCommandlineOptions(ac, av);
+	particle_spacing_ref = sph_system.particle_spacing_ref_;
+	BW = sph_system.boundary_width_ratio_ * particle_spacing_ref;
+	size_t number_of_time_steps = sph_system.number_of_time_steps_ == 0
+		? default_number_of_time_steps : sph_system.number_of_time_steps_;
+	GlobalStaticVariables::physical_time_ = 0.0;
+
+	WaterMaterial* water_material = new WaterMaterial();
+	WallBoundary* wall_boundary = new WallBoundary(sph_system, "Wall", 0);
+	SolidParticles 		wall_particles(wall_boundary);
+
+	Gravity gravity(Vecd(0.0, -gravity_g));
+	SortedWaterBlock adaptive_sorting(new WaterBlock(sph_system, "AdaptiveSortingWaterBody", 0),
+		water_material, wall_boundary, &gravity);
+	SortedWaterBlock fixed_sorting(new WaterBlock(sph_system, "FixedSortingWaterBody", 0),
+		water_material, wall_boundary, &gravity);
+	fixed_sorting.water_block_->setParticleSortingPolicy(
+		new ParticleSortingPolicy(fixed_sorting.water_block_, fixed_sorting_interval));
+
+	sph_system.initializeSystemCellLinkedLists();
+	sph_system.initializeSystemConfigurations();
+	wall_particles.initializeNormalDirectionFromGeometry();
+
+	Real Dt = 0.0;			/**< Default advection time step sizes. */
+	Real dt = 0.0; 			/**< Default acoustic time step sizes. */
+	/**
+	 * @brief 	Main loop with the given number of advection steps.
+	 */
+	for (size_t number_of_iterations = 0; number_of_iterations != number_of_time_steps; ++number_of_iterations)
+	{
+		adaptive_sorting.updateDensity();
+		fixed_sorting.updateDensity();
+		Dt = SMIN(adaptive_sorting.get_fluid_advection_time_step_size_.parallel_exec(),
+			fixed_sorting.get_fluid_advection_time_step_size_.parallel_exec());
+
+		Real relaxation_time = 0.0;
+		while (relaxation_time < Dt)
+		{
+			dt = SMIN(adaptive_sorting.get_fluid_time_step_size_.parallel_exec(),
+				fixed_sorting.get_fluid_time_step_size_.parallel_exec());
+			adaptive_sorting.relaxPressure(dt);
+			fixed_sorting.relaxPressure(dt);
+			relaxation_time += dt;
+			GlobalStaticVariables::physical_time_ += dt;
+		}
+
+		adaptive_sorting.updateConfiguration();
+		fixed_sorting.updateConfiguration();
+	}
+
+	cout << "Number of fluid particles of each water block: "
+		<< adaptive_sorting.water_block_->number_of_particles_ << "\n";
+	adaptive_sorting.report("adaptive");
+	fixed_sorting.report("fixed_every_" + std::to_string(fixed_sorting_interval));
+
+	return 0;
+}
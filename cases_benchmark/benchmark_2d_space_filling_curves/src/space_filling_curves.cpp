@@ -0,0 +1,175 @@
+/**
+ * @file 	space_filling_curves.cpp
+ * @brief 	2D benchmark of the space-filling curves for sorting particle data.
+ * @details The particles of a water block are sorted along the row-major, Morton and Hilbert curves
+ * 			in turn, and the wall time of the neighbor loops, i.e. density summation
+ * 			and pressure relaxation, is measured for each ordering.
+ * 			Since the particle states are not changed by the loops, the timings are comparable
+ * 			and the differences come from the memory access pattern of the neighbor loops.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 5.366; 						/**< Tank length. */
+Real DH = 5.366; 						/**< Tank height. */
+Real LL = 4.0; 							/**< Liquid colume length. */
+Real LH = 2.0; 							/**< Liquid colume height. */
+Real particle_spacing_ref = 0.01; 		/**< Initial reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real gravity_g = 1.0;					/**< Gravity force of fluid. */
+Real U_max = 2.0*sqrt(gravity_g*LH);	/**< Characteristic velocity. */
+Real c_f = 10.0* U_max;					/**< Reference sound speed. */
+/**
+ * @brief Benchmark parameters.
+ */
+size_t number_of_loops = 200;			/**< Number of timed neighbor loops for each curve. */
+/** create a water block shape */
+std::vector<Point> CreatWaterBlockShape()
+{
+	std::vector<Point> water_block_shape;
+	water_block_shape.push_back(Point(0.0, 0.0));
+	water_block_shape.push_back(Point(0.0, LH));
+	water_block_shape.push_back(Point(LL, LH));
+	water_block_shape.push_back(Point(LL, 0.0));
+	water_block_shape.push_back(Point(0.0, 0.0));
+	return water_block_shape;
+}
+/** create outer wall shape */
+std::vector<Point> CreatOuterWallShape()
+{
+	std::vector<Point> outer_wall_shape;
+	outer_wall_shape.push_back(Point(-BW, -BW));
+	outer_wall_shape.push_back(Point(-BW, DH + BW));
+	outer_wall_shape.push_back(Point(DL + BW, DH + BW));
+	outer_wall_shape.push_back(Point(DL + BW, -BW));
+	outer_wall_shape.push_back(Point(-BW, -BW));
+	return outer_wall_shape;
+}
+/** create inner wall shape */
+std::vector<Point> CreatInnerWallShape()
+{
+	std::vector<Point> inner_wall_shape;
+	inner_wall_shape.push_back(Point(0.0, 0.0));
+	inner_wall_shape.push_back(Point(0.0, DH));
+	inner_wall_shape.push_back(Point(DL, DH));
+	inner_wall_shape.push_back(Point(DL, 0.0));
+	inner_wall_shape.push_back(Point(0.0, 0.0));
+	return inner_wall_shape;
+}
+/**
+*@brief 	Fluid body definition.
+*/
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: FluidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> water_block_shape = CreatWaterBlockShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(water_block_shape, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name, int refinement_level)
+		: SolidBody(sph_system, body_name, refinement_level)
+	{
+		std::vector<Point> outer_shape = CreatOuterWallShape();
+		std::vector<Point> inner_shape = CreatInnerWallShape();
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addAPolygon(outer_shape, ShapeBooleanOps::add);
+		body_shape_->addAPolygon(inner_shape, ShapeBooleanOps::sub);
+	}
+};
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	SPHSystem sph_system(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW), particle_spacing_ref);
+	GlobalStaticVariables::physical_time_ = 0.0;
+
+	WaterBlock *water_block = new WaterBlock(sph_system, "WaterBody", 0);
+	WaterMaterial 	*water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_block, water_material);
+
+	WallBoundary *wall_boundary = new WallBoundary(sph_system, "Wall", 0);
+	SolidParticles 		wall_particles(wall_boundary);
+
+	SPHBodyComplexRelation* water_block_complex_relation = new SPHBodyComplexRelation(water_block, { wall_boundary });
+	/**
+	 * @brief 	The neighbor loops to be timed.
+	 */
+	fluid_dynamics::DensityBySummationFreeSurface 		update_fluid_density(water_block_complex_relation);
+	fluid_dynamics::PressureRelaxationFirstHalfRiemann
+		pressure_relaxation_first_half(water_block_complex_relation);
+
+	sph_system.initializeSystemCellLinkedLists();
+	sph_system.initializeSystemConfigurations();
+	wall_particles.initializeNormalDirectionFromGeometry();
+
+	StdVec<pair<string, SpaceFillingCurve>> space_filling_curves;
+	space_filling_curves.push_back(make_pair("row_major", SpaceFillingCurve::row_major));
+	space_filling_curves.push_back(make_pair("morton", SpaceFillingCurve::morton));
+	space_filling_curves.push_back(make_pair("hilbert", SpaceFillingCurve::hilbert));
+
+	cout << "Number of fluid particles: " << water_block->number_of_particles_ << "\n";
+	for (size_t n = 0; n != space_filling_curves.size(); ++n)
+	{
+		/** Sort the particles along the curve and rebuild the neighbor lists. */
+		water_block->mesh_cell_linked_list_->setSpaceFillingCurve(space_filling_curves[n].second);
+		water_block->mesh_cell_linked_list_->sortingParticleData();
+		water_block->mesh_cell_linked_list_->UpdateCellLists();
+		water_block_complex_relation->updateConfiguration();
+
+		/** With zero time step size, the pressure relaxation does not change particle states. */
+		tick_count::interval_t interval_density_summation;
+		tick_count::interval_t interval_pressure_relaxation;
+		tick_count time_instance;
+		for (size_t i = 0; i != number_of_loops; ++i)
+		{
+			time_instance = tick_count::now();
+			update_fluid_density.parallel_exec();
+			interval_density_summation += tick_count::now() - time_instance;
+
+			time_instance = tick_count::now();
+			pressure_relaxation_first_half.parallel_exec(0.0);
+			interval_pressure_relaxation += tick_count::now() - time_instance;
+		}
+
+		cout << fixed << setprecision(9) << space_filling_curves[n].first
+			<< "	density_summation = " << interval_density_summation.seconds() / Real(number_of_loops)
+			<< "	pressure_relaxation = " << interval_pressure_relaxation.seconds() / Real(number_of_loops)
+			<< " seconds per loop.\n";
+	}
+
+	return 0;
+}
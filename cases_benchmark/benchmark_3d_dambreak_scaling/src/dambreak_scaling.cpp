@@ -0,0 +1,280 @@
+/**
+ * @file 	dambreak_scaling.cpp
+ * @brief 	Strong and weak scaling driver based on the 3D dambreak case.
+ * @details The reference particle spacing (--dp), the number of threads (--t), the number of time steps (--n),
+ *			the output of body states (--o) and the Verlet skin distance of the relations
+ *			in reference particle spacing (--s) are given from the command line, e.g.
+ *			./benchmark_3d_dambreak_scaling --dp 0.025 --t 8 --n 500 --o 0.
+ *			Each run appends a record with the throughput in particles times steps per second,
+ *			the time of each phase and the parallel efficiency to dambreak_scaling_3d.jsonl as one JSON record per line.
+ *			The parallel efficiency is the throughput per thread relative to the throughput of a single-thread run
+ *			recorded earlier, with the same number of particles for strong scaling
+ *			or with the number of particles of each thread, within 10 percent, for weak scaling.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real DL = 5.366; 						/**< Tank length. */
+Real DH = 2.0; 							/**< Tank height. */
+Real DW = 0.5;							/**< Tank width. */
+Real LL = 2.0; 							/**< Liquid colume length. */
+Real LH = 1.0; 							/**< Liquid colume height. */
+Real LW = 0.5; 							/**< Liquid colume width. */
+Real particle_spacing_ref = 0.05; 		/**< Default reference particle spacing. */
+Real BW = particle_spacing_ref * 4; 	/**< Extending width for BCs. */
+int resolution(50);						/**< Resolution of the polygonal mesh of the bricks. */
+/**
+ * @brief Material properties of the fluid.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real gravity_g = 1.0;					/**< Gravity force of fluid. */
+Real U_max = 2.0*sqrt(gravity_g*LH);	/**< Characteristic velocity. */
+Real c_f = 10.0* U_max;					/**< Reference sound speed. */
+/**
+ * @brief Scaling parameters.
+ */
+size_t default_number_of_time_steps = 200;	/**< Number of time steps if not given from the command line. */
+size_t state_output_interval = 100;			/**< Number of time steps between the outputs of body states. */
+std::string scaling_record_file = "./dambreak_scaling_3d.jsonl"; /**< Kept out of the output folder, which is cleaned. */
+Real weak_scaling_tolerance = 0.1;	/**< Relative mismatch of the particles per thread accepted for weak scaling. */
+/**
+*@brief 	Fluid body definition.
+*/
+class WaterBlock : public FluidBody
+{
+public:
+	WaterBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: FluidBody(sph_system, body_name, refinement_level)
+	{
+		Vecd halfsize_water(0.5 * LL, 0.5 * LH, 0.5 * LW);
+		Vecd translation_water = halfsize_water;
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addBrick(halfsize_water, resolution, translation_water, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class WaterMaterial : public WeaklyCompressibleFluid
+{
+public:
+	WaterMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief 	Wall boundary body definition.
+ */
+class WallBoundary : public SolidBody
+{
+public:
+	WallBoundary(SPHSystem &sph_system, string body_name, int refinement_level)
+		: SolidBody(sph_system, body_name, refinement_level)
+	{
+		Vecd halfsize_outer(0.5 * DL + BW, 0.5 * DH + BW, 0.5 * DW + BW);
+		Vecd translation_wall(0.5 * DL, 0.5 * DH, 0.5 * DW);
+		Vecd halfsize_inner(0.5 * DL, 0.5 * DH, 0.5 * DW);
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addBrick(halfsize_outer, resolution, translation_wall, ShapeBooleanOps::add);
+		body_shape_->addBrick(halfsize_inner, resolution, translation_wall, ShapeBooleanOps::sub);
+	}
+};
+/** read a number field from a record line, return false if the field is not found */
+bool readRecordField(const std::string& record, const std::string& field, Real& value)
+{
+	std::string key = "\"" + field + "\": ";
+	size_t position = record.find(key);
+	if (position == std::string::npos) return false;
+	value = std::stod(record.substr(position + key.size()));
+	return true;
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main(int ac, char* av[])
+{
+	/**
+	 * @brief Build up -- a SPHSystem -- with the parameters from the command line.
+	 */
+	SPHSystem sph_system(Vec3d(-BW, -BW, -BW), Vec3d(DL + BW, DH + BW, DW + BW), particle_spacing_ref);
+	/** The domain bounds are rescaled with the boundary width if the particle spacing is given. */
+	sph_system.boundary_width_ratio_ = BW / particle_spacing_ref;
+	sph_system.handleCommandlineOptions(ac, av);
+	particle_spacing_ref = sph_system.particle_spacing_ref_;
+	BW = sph_system.boundary_width_ratio_ * particle_spacing_ref;
+	size_t number_of_time_steps = sph_system.number_of_time_steps_ == 0
+		? default_number_of_time_steps : sph_system.number_of_time_steps_;
+	GlobalStaticVariables::physical_time_ = 0.0;
+
+	WaterBlock *water_block = new WaterBlock(sph_system, "WaterBody", 0);
+	WaterMaterial 	*water_material = new WaterMaterial();
+	FluidParticles 	fluid_particles(water_block, water_material);
+
+	WallBoundary *wall_boundary = new WallBoundary(sph_system, "Wall", 0);
+	SolidParticles 		wall_particles(wall_boundary);
+
+	SPHBodyComplexRelation* water_block_complex_relation = new SPHBodyComplexRelation(water_block, { wall_boundary });
+	water_block_complex_relation->setSkinDistance(sph_system.skin_distance_ratio_ * particle_spacing_ref);
+	/**
+	 * @brief 	Methods used for time stepping, the same as in the dambreak case.
+	 */
+	Gravity 							gravity(Vecd(0.0, -gravity_g, 0.0));
+	InitializeATimeStep 	initialize_a_fluid_step(water_block, &gravity);
+	fluid_dynamics::DensityBySummationFreeSurface 		update_fluid_density(water_block_complex_relation);
+	fluid_dynamics::AdvectionTimeStepSize 			get_fluid_advection_time_step_size(water_block, U_max);
+	fluid_dynamics::AcousticTimeStepSize get_fluid_time_step_size(water_block);
+	fluid_dynamics::PressureRelaxationFirstHalfRiemann
+		pressure_relaxation_first_half(water_block_complex_relation);
+	fluid_dynamics::PressureRelaxationSecondHalfRiemann
+		pressure_relaxation_second_half(water_block_complex_relation);
+	pressure_relaxation_first_half.setGrainSizeTuning();
+	pressure_relaxation_second_half.setGrainSizeTuning();
+
+	In_Output in_output(sph_system);
+	WriteBodyStatesToVtu 		write_body_states(in_output, sph_system.real_bodies_);
+
+	sph_system.initializeSystemCellLinkedLists();
+	sph_system.initializeSystemConfigurations();
+	wall_particles.initializeNormalDirectionFromGeometry();
+
+	size_t number_of_particles = water_block->number_of_particles_;
+	int number_of_threads = this_task_arena::max_concurrency();
+	size_t number_of_acoustic_steps = 0;
+	Real Dt = 0.0;			/**< Default advection time step sizes. */
+	Real dt = 0.0; 			/**< Default acoustic time step sizes. */
+	/** statistics for computing CPU time. */
+	tick_count::interval_t interval_computing_time_step;
+	tick_count::interval_t interval_computing_pressure_relaxation;
+	tick_count::interval_t interval_updating_configuration;
+	tick_count::interval_t interval_output;
+	tick_count time_instance;
+	/**
+	 * @brief 	Main loop with the given number of advection steps.
+	 */
+	tick_count t1 = tick_count::now();
+	for (size_t number_of_iterations = 0; number_of_iterations != number_of_time_steps; ++number_of_iterations)
+	{
+		time_instance = tick_count::now();
+		initialize_a_fluid_step.parallel_exec();
+		Dt = get_fluid_advection_time_step_size.parallel_exec();
+		update_fluid_density.parallel_exec();
+		interval_computing_time_step += tick_count::now() - time_instance;
+
+		time_instance = tick_count::now();
+		Real relaxation_time = 0.0;
+		while (relaxation_time < Dt)
+		{
+			pressure_relaxation_first_half.parallel_exec(dt);
+			pressure_relaxation_second_half.parallel_exec(dt);
+			dt = get_fluid_time_step_size.parallel_exec();
+			relaxation_time += dt;
+			GlobalStaticVariables::physical_time_ += dt;
+			number_of_acoustic_steps++;
+		}
+		interval_computing_pressure_relaxation += tick_count::now() - time_instance;
+
+		time_instance = tick_count::now();
+		water_block->updateCellLinkedList();
+		water_block_complex_relation->updateConfiguration();
+		interval_updating_configuration += tick_count::now() - time_instance;
+
+		if (sph_system.state_output_ && (number_of_iterations + 1) % state_output_interval == 0)
+		{
+			time_instance = tick_count::now();
+			write_body_states.WriteToFile(GlobalStaticVariables::physical_time_);
+			interval_output += tick_count::now() - time_instance;
+		}
+	}
+	tick_count::interval_t interval_total = tick_count::now() - t1;
+	/** The throughput is measured without the output. */
+	Real computing_time = interval_total.seconds() - interval_output.seconds();
+	Real particle_steps_per_second = Real(number_of_particles * number_of_time_steps) / computing_time;
+	Real particle_acoustic_steps_per_second = Real(number_of_particles * number_of_acoustic_steps) / computing_time;
+	/**
+	 * @brief 	Parallel efficiency from the single-thread runs recorded earlier.
+	 */
+	std::string scaling_type = "none";
+	Real parallel_efficiency = 1.0;
+	if (number_of_threads == 1)
+	{
+		scaling_type = "baseline";
+	}
+	else
+	{
+		Real baseline_throughput = 0.0;
+		Real weak_baseline_throughput = 0.0;
+		/** the weak scaling baseline has the same number of particles as each thread of this run */
+		Real particles_per_thread = Real(number_of_particles) / Real(number_of_threads);
+		Real weak_baseline_mismatch = weak_scaling_tolerance;
+		std::ifstream in_file(scaling_record_file.c_str());
+		std::string record;
+		while (std::getline(in_file, record))
+		{
+			Real threads = 0.0, particles = 0.0, throughput = 0.0, skin_distance_ratio = 0.0;
+			/** the records without skin distance are given with zero skin */
+			readRecordField(record, "skin_distance_ratio", skin_distance_ratio);
+			if (skin_distance_ratio != sph_system.skin_distance_ratio_) continue;
+			if (!readRecordField(record, "number_of_threads", threads) || threads != 1.0
+				|| !readRecordField(record, "number_of_particles", particles)
+				|| !readRecordField(record, "particle_steps_per_second", throughput)) continue;
+			if (size_t(particles) == number_of_particles)
+			{
+				scaling_type = "strong";
+				baseline_throughput = throughput;
+			}
+			else
+			{
+				/** the closest to the particles per thread, the latest one of equally close runs */
+				Real mismatch = fabs(particles - particles_per_thread) / particles_per_thread;
+				if (mismatch <= weak_baseline_mismatch)
+				{
+					weak_baseline_mismatch = mismatch;
+					weak_baseline_throughput = throughput;
+				}
+			}
+		}
+		in_file.close();
+		if (scaling_type != "strong" && weak_baseline_throughput > 0.0)
+		{
+			scaling_type = "weak";
+			baseline_throughput = weak_baseline_throughput;
+		}
+		parallel_efficiency = baseline_throughput > 0.0
+			? particle_steps_per_second / Real(number_of_threads) / baseline_throughput : 0.0;
+	}
+
+	std::ofstream out_file(scaling_record_file.c_str(), ios::app);
+	out_file << std::scientific << std::setprecision(6)
+		<< "{\"case\": \"dambreak_3d\", \"particle_spacing\": " << particle_spacing_ref
+		<< ", \"number_of_particles\": " << number_of_particles
+		<< ", \"number_of_threads\": " << number_of_threads
+		<< ", \"number_of_time_steps\": " << number_of_time_steps
+		<< ", \"number_of_acoustic_steps\": " << number_of_acoustic_steps
+		<< ", \"state_output\": " << (sph_system.state_output_ ? "true" : "false")
+		<< ", \"skin_distance_ratio\": " << sph_system.skin_distance_ratio_
+		<< ", \"wall_time\": " << interval_total.seconds()
+		<< ", \"time_step\": " << interval_computing_time_step.seconds()
+		<< ", \"pressure_relaxation\": " << interval_computing_pressure_relaxation.seconds()
+		<< ", \"updating_configuration\": " << interval_updating_configuration.seconds()
+		<< ", \"output\": " << interval_output.seconds()
+		<< ", \"particle_steps_per_second\": " << particle_steps_per_second
+		<< ", \"particle_acoustic_steps_per_second\": " << particle_acoustic_steps_per_second
+		<< ", \"scaling\": \"" << scaling_type << "\""
+		<< ", \"parallel_efficiency\": " << parallel_efficiency << "}\n";
+	out_file.close();
+
+	cout << fixed << setprecision(9) << "Particles = " << number_of_particles << "	Threads = " << number_of_threads
+		<< "	Particle steps per second = " << particle_steps_per_second
+		<< "	Parallel efficiency (" << scaling_type << ") = " << parallel_efficiency << "\n";
+
+	return 0;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file 	micro_benchmarks.cpp
+ * @brief 	3D micro-benchmarks of the kernels, cell linked lists, neighbor search,
+ *			particle sorting, level set and interaction loops.
+ * @details Cubic blocks of lattice particles with several resolutions are generated,
+ *			so that the particle sets are the same for every run.
+ *			The interaction loops are executed with zero time step size so that the particle states,
+ *			and hence the timings, do not drift between the repeated calls.
+ *			The results are printed and written as JSON into the output folder for tracking regressions.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+using namespace SPH;
+/**
+ * @brief Basic geometry parameters and numerical setup.
+ */
+Real LL = 1.0; 									/**< Block length. */
+StdVec<Real> particle_spacings = { 0.1, 0.05, 0.025 }; /**< Resolutions of the particle lattices. */
+int resolution(20);								/**< Resolution of the polygonal mesh of the block. */
+/**
+ * @brief Material properties.
+ */
+Real rho0_f = 1.0;						/**< Reference density of fluid. */
+Real c_f = 10.0;						/**< Reference sound speed. */
+Real rho0_s = 1.0e3;					/**< Reference density of solid. */
+Real Youngs_modulus = 2.0e6;			/**< Young's modulus of solid. */
+Real poisson = 0.3975;					/**< Poisson ratio of solid. */
+/**
+ * @brief Benchmark parameters.
+ */
+size_t number_of_kernel_evaluations = 1000000;	/**< Number of evaluations for timing the kernels. */
+size_t number_of_calls = 20;					/**< Number of timed calls for the other benchmarks. */
+/**
+*@brief 	Fluid body definition.
+*/
+class FluidBlock : public FluidBody
+{
+public:
+	FluidBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: FluidBody(sph_system, body_name, refinement_level)
+	{
+		Vecd halfsize_block(0.5 * LL, 0.5 * LL, 0.5 * LL);
+		Vecd translation_block = halfsize_block;
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addBrick(halfsize_block, resolution, translation_block, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief 	Case dependent material properties definition.
+ */
+class FluidMaterial : public WeaklyCompressibleFluid
+{
+public:
+	FluidMaterial() : WeaklyCompressibleFluid()
+	{
+		rho_0_ = rho0_f;
+		c_0_ = c_f;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+*@brief 	Solid body definition.
+*/
+class SolidBlock : public SolidBody
+{
+public:
+	SolidBlock(SPHSystem& sph_system, string body_name, int refinement_level)
+		: SolidBody(sph_system, body_name, refinement_level)
+	{
+		Vecd halfsize_block(0.5 * LL, 0.5 * LL, 0.5 * LL);
+		Vecd translation_block = halfsize_block;
+		body_shape_ = new ComplexShape(body_name);
+		body_shape_->addBrick(halfsize_block, resolution, translation_block, ShapeBooleanOps::add);
+	}
+};
+/**
+ * @brief Define solid material.
+ */
+class SolidMaterial : public LinearElasticSolid
+{
+public:
+	SolidMaterial() : LinearElasticSolid()
+	{
+		rho_0_ = rho0_s;
+		E_0_ = Youngs_modulus;
+		nu_ = poisson;
+
+		assignDerivedMaterialParameters();
+	}
+};
+/**
+ * @brief A benchmark result.
+ */
+struct BenchmarkResult
+{
+	string name_;
+	size_t number_of_particles_;
+	size_t number_of_calls_;
+	Real seconds_per_call_;
+};
+/** time a function after one warm-up call */
+template <class Function>
+Real timePerCall(size_t calls, const Function& function)
+{
+	function();
+	tick_count time_instance = tick_count::now();
+	for (size_t i = 0; i != calls; ++i) function();
+	return (tick_count::now() - time_instance).seconds() / Real(calls);
+}
+/** time the kernel function and its derivative for deterministic distances within the cut-off radius */
+void benchmarkKernel(Kernel* kernel, StdVec<BenchmarkResult>& results)
+{
+	Real cutoff_radius = kernel->GetCutOffRadius();
+	Real sum = 0.0;
+	Real seconds = timePerCall(1, [&]() {
+		for (size_t i = 0; i != number_of_kernel_evaluations; ++i)
+		{
+			Real r = cutoff_radius * Real(i) / Real(number_of_kernel_evaluations);
+			sum += kernel->W(Vec3d(0.48 * r, 0.6 * r, 0.64 * r));
+		}
+		});
+	results.push_back({ kernel->GetKernelName() + "::W", 0, number_of_kernel_evaluations,
+		seconds / Real(number_of_kernel_evaluations) });
+	seconds = timePerCall(1, [&]() {
+		for (size_t i = 0; i != number_of_kernel_evaluations; ++i)
+		{
+			Real r = cutoff_radius * Real(i) / Real(number_of_kernel_evaluations);
+			sum += kernel->dW(Vec3d(0.48 * r, 0.6 * r, 0.64 * r));
+		}
+		});
+	results.push_back({ kernel->GetKernelName() + "::dW", 0, number_of_kernel_evaluations,
+		seconds / Real(number_of_kernel_evaluations) });
+	/** the sum is output so that the evaluations are not optimized away */
+	cout << kernel->GetKernelName() << " checksum " << sum << "\n";
+}
+/**
+ * @brief 	Main program starts here.
+ */
+int main()
+{
+	StdVec<BenchmarkResult> results;
+	string output_folder = "./output";
+
+	for (size_t n = 0; n != particle_spacings.size(); ++n)
+	{
+		Real particle_spacing_ref = particle_spacings[n];
+		Real BW = particle_spacing_ref * 4;
+		SPHSystem sph_system(Vec3d(-BW, -BW, -BW), Vec3d(LL + BW, LL + BW, LL + BW), particle_spacing_ref);
+		output_folder = sph_system.output_folder_;
+		GlobalStaticVariables::physical_time_ = 0.0;
+
+		FluidBlock* fluid_block = new FluidBlock(sph_system, "FluidBlock", 0);
+		FluidMaterial* fluid_material = new FluidMaterial();
+		FluidParticles 	fluid_particles(fluid_block, fluid_material);
+
+		SolidBlock* solid_block = new SolidBlock(sph_system, "SolidBlock", 0);
+		SolidMaterial* solid_material = new SolidMaterial();
+		ElasticSolidParticles solid_particles(solid_block, solid_material);
+
+		SPHBodyInnerRelation* fluid_block_inner = new SPHBodyInnerRelation(fluid_block);
+		SPHBodyComplexRelation* fluid_block_complex = new SPHBodyComplexRelation(fluid_block_inner, {});
+		SPHBodyInnerRelation* solid_block_inner = new SPHBodyInnerRelation(solid_block);
+
+		fluid_dynamics::DensityBySummation update_fluid_density(fluid_block_complex);
+		fluid_dynamics::PressureRelaxationFirstHalfRiemann pressure_relaxation_first_half(fluid_block_complex);
+		solid_dynamics::CorrectConfiguration solid_corrected_configuration(solid_block_inner);
+		solid_dynamics::StressRelaxationFirstHalf stress_relaxation_first_half(solid_block_inner);
+
+		sph_system.initializeSystemCellLinkedLists();
+		sph_system.initializeSystemConfigurations();
+		solid_corrected_configuration.parallel_exec();
+
+		size_t number_of_particles = fluid_block->number_of_particles_;
+		cout << "Benchmarks with " << number_of_particles << " particles.\n";
+		results.push_back({ "MeshCellLinkedList::UpdateCellLists", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block->mesh_cell_linked_list_->UpdateCellLists(); }) });
+		results.push_back({ "SPHBodyInnerRelation::updateConfiguration", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block_inner->updateConfiguration(); }) });
+		results.push_back({ "sortingParticleData", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { fluid_block->mesh_cell_linked_list_->sortingParticleData(); }) });
+		/** the cell lists and configuration are rebuilt after sorting */
+		fluid_block->mesh_cell_linked_list_->UpdateCellLists();
+		fluid_block_inner->updateConfiguration();
+
+		LevelSet level_set(*fluid_block->body_shape_, Vec3d(-BW, -BW, -BW), Vec3d(LL + BW, LL + BW, LL + BW),
+			4.0 * fluid_block->particle_spacing_, 4);
+		StdLargeVec<Vecd>& pos_n = fluid_particles.pos_n_;
+		Real level_set_sum = 0.0;
+		results.push_back({ "LevelSet::probeLevelSet", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() {
+				for (size_t i = 0; i != number_of_particles; ++i) level_set_sum += level_set.probeLevelSet(pos_n[i]);
+				}) });
+		cout << "LevelSet checksum " << level_set_sum << "\n";
+
+		results.push_back({ "fluid_dynamics::DensityBySummation", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { update_fluid_density.parallel_exec(); }) });
+		results.push_back({ "fluid_dynamics::PressureRelaxationFirstHalfRiemann", number_of_particles, number_of_calls,
+			timePerCall(number_of_calls, [&]() { pressure_relaxation_first_half.parallel_exec(0.0); }) });
+		results.push_back({ "solid_dynamics::StressRelaxationFirstHalf", solid_block->number_of_particles_, number_of_calls,
+			timePerCall(number_of_calls, [&]() { stress_relaxation_first_half.parallel_exec(0.0); }) });
+
+		if (n == 0)
+		{
+			Real smoothing_length = fluid_block->kernel_->GetSmoothingLength();
+			benchmarkKernel(new KernelWendlandC2(smoothing_length), results);
+			benchmarkKernel(new KernelHyperbolic(smoothing_length), results);
+			benchmarkKernel(new KernelTabulated<KernelWendlandC2>(smoothing_length, 20), results);
+		}
+	}
+
+	std::string filefullpath = output_folder + "/micro_benchmarks_3d.json";
+	std::ofstream out_file(filefullpath.c_str(), ios::trunc);
+	out_file << "{\n \"dimension\": 3,\n \"number_of_threads\": " << this_task_arena::max_concurrency()
+		<< ",\n \"benchmarks\": [\n";
+	for (size_t i = 0; i != results.size(); ++i)
+	{
+		cout << std::left << std::setw(56) << results[i].name_ << std::right
+			<< std::setw(10) << results[i].number_of_particles_
+			<< std::setw(18) << std::scientific << std::setprecision(6) << results[i].seconds_per_call_ << " seconds per call.\n";
+		out_file << "  {\"name\": \"" << results[i].name_
+			<< "\", \"number_of_particles\": " << results[i].number_of_particles_
+			<< ", \"number_of_calls\": " << results[i].number_of_calls_
+			<< ", \"seconds_per_call\": " << std::scientific << std::setprecision(6) << results[i].seconds_per_call_
+			<< (i + 1 == results.size() ? "}\n" : "},\n");
+	}
+	out_file << " ]\n}\n";
+	out_file.close();
+
+	return 0;
+}
@@ -186,6 +186,9 @@ WaterBlock *water_block = new WaterBlock(sph_system, "WaterBody", 0);
 		pressure_relaxation_first_half(water_block_complex_relation);
 	fluid_dynamics::PressureRelaxationSecondHalfRiemann 
 		pressure_relaxation_second_half(water_block_complex_relation);
+	/** Fused execution of the pressure relaxation and the acoustic time step size. */
+	FusedParticleDynamics1Level<Real, ReduceMax> fused_pressure_relaxation(&pressure_relaxation_first_half,
+		&pressure_relaxation_second_half, &get_fluid_time_step_size);
 
 	/**
 	 * @brief Output.
@@ -262,9 +265,7 @@ WaterBlock *water_block = new WaterBlock(sph_system, "WaterBody", 0);
 			Real relaxation_time = 0.0;
 			while (relaxation_time < Dt)
 			{
-				pressure_relaxation_first_half.parallel_exec(dt);
-				pressure_relaxation_second_half.parallel_exec(dt);
-				dt = get_fluid_time_step_size.parallel_exec();
+				dt = fused_pressure_relaxation.parallel_exec(dt);
 				relaxation_time += dt;
 				integration_time += dt;
 				GlobalStaticVariables::physical_time_ += dt;
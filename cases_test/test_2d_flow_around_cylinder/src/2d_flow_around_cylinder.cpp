@@ -16,8 +16,9 @@ int main(int ac, char* av[])
 {
 	/** Build up -- a SPHSystem -- */
 	SPHSystem system(Vec2d(- DL_sponge, - DH_sponge), Vec2d(DL, DH + DH_sponge), particle_spacing_ref);
-	/** Tag for run particle relaxation for the initial body fitted distribution. */
-	system.run_particle_relaxation_ = true;
+	/** Tag for run particle relaxation for the initial body fitted distribution.
+	  * The relaxation is also run if the reload files are missing or stale. */
+	system.run_particle_relaxation_ = false;
 	/** Tag for computation start with relaxed body fitted particles distribution. */
 	system.reload_particles_ = true;
 	/** Tag for computation from restart files. 0: start with initial condition. */
@@ -54,8 +55,16 @@ int main(int ac, char* av[])
 	SPHBodyContactRelation* cylinder_contact = new SPHBodyContactRelation(cylinder, { water_block });
 	SPHBodyContactRelation* fluid_observer_contact = new SPHBodyContactRelation(fluid_observer, { water_block });
 
+	/** The reload files are checked for the present resolution and shapes. */
+	ReadReloadParticle read_particle_reload_files(in_output, { cylinder }, { "InsertedBody" });
+	bool is_relaxation_only = system.run_particle_relaxation_;
+	bool is_reload_outdated = system.reload_particles_ && !read_particle_reload_files.checkReloadFiles();
+	if (is_reload_outdated)
+	{
+		std::cout << "\n The particle reload files are missing or stale, the particles are relaxed first." << std::endl;
+	}
 	/** check whether run particle relaxation for body fitted particle distribution. */
-	if (system.run_particle_relaxation_) 
+	if (system.run_particle_relaxation_ || is_reload_outdated)
 	{
 		/** body topology only for particle realxation */
 		SPHBodyInnerRelation* cylinder_inner = new SPHBodyInnerRelation(cylinder);
@@ -94,7 +103,8 @@ int main(int ac, char* av[])
 
 		/** Output results. */
 		write_particle_reload_files.WriteToFile(0.0);
-		return 0;
+		/** the simulation goes on with the reload files just written, unless only the relaxation is asked for */
+		if (is_relaxation_only) return 0;
 	}
 	/**
 	 * @brief 	Methods used for time stepping.
@@ -147,9 +157,7 @@ int main(int ac, char* av[])
 	 */
 	 /** Using relaxed particle distribution if needed. */
 	if (system.reload_particles_) {
-		unique_ptr<ReadReloadParticle>	
-			reload_insert_body_particles(new ReadReloadParticle(in_output, { cylinder }, { "InsertedBody" }));
-		reload_insert_body_particles->ReadFromFile();
+		read_particle_reload_files.ReadFromFile();
 	}
 	/** initialize cell linked lists for all bodies. */
 	system.initializeSystemCellLinkedLists();
@@ -193,6 +193,19 @@ int main(int ac, char* av[])
 	/** computing linear reproducing configuration for the insert body. */
 	inserted_body_corrected_configuration_in_strong_form.parallel_exec();
 
+	/** The configuration updates as a graph, in which the updates of the two bodies run concurrently. */
+	ParticleDynamicsGraph update_configuration;
+	update_configuration.addCellLinkedListUpdate(inserted_body);
+	update_configuration.addDynamics(&periodic_condition.bounding_, {}, { water_block });
+	update_configuration.addCellLinkedListUpdate(water_block);
+	update_configuration.addDynamics(&periodic_condition.update_cell_linked_list_,
+		{ water_block }, { water_block->mesh_cell_linked_list_ });
+	/** one need update configuration after periodic condition. */
+	update_configuration.addConfigurationUpdate(water_block_complex, { water_block, water_block->mesh_cell_linked_list_,
+		inserted_body, inserted_body->mesh_cell_linked_list_ });
+	update_configuration.addConfigurationUpdate(inserted_body_contact, { inserted_body, inserted_body->mesh_cell_linked_list_,
+		water_block, water_block->mesh_cell_linked_list_ });
+
 	/**
 	 * @brief The time stepping starts here.
 	 */
@@ -286,15 +299,8 @@ int main(int ac, char* av[])
 			}
 			number_of_iterations++;
 
-			/** Water block configuration and periodic condition. */
-			periodic_condition.bounding_.parallel_exec();
-
-			water_block->updateCellLinkedList();
-			periodic_condition.update_cell_linked_list_.parallel_exec();
-			water_block_complex->updateConfiguration();
-			/** one need update configuration after periodic condition. */
-			inserted_body->updateCellLinkedList();
-			inserted_body_contact->updateConfiguration();
+			/** Water block configuration and periodic condition, and the inserted body configuration. */
+			update_configuration.parallel_exec();
 			/** write run-time observation into file */
 			write_beam_tip_displacement.WriteToFile(GlobalStaticVariables::physical_time_);
 		}
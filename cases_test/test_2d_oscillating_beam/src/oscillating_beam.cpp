@@ -195,10 +195,10 @@ int main()
 	//time step size calculation
 	solid_dynamics::AcousticTimeStepSize computing_time_step_size(beam_body);
 
-	//stress relaxation for the beam
-	solid_dynamics::StressRelaxationFirstHalf
+	//stress relaxation for the beam, with the particle functions inlined into the loops
+	InlinedParticleDynamics1Level<solid_dynamics::StressRelaxationFirstHalf>
 		stress_relaxation_first_half(beam_body_inner);
-	solid_dynamics::StressRelaxationSecondHalf
+	InlinedParticleDynamics1Level<solid_dynamics::StressRelaxationSecondHalf>
 		stress_relaxation_second_half(beam_body_inner);
 
 	/**
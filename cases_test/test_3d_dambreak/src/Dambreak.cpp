@@ -146,12 +146,17 @@ int main()
 		pressure_relaxation_first_half(water_block_complex);
 	fluid_dynamics::PressureRelaxationSecondHalfRiemann 
 		pressure_relaxation_second_half(water_block_complex);
+	/** The grain sizes of the pressure relaxation loops are tuned during the first time steps. */
+	pressure_relaxation_first_half.setGrainSizeTuning();
+	pressure_relaxation_second_half.setGrainSizeTuning();
 
 	//-----------------------------------------------------------------------------
 	//outputs
 	//-----------------------------------------------------------------------------
 	In_Output in_output(system);
-	WriteBodyStatesToVtu write_water_block_states(in_output, system.real_bodies_);
+	/** All output times of all bodies are appended to output/SPHBodies_<restart step>.sphc,
+	 *  which is exported into vtu files by tools/particle_container_export. */
+	WriteBodyStatesToContainer write_water_block_states(in_output, system.real_bodies_);
 	/** Output the body states for restart simulation. */
 	ReadRestart		read_restart_files(in_output, system.real_bodies_);
 	WriteRestart	write_restart_files(in_output, system.real_bodies_);
@@ -248,7 +253,7 @@ int main()
 		write_water_mechanical_energy.WriteToFile(GlobalStaticVariables::physical_time_);
 
 		tick_count t2 = tick_count::now();
-		write_water_block_states.WriteToFile(GlobalStaticVariables::physical_time_ * 0.001);
+		write_water_block_states.WriteToFile(GlobalStaticVariables::physical_time_);
 		tick_count t3 = tick_count::now();
 		interval += t3 - t2;
 	}
@@ -144,6 +144,8 @@ int main()
 
 	/** topology */
 	SPHBodyInnerRelation* myocardium_body_inner = new SPHBodyInnerRelation(myocardium_body);
+	/** each particle pair is listed once for the pairwise stress relaxation */
+	SPHBodyHalfInnerRelation* myocardium_body_half_inner = new SPHBodyHalfInnerRelation(myocardium_body);
 	SPHBodyContactRelation* myocardium_observer_contact = new SPHBodyContactRelation(myocardium_observer, { myocardium_body });
 
 	/** 
@@ -158,7 +160,7 @@ int main()
 	solid_dynamics::AcousticTimeStepSize 
 		computing_time_step_size(myocardium_body);
 	/** active and passive stress relaxation. */
-	solid_dynamics::StressRelaxationFirstHalf stress_relaxation_first_half(myocardium_body_inner);
+	solid_dynamics::StressRelaxationFirstHalfPairwise stress_relaxation_first_half(myocardium_body_half_inner);
 	solid_dynamics::StressRelaxationSecondHalf stress_relaxation_second_half(myocardium_body_inner);
 	/** Constrain the holder. */
 	solid_dynamics::ConstrainSolidBodyRegion
@@ -163,6 +163,7 @@ int main()
 		constrain_holder(myocardium_body, new Holder(myocardium_body, "Holder"));
 	DampingBySplittingWithRandomChoice<SPHBodyInnerRelation, DampingBySplittingPairwise<Vec3d>, Vec3d>
 		muscle_damping(myocardium_body_inner, 0.1, myocardium_particles.vel_n_, physical_viscosity);
+	muscle_damping.setWavefrontScheduling(true);
 	/** Output */
 	In_Output in_output(system);
 	WriteBodyStatesToVtu write_states(in_output, system.real_bodies_);
@@ -41,4 +41,11 @@ IF(Boost_FOUND)
      MESSAGE("${Boost_LIBRARIES}")
 ELSE(Boost_FOUND)
      MESSAGE(FATAL_ERROR "Boost library not found")
-ENDIF(Boost_FOUND)
\ No newline at end of file
+ENDIF(Boost_FOUND)
+
+IF(_VTU_ZLIB_COMPRESSION_)
+    FIND_PACKAGE(ZLIB REQUIRED)
+    INCLUDE_DIRECTORIES("${ZLIB_INCLUDE_DIRS}")
+    MESSAGE("${ZLIB_INCLUDE_DIRS}")
+    MESSAGE("${ZLIB_LIBRARIES}")
+ENDIF(_VTU_ZLIB_COMPRESSION_)
@@ -0,0 +1,40 @@
+/**
+ * @file 	particle_container_export.cpp
+ * @brief 	Exports the records of a particle container into vtu files and a pvd series.
+ * @details The container is written by WriteBodyStatesToContainer, e.g. output/SPHBodies_0.sphc.
+ *			Each record is written into a vtu file named by the body and the index of the record,
+ *			and the series SPHBodies.pvd in the output folder gives the files of all bodies at each output time.
+ *			Usage: ./particle_container_export <container file> [output folder] [raw|base64] [compressed],
+ *			the output folder is ./container_vtu by default, e.g.
+ *			./particle_container_export output/SPHBodies_0.sphc output_vtu base64.
+ * @author 	Luhui Han, Chi Zhang and Xiangyu Hu
+ * @version 0.1
+ */
+#include "sphinxsys.h"
+
+using namespace SPH;
+/**
+ * @brief 	Main program starts here.
+ */
+int main(int ac, char* av[])
+{
+	if (ac < 2)
+	{
+		cout << "Usage: " << av[0] << " <container file> [output folder] [raw|base64] [compressed]\n";
+		return 1;
+	}
+	std::string container_file = av[1];
+	std::string output_folder = ac > 2 ? av[2] : "./container_vtu";
+	VtuEncoding encoding = ac > 3 && std::string(av[3]) == "base64" ? VtuEncoding::base64 : VtuEncoding::raw;
+	bool compressed = ac > 4 && std::string(av[4]) == "compressed";
+
+	ParticleContainerReader container_reader(container_file);
+	if (!fs::exists(output_folder)) fs::create_directory(output_folder);
+	container_reader.exportToVtu(output_folder, encoding, compressed);
+
+	cout << "Exported " << container_reader.records_.size() << " records of "
+		<< container_reader.getBodyNames().size() << " bodies at "
+		<< container_reader.getOutputTimes().size() << " output times into " << output_folder << ".\n";
+
+	return 0;
+}